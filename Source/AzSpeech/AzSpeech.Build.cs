@@ -30,6 +30,8 @@ public class AzSpeech : ModuleRules
 			"AndroidPermission",
 			"DeveloperSettings",
 			"AudioCaptureCore",
+			"AudioMixer",
+			"SignalProcessing",
 			"AssetRegistry",
 			"Projects",
 			"Json"
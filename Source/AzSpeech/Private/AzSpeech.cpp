@@ -5,17 +5,22 @@
 #include "AzSpeech.h"
 #include "AzSpeechInternalFuncs.h"
 #include "AzSpeech/AzSpeechHelper.h"
+#include "AzSpeech/Managers/AzSpeechConfigCache.h"
+#include "AzSpeech/Managers/AzSpeechAudioInputDeviceRegistry.h"
+#include "AzSpeech/Benchmark/AzSpeechMicrobenchmark.h"
 #include <Modules/ModuleManager.h>
 #include <Interfaces/IPluginManager.h>
 #include <Misc/Paths.h>
 #include <HAL/FileManager.h>
+#include <Misc/Parse.h>
+#include <Misc/CommandLine.h>
 
 #if ENGINE_MAJOR_VERSION < 5
 #include <GenericPlatform/GenericPlatformProcess.h>
 #define PLATFORM_LINUXARM64 PLATFORM_LINUXAARCH64
 #endif
 
-#define AZSPEECH_SUPPORTED_PLATFORM (PLATFORM_WINDOWS || PLATFORM_ANDROID || PLATFORM_HOLOLENS)
+#define AZSPEECH_SUPPORTED_PLATFORM (PLATFORM_WINDOWS || PLATFORM_ANDROID || PLATFORM_HOLOLENS || PLATFORM_LINUX || PLATFORM_LINUXARM64)
 
 #if WITH_EDITOR && !AZSPEECH_SUPPORTED_PLATFORM
 #include <Misc/MessageDialog.h>
@@ -150,6 +155,13 @@ void FAzSpeechModule::StartupModule()
 	LoadRuntimeLibraries();
 #endif
 
+#if !UE_BUILD_SHIPPING
+	if (FParse::Param(FCommandLine::Get(), FAzSpeechMicrobenchmark::AllocationCounterParam))
+	{
+		FAzSpeechMicrobenchmark::InstallAllocationCounter();
+	}
+#endif
+
 #if WITH_EDITOR && !AZSPEECH_SUPPORTED_PLATFORM
 	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString("Currently, AzSpeech does not officially support the platform you're using/targeting. If you encounter any issue and can/want to contribute, get in touch! :)\n\nRepository Link: github.com/lucoiso/UEAzSpeech"));
 #endif
@@ -160,6 +172,9 @@ void FAzSpeechModule::ShutdownModule()
 	const TSharedPtr<IPlugin> PluginInterface = IPluginManager::Get().FindPlugin("AzSpeech");
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Shutting down plugin %s version %s."), *PluginInterface->GetFriendlyName(), *PluginInterface->GetDescriptor().VersionName);
 
+	FAzSpeechConfigCache::Reset();
+	FAzSpeechAudioInputDeviceRegistry::Get().Deinitialize();
+
 #ifdef AZSPEECH_WHITELISTED_BINARIES
 	UnloadRuntimeLibraries();
 #endif
@@ -0,0 +1,156 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Animation/AnimNode_AzSpeechBlendShapes.h"
+#include "AzSpeech/Animation/AzSpeechVisemeTimeline.h"
+#include "AzSpeechTrace.h"
+#include <Animation/AnimInstanceProxy.h>
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3)
+#include <Animation/AnimCurveUtils.h>
+#endif
+
+#ifdef UE_INLINE_GENERATED_CPP_BY_NAME
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AnimNode_AzSpeechBlendShapes)
+#endif
+
+FAnimNode_AzSpeechBlendShapes::FAnimNode_AzSpeechBlendShapes() : CurveNames(GetDefaultCurveNames())
+{
+}
+
+const TArray<FName>& FAnimNode_AzSpeechBlendShapes::GetDefaultCurveNames()
+{
+	static const TArray<FName> DefaultCurveNames {
+		TEXT("eyeBlinkLeft"), TEXT("eyeLookDownLeft"), TEXT("eyeLookInLeft"), TEXT("eyeLookOutLeft"), TEXT("eyeLookUpLeft"), TEXT("eyeSquintLeft"), TEXT("eyeWideLeft"),
+		TEXT("eyeBlinkRight"), TEXT("eyeLookDownRight"), TEXT("eyeLookInRight"), TEXT("eyeLookOutRight"), TEXT("eyeLookUpRight"), TEXT("eyeSquintRight"), TEXT("eyeWideRight"),
+		TEXT("jawForward"), TEXT("jawLeft"), TEXT("jawRight"), TEXT("jawOpen"),
+		TEXT("mouthClose"), TEXT("mouthFunnel"), TEXT("mouthPucker"), TEXT("mouthLeft"), TEXT("mouthRight"), TEXT("mouthSmileLeft"), TEXT("mouthSmileRight"),
+		TEXT("mouthFrownLeft"), TEXT("mouthFrownRight"), TEXT("mouthDimpleLeft"), TEXT("mouthDimpleRight"), TEXT("mouthStretchLeft"), TEXT("mouthStretchRight"),
+		TEXT("mouthRollLower"), TEXT("mouthRollUpper"), TEXT("mouthShrugLower"), TEXT("mouthShrugUpper"), TEXT("mouthPressLeft"), TEXT("mouthPressRight"),
+		TEXT("mouthLowerDownLeft"), TEXT("mouthLowerDownRight"), TEXT("mouthUpperUpLeft"), TEXT("mouthUpperUpRight"),
+		TEXT("browDownLeft"), TEXT("browDownRight"), TEXT("browInnerUp"), TEXT("browOuterUpLeft"), TEXT("browOuterUpRight"),
+		TEXT("cheekPuff"), TEXT("cheekSquintLeft"), TEXT("cheekSquintRight"), TEXT("noseSneerLeft"), TEXT("noseSneerRight"), TEXT("tongueOut"),
+		TEXT("headRoll"), TEXT("leftEyeRoll"), TEXT("rightEyeRoll")
+	};
+
+	return DefaultCurveNames;
+}
+
+void FAnimNode_AzSpeechBlendShapes::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	FAnimNode_Base::Initialize_AnyThread(Context);
+	Source.Initialize(Context);
+
+	SampledValues.Reset(CurveNames.Num());
+	bHasSample = false;
+}
+
+void FAnimNode_AzSpeechBlendShapes::CacheBones_AnyThread(const FAnimationCacheBonesContext& Context)
+{
+	FAnimNode_Base::CacheBones_AnyThread(Context);
+	Source.CacheBones(Context);
+
+#if ENGINE_MAJOR_VERSION < 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 3)
+	CurveUIDs.Reset(CurveNames.Num());
+
+	const USkeleton* const Skeleton = Context.AnimInstanceProxy->GetSkeleton();
+	for (const FName& CurveName : CurveNames)
+	{
+		CurveUIDs.Add(Skeleton && !CurveName.IsNone() ? Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, CurveName) : SmartName::MaxUID);
+	}
+#else
+	MappedChannels.Reset(CurveNames.Num());
+	for (int32 Channel = 0; Channel < CurveNames.Num(); ++Channel)
+	{
+		if (!CurveNames[Channel].IsNone())
+		{
+			MappedChannels.Add(Channel);
+		}
+	}
+#endif
+}
+
+void FAnimNode_AzSpeechBlendShapes::Update_AnyThread(const FAnimationUpdateContext& Context)
+{
+	GetEvaluateGraphExposedInputs().Execute(Context);
+	Source.Update(Context);
+}
+
+void FAnimNode_AzSpeechBlendShapes::Evaluate_AnyThread(FPoseContext& Output)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_AnimNode_Evaluate);
+	Source.Evaluate(Output);
+
+	if (!bHasSample || Alpha <= 0.f)
+	{
+		return;
+	}
+
+	const int32 NumChannels = FMath::Min(SampledValues.Num(), CurveNames.Num());
+
+#if ENGINE_MAJOR_VERSION < 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 3)
+	for (int32 Channel = 0; Channel < NumChannels && Channel < CurveUIDs.Num(); ++Channel)
+	{
+		if (CurveUIDs[Channel] != SmartName::MaxUID)
+		{
+			Output.Curve.Set(CurveUIDs[Channel], FMath::Lerp(Output.Curve.Get(CurveUIDs[Channel]), SampledValues[Channel], Alpha));
+		}
+	}
+#else
+	// Curves are identified by name since UE 5.3: Only the mapped channels are blended with the input pose
+	int32 NumMappedChannels = 0;
+	while (NumMappedChannels < MappedChannels.Num() && MappedChannels[NumMappedChannels] < NumChannels)
+	{
+		++NumMappedChannels;
+	}
+
+	FBlendedCurve BlendShapeCurve;
+	UE::Anim::FCurveUtils::BuildUnsorted(BlendShapeCurve, NumMappedChannels,
+		[this](const int32 Index)
+		{
+			return CurveNames[MappedChannels[Index]];
+		},
+		[this, &Output](const int32 Index)
+		{
+			const int32 Channel = MappedChannels[Index];
+			return FMath::Lerp(Output.Curve.Get(CurveNames[Channel]), SampledValues[Channel], Alpha);
+		}
+	);
+
+	Output.Curve.Combine(BlendShapeCurve);
+#endif
+}
+
+void FAnimNode_AzSpeechBlendShapes::GatherDebugData(FNodeDebugData& DebugData)
+{
+	DebugData.AddDebugItem(FString::Printf(TEXT("%s (Alpha: %.2f, Channels: %d, Sampled: %s)"), *DebugData.GetNodeName(this), Alpha, SampledValues.Num(), bHasSample ? TEXT("true") : TEXT("false")));
+	Source.GatherDebugData(DebugData);
+}
+
+bool FAnimNode_AzSpeechBlendShapes::HasPreUpdate() const
+{
+	return true;
+}
+
+void FAnimNode_AzSpeechBlendShapes::PreUpdate([[maybe_unused]] const UAnimInstance* InAnimInstance)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_AnimNode_PreUpdate);
+
+	bHasSample = false;
+	if (!IsValid(Timeline))
+	{
+		return;
+	}
+
+	// The timeline copies the data received by the task, which is only safe in the game thread: The task is only locked when new visemes were received
+	Timeline->UpdateFromTask();
+
+	const FAzSpeechVisemeTimeline& TimelineData = Timeline->GetTimeline();
+	if (SampledValues.Num() != TimelineData.GetNumChannels())
+	{
+		SampledValues.SetNumZeroed(TimelineData.GetNumChannels());
+	}
+
+	bHasSample = TimelineData.SampleBlendShapes(Timeline->GetPlaybackTime() + TimeOffset, SampledValues);
+}
@@ -0,0 +1,444 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Animation/AzSpeechAnimationParser.h"
+#include "AzSpeech/Animation/AzSpeechBlendShapeMatrix.h"
+
+namespace AzSpeech::Internal
+{
+	// Powers of 10 exactly representable as double: Dividing an exact mantissa by them gives a correctly rounded result
+	constexpr double ExactPowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	constexpr int32 MaxExactPowerOf10 = UE_ARRAY_COUNT(ExactPowersOf10) - 1;
+	constexpr int32 MaxExactDigits = 15;
+	constexpr int32 MaxNumberLength = 64;
+
+	inline bool IsDigit(const TCHAR Character)
+	{
+		return static_cast<uint32>(Character - TEXT('0')) < 10u;
+	}
+
+	class FAnimationReader
+	{
+	public:
+		FAnimationReader(const TCHAR* const InBegin, const TCHAR* const InEnd) : Cursor(InBegin), End(InEnd)
+		{
+		}
+
+		bool Consume(const TCHAR Expected)
+		{
+			SkipWhitespace();
+			if (Cursor < End && *Cursor == Expected)
+			{
+				++Cursor;
+				return true;
+			}
+
+			return false;
+		}
+
+		bool ReadKey(const TCHAR*& OutKey, int32& OutLength)
+		{
+			if (!Consume(TEXT('"')))
+			{
+				return false;
+			}
+
+			OutKey = Cursor;
+			if (!SkipStringContent())
+			{
+				return false;
+			}
+
+			OutLength = static_cast<int32>(Cursor - OutKey) - 1;
+			return Consume(TEXT(':'));
+		}
+
+		bool ReadNumber(double& OutValue)
+		{
+			SkipWhitespace();
+			return FAzSpeechAnimationParser::ParseNumber(Cursor, End, OutValue);
+		}
+
+		template<typename SinkTy>
+		bool ReadBlendShapes(SinkTy& Sink)
+		{
+			if (!Consume(TEXT('[')))
+			{
+				return false;
+			}
+
+			if (Consume(TEXT(']')))
+			{
+				return true;
+			}
+
+			do
+			{
+				if (!Consume(TEXT('[')))
+				{
+					return false;
+				}
+
+				Sink.BeginFrame();
+
+				if (!Consume(TEXT(']')))
+				{
+					do
+					{
+						double Value = 0.;
+						if (!ReadNumber(Value))
+						{
+							return false;
+						}
+
+						Sink.AddValue(static_cast<float>(Value));
+					} while (Consume(TEXT(',')));
+
+					if (!Consume(TEXT(']')))
+					{
+						return false;
+					}
+				}
+
+				if (!Sink.EndFrame())
+				{
+					return false;
+				}
+			} while (Consume(TEXT(',')));
+
+			return Consume(TEXT(']'));
+		}
+
+		/* Skip the value of an unknown key, including nested arrays and objects */
+		bool SkipValue()
+		{
+			SkipWhitespace();
+
+			int32 Depth = 0;
+			while (Cursor < End)
+			{
+				const TCHAR Character = *Cursor;
+				if (Character == TEXT('"'))
+				{
+					++Cursor;
+					if (!SkipStringContent())
+					{
+						return false;
+					}
+
+					continue;
+				}
+
+				if (Character == TEXT('[') || Character == TEXT('{'))
+				{
+					++Depth;
+				}
+				else if (Character == TEXT(']') || Character == TEXT('}'))
+				{
+					if (Depth == 0)
+					{
+						return true;
+					}
+
+					--Depth;
+				}
+				else if (Character == TEXT(',') && Depth == 0)
+				{
+					return true;
+				}
+
+				++Cursor;
+			}
+
+			return Depth == 0;
+		}
+
+	private:
+		void SkipWhitespace()
+		{
+			while (Cursor < End && (*Cursor == TEXT(' ') || *Cursor == TEXT('\n') || *Cursor == TEXT('\r') || *Cursor == TEXT('\t')))
+			{
+				++Cursor;
+			}
+		}
+
+		/* Move the cursor after the closing quote of the current string */
+		bool SkipStringContent()
+		{
+			while (Cursor < End && *Cursor != TEXT('"'))
+			{
+				Cursor += *Cursor == TEXT('\\') ? 2 : 1;
+			}
+
+			if (Cursor >= End)
+			{
+				return false;
+			}
+
+			++Cursor;
+			return true;
+		}
+
+		const TCHAR* Cursor;
+		const TCHAR* const End;
+	};
+
+	/* Writes each frame to its own array, reserved from the width of the previous frame */
+	class FAnimationDataSink
+	{
+	public:
+		explicit FAnimationDataSink(TArray<FAzSpeechBlendShapes>& InBlendShapes) : BlendShapes(InBlendShapes)
+		{
+		}
+
+		void BeginFrame()
+		{
+			CurrentFrame = &BlendShapes.AddDefaulted_GetRef().Data;
+			CurrentFrame->Reserve(FrameWidth);
+		}
+
+		void AddValue(const float Value)
+		{
+			CurrentFrame->Add(Value);
+		}
+
+		bool EndFrame()
+		{
+			FrameWidth = CurrentFrame->Num();
+			return true;
+		}
+
+	private:
+		TArray<FAzSpeechBlendShapes>& BlendShapes;
+		TArray<float>* CurrentFrame = nullptr;
+		int32 FrameWidth = 0;
+	};
+
+	/* Appends the frames to the contiguous buffer of the matrix */
+	class FBlendShapeMatrixSink
+	{
+	public:
+		explicit FBlendShapeMatrixSink(FAzSpeechBlendShapeMatrix& InMatrix) : Matrix(InMatrix)
+		{
+		}
+
+		void BeginFrame()
+		{
+		}
+
+		void AddValue(const float Value)
+		{
+			Matrix.AddValue(Value);
+		}
+
+		bool EndFrame()
+		{
+			return Matrix.EndFrame();
+		}
+
+	private:
+		FAzSpeechBlendShapeMatrix& Matrix;
+	};
+
+	inline bool IsKey(const TCHAR* const Key, const int32 Length, const TCHAR* const Expected, const int32 ExpectedLength)
+	{
+		return Length == ExpectedLength && FCString::Strncmp(Key, Expected, Length) == 0;
+	}
+
+	template<typename SinkTy>
+	bool ParseAnimation(const TCHAR* const Data, const int32 Length, int32& OutFrameIndex, SinkTy& Sink)
+	{
+		OutFrameIndex = 0;
+
+		if (!Data || Length <= 0)
+		{
+			return false;
+		}
+
+		FAnimationReader Reader(Data, Data + Length);
+		if (!Reader.Consume(TEXT('{')))
+		{
+			return false;
+		}
+
+		if (Reader.Consume(TEXT('}')))
+		{
+			return true;
+		}
+
+		do
+		{
+			const TCHAR* Key = nullptr;
+			int32 KeyLength = 0;
+			if (!Reader.ReadKey(Key, KeyLength))
+			{
+				return false;
+			}
+
+			if (IsKey(Key, KeyLength, TEXT("FrameIndex"), 10))
+			{
+				double FrameIndex = 0.;
+				if (!Reader.ReadNumber(FrameIndex))
+				{
+					return false;
+				}
+
+				OutFrameIndex = static_cast<int32>(FrameIndex);
+			}
+			else if (IsKey(Key, KeyLength, TEXT("BlendShapes"), 11))
+			{
+				if (!Reader.ReadBlendShapes(Sink))
+				{
+					return false;
+				}
+			}
+			else if (!Reader.SkipValue())
+			{
+				return false;
+			}
+		} while (Reader.Consume(TEXT(',')));
+
+		return Reader.Consume(TEXT('}'));
+	}
+}
+
+const bool FAzSpeechAnimationParser::Parse(const TCHAR* Data, const int32 Length, FAzSpeechAnimationData& OutAnimationData)
+{
+	OutAnimationData.BlendShapes.Reset();
+
+	// Only the blend shapes contain arrays: Counting the brackets gives the number of frames without parsing the data twice
+	int32 EstimatedFrames = -1;
+	for (int32 Iterator = 0; Data && Iterator < Length; ++Iterator)
+	{
+		EstimatedFrames += Data[Iterator] == TEXT('[');
+	}
+
+	OutAnimationData.BlendShapes.Reserve(FMath::Max(0, EstimatedFrames));
+
+	AzSpeech::Internal::FAnimationDataSink Sink(OutAnimationData.BlendShapes);
+	return AzSpeech::Internal::ParseAnimation(Data, Length, OutAnimationData.FrameIndex, Sink);
+}
+
+const bool FAzSpeechAnimationParser::Parse(const TCHAR* Data, const int32 Length, FAzSpeechBlendShapeMatrix& OutMatrix, int32& OutSegmentIndex)
+{
+	OutSegmentIndex = INDEX_NONE;
+	OutMatrix.BeginSegment();
+
+	int32 FrameIndex = 0;
+	AzSpeech::Internal::FBlendShapeMatrixSink Sink(OutMatrix);
+	if (!AzSpeech::Internal::ParseAnimation(Data, Length, FrameIndex, Sink))
+	{
+		OutMatrix.CancelSegment();
+		return false;
+	}
+
+	OutSegmentIndex = OutMatrix.EndSegment(FrameIndex);
+	return true;
+}
+
+const bool FAzSpeechAnimationParser::Parse(const FString& Data, FAzSpeechBlendShapeMatrix& OutMatrix, int32& OutSegmentIndex)
+{
+	return Parse(*Data, Data.Len(), OutMatrix, OutSegmentIndex);
+}
+
+const bool FAzSpeechAnimationParser::Parse(const FString& Data, FAzSpeechAnimationData& OutAnimationData)
+{
+	return Parse(*Data, Data.Len(), OutAnimationData);
+}
+
+const bool FAzSpeechAnimationParser::ParseNumber(const TCHAR*& Cursor, const TCHAR* const End, double& OutValue)
+{
+	const TCHAR* Iterator = Cursor;
+
+	const bool bIsNegative = Iterator < End && *Iterator == TEXT('-');
+	if (bIsNegative)
+	{
+		++Iterator;
+	}
+
+	uint64 Mantissa = 0u;
+	int32 SignificantDigits = 0;
+	int32 Scale = 0;
+	bool bHasDigits = false;
+
+	while (Iterator < End && AzSpeech::Internal::IsDigit(*Iterator))
+	{
+		Mantissa = Mantissa * 10u + static_cast<uint64>(*Iterator - TEXT('0'));
+		SignificantDigits += Mantissa != 0u;
+		bHasDigits = true;
+		++Iterator;
+	}
+
+	if (Iterator < End && *Iterator == TEXT('.'))
+	{
+		++Iterator;
+		while (Iterator < End && AzSpeech::Internal::IsDigit(*Iterator))
+		{
+			Mantissa = Mantissa * 10u + static_cast<uint64>(*Iterator - TEXT('0'));
+			SignificantDigits += Mantissa != 0u;
+			bHasDigits = true;
+			--Scale;
+			++Iterator;
+		}
+	}
+
+	if (!bHasDigits)
+	{
+		return false;
+	}
+
+	if (Iterator < End && (*Iterator == TEXT('e') || *Iterator == TEXT('E')))
+	{
+		++Iterator;
+
+		const bool bIsNegativeExponent = Iterator < End && *Iterator == TEXT('-');
+		if (Iterator < End && (*Iterator == TEXT('-') || *Iterator == TEXT('+')))
+		{
+			++Iterator;
+		}
+
+		int32 Exponent = 0;
+		bool bHasExponentDigits = false;
+		while (Iterator < End && AzSpeech::Internal::IsDigit(*Iterator))
+		{
+			Exponent = FMath::Min(Exponent * 10 + static_cast<int32>(*Iterator - TEXT('0')), 1000);
+			bHasExponentDigits = true;
+			++Iterator;
+		}
+
+		if (!bHasExponentDigits)
+		{
+			return false;
+		}
+
+		Scale += bIsNegativeExponent ? -Exponent : Exponent;
+	}
+
+	if (SignificantDigits <= AzSpeech::Internal::MaxExactDigits && FMath::Abs(Scale) <= AzSpeech::Internal::MaxExactPowerOf10)
+	{
+		const double Value = static_cast<double>(Mantissa);
+		OutValue = Scale < 0 ? Value / AzSpeech::Internal::ExactPowersOf10[-Scale] : Value * AzSpeech::Internal::ExactPowersOf10[Scale];
+	}
+	else
+	{
+		// Rare with the animation data: Fall back to the CRT using a null terminated copy in the stack
+		const int32 NumberLength = static_cast<int32>(Iterator - Cursor);
+		if (NumberLength >= AzSpeech::Internal::MaxNumberLength)
+		{
+			return false;
+		}
+
+		TCHAR Buffer[AzSpeech::Internal::MaxNumberLength];
+		FMemory::Memcpy(Buffer, Cursor, NumberLength * sizeof(TCHAR));
+		Buffer[NumberLength] = TEXT('\0');
+
+		Cursor = Iterator;
+		OutValue = FCString::Atod(Buffer);
+		return true;
+	}
+
+	Cursor = Iterator;
+	OutValue = bIsNegative ? -OutValue : OutValue;
+	return true;
+}
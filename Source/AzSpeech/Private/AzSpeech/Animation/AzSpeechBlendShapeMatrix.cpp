@@ -0,0 +1,226 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Animation/AzSpeechBlendShapeMatrix.h"
+#include <Runtime/Launch/Resources/Version.h>
+
+#if ENGINE_MAJOR_VERSION >= 5
+typedef VectorRegister4Float FAzSpeechVectorRegister;
+#else
+typedef VectorRegister FAzSpeechVectorRegister;
+#endif
+
+void FAzSpeechBlendShapeMatrix::BeginSegment()
+{
+	PendingFirstValue = Values.Num();
+	PendingFrameValue = Values.Num();
+}
+
+void FAzSpeechBlendShapeMatrix::AddValue(const float Value)
+{
+	Values.Add(Value);
+}
+
+const bool FAzSpeechBlendShapeMatrix::EndFrame()
+{
+	const int32 FrameWidth = Values.Num() - PendingFrameValue;
+	if (NumChannels == 0 && FrameWidth > 0)
+	{
+		NumChannels = FrameWidth;
+	}
+
+	if (FrameWidth != NumChannels)
+	{
+		return false;
+	}
+
+	PendingFrameValue = Values.Num();
+	return true;
+}
+
+const int32 FAzSpeechBlendShapeMatrix::EndSegment(const int32 FrameIndex)
+{
+	// Partial frames are discarded
+	Values.SetNum(PendingFrameValue, false);
+
+	FSegment& NewSegment = Segments.AddDefaulted_GetRef();
+	NewSegment.FrameIndex = FrameIndex;
+	NewSegment.FirstRow = NumChannels > 0 ? PendingFirstValue / NumChannels : 0;
+	NewSegment.NumRows = NumChannels > 0 ? (PendingFrameValue - PendingFirstValue) / NumChannels : 0;
+
+	PendingFirstValue = Values.Num();
+	return Segments.Num() - 1;
+}
+
+void FAzSpeechBlendShapeMatrix::CancelSegment()
+{
+	Values.SetNum(PendingFirstValue, false);
+	PendingFrameValue = PendingFirstValue;
+
+	if (Values.Num() == 0)
+	{
+		NumChannels = 0;
+	}
+}
+
+const int32 FAzSpeechBlendShapeMatrix::AppendSegment(const int32 FrameIndex, const int32 InNumChannels, const TArrayView<const float> InValues)
+{
+	if (InNumChannels <= 0 || InValues.Num() % InNumChannels != 0 || (NumChannels > 0 && NumChannels != InNumChannels))
+	{
+		return INDEX_NONE;
+	}
+
+	NumChannels = InNumChannels;
+
+	BeginSegment();
+	Values.Append(InValues.GetData(), InValues.Num());
+	PendingFrameValue = Values.Num();
+
+	return EndSegment(FrameIndex);
+}
+
+void FAzSpeechBlendShapeMatrix::Reset()
+{
+	Values.Reset();
+	Segments.Reset();
+	NumChannels = 0;
+	PendingFirstValue = 0;
+	PendingFrameValue = 0;
+}
+
+const int32 FAzSpeechBlendShapeMatrix::GetNumChannels() const
+{
+	return NumChannels;
+}
+
+const int32 FAzSpeechBlendShapeMatrix::GetNumRows() const
+{
+	return NumChannels > 0 ? PendingFirstValue / NumChannels : 0;
+}
+
+const TArray<FAzSpeechBlendShapeMatrix::FSegment>& FAzSpeechBlendShapeMatrix::GetSegments() const
+{
+	return Segments;
+}
+
+const TArrayView<const float> FAzSpeechBlendShapeMatrix::GetRow(const int32 Row) const
+{
+	if (Row < 0 || Row >= GetNumRows())
+	{
+		return TArrayView<const float>();
+	}
+
+	return TArrayView<const float>(Values.GetData() + Row * NumChannels, NumChannels);
+}
+
+const TArrayView<const float> FAzSpeechBlendShapeMatrix::GetSegmentValues(const int32 SegmentIndex) const
+{
+	if (!Segments.IsValidIndex(SegmentIndex))
+	{
+		return TArrayView<const float>();
+	}
+
+	const FSegment& Segment = Segments[SegmentIndex];
+	return TArrayView<const float>(Values.GetData() + Segment.FirstRow * NumChannels, Segment.NumRows * NumChannels);
+}
+
+const int32 FAzSpeechBlendShapeMatrix::FindRow(const int32 FrameIndex) const
+{
+	// The segments are received in order: Find the last segment starting before the frame
+	int32 Low = 0;
+	int32 High = Segments.Num();
+	while (Low < High)
+	{
+		const int32 Middle = Low + (High - Low) / 2;
+		if (Segments[Middle].FrameIndex <= FrameIndex)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	if (Low == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const FSegment& Segment = Segments[Low - 1];
+	const int32 Offset = FrameIndex - Segment.FrameIndex;
+
+	return Offset < Segment.NumRows ? Segment.FirstRow + Offset : INDEX_NONE;
+}
+
+const bool FAzSpeechBlendShapeMatrix::Sample(const float TimeInSeconds, const TArrayView<float> OutValues) const
+{
+	const float FramePosition = FMath::Max(0.f, TimeInSeconds) * FrameRate;
+	const int32 FrameIndex = FMath::FloorToInt(FramePosition);
+
+	const int32 Row = FindRow(FrameIndex);
+	if (Row == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const int32 NumValues = FMath::Min(OutValues.Num(), NumChannels);
+	const float* const Current = Values.GetData() + Row * NumChannels;
+
+	// Holds the last received frame until the next one arrives
+	const int32 NextRow = FindRow(FrameIndex + 1);
+	if (NextRow == INDEX_NONE)
+	{
+		FMemory::Memcpy(OutValues.GetData(), Current, NumValues * sizeof(float));
+		return true;
+	}
+
+	Blend(Current, Values.GetData() + NextRow * NumChannels, FramePosition - FrameIndex, OutValues.GetData(), NumValues);
+
+	return true;
+}
+
+const FAzSpeechAnimationData FAzSpeechBlendShapeMatrix::GetSegmentAnimationData(const int32 SegmentIndex) const
+{
+	FAzSpeechAnimationData Output;
+	if (!Segments.IsValidIndex(SegmentIndex))
+	{
+		return Output;
+	}
+
+	const FSegment& Segment = Segments[SegmentIndex];
+	Output.FrameIndex = Segment.FrameIndex;
+	Output.BlendShapes.Reserve(Segment.NumRows);
+
+	for (int32 Row = Segment.FirstRow; Row < Segment.FirstRow + Segment.NumRows; ++Row)
+	{
+		const TArrayView<const float> RowValues = GetRow(Row);
+		Output.BlendShapes.AddDefaulted_GetRef().Data.Append(RowValues.GetData(), RowValues.Num());
+	}
+
+	return Output;
+}
+
+const SIZE_T FAzSpeechBlendShapeMatrix::GetAllocatedSize() const
+{
+	return Values.GetAllocatedSize() + Segments.GetAllocatedSize();
+}
+
+void FAzSpeechBlendShapeMatrix::Blend(const float* A, const float* B, const float Alpha, float* OutValues, const int32 NumValues)
+{
+	const FAzSpeechVectorRegister AlphaRegister = VectorSetFloat1(Alpha);
+
+	int32 Iterator = 0;
+	for (; Iterator + 4 <= NumValues; Iterator += 4)
+	{
+		const FAzSpeechVectorRegister From = VectorLoad(A + Iterator);
+		const FAzSpeechVectorRegister To = VectorLoad(B + Iterator);
+		VectorStore(VectorMultiplyAdd(VectorSubtract(To, From), AlphaRegister, From), OutValues + Iterator);
+	}
+
+	for (; Iterator < NumValues; ++Iterator)
+	{
+		OutValues[Iterator] = FMath::Lerp(A[Iterator], B[Iterator], Alpha);
+	}
+}
@@ -0,0 +1,298 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Animation/AzSpeechVisemeTimeline.h"
+#include "AzSpeech/Tasks/Bases/AzSpeechSynthesizerTaskBase.h"
+#include "AzSpeech/Container/AzSpeechLineFile.h"
+#include "LogAzSpeech.h"
+#include <Components/AudioComponent.h>
+#include <Sound/SoundWave.h>
+#include <Algo/BinarySearch.h>
+
+#ifdef UE_INLINE_GENERATED_CPP_BY_NAME
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AzSpeechVisemeTimeline)
+#endif
+
+namespace AzSpeech::Internal
+{
+	// The playback percent is sent once per audio update: Limits the extrapolation if the updates stop without stopping the component
+	constexpr double MaxPlaybackExtrapolationSeconds = 0.25;
+}
+
+void FAzSpeechVisemeTimeline::Append(const TArrayView<const FAzSpeechVisemeData> NewVisemes, const FAzSpeechBlendShapeMatrix& BlendShapeSource)
+{
+	for (const FAzSpeechVisemeData& Iterator : NewVisemes)
+	{
+		// The visemes are received in order: Inserting in the middle only happens with unordered events
+		const int32 Index = VisemeOffsetsMs.Num() == 0 || VisemeOffsetsMs.Last() <= Iterator.AudioOffsetMilliseconds ? VisemeOffsetsMs.Num() : Algo::UpperBound(VisemeOffsetsMs, Iterator.AudioOffsetMilliseconds);
+
+		VisemeOffsetsMs.Insert(Iterator.AudioOffsetMilliseconds, Index);
+		VisemeIDs.Insert(Iterator.VisemeID, Index);
+	}
+
+	const TArray<FAzSpeechBlendShapeMatrix::FSegment>& Segments = BlendShapeSource.GetSegments();
+	for (; SyncedSegments < Segments.Num(); ++SyncedSegments)
+	{
+		if (Segments[SyncedSegments].NumRows > 0)
+		{
+			BlendShapes.AppendSegment(Segments[SyncedSegments].FrameIndex, BlendShapeSource.GetNumChannels(), BlendShapeSource.GetSegmentValues(SyncedSegments));
+		}
+	}
+}
+
+void FAzSpeechVisemeTimeline::Load(const TArrayView<const int64> InVisemeOffsetsMs, const TArrayView<const int32> InVisemeIDs, const int32 NumChannels, const TArrayView<const FAzSpeechBlendShapeMatrix::FSegment> InSegments, const TArrayView<const float> InValues)
+{
+	Reset();
+
+	const int32 NumVisemes = FMath::Min(InVisemeOffsetsMs.Num(), InVisemeIDs.Num());
+	VisemeOffsetsMs.Append(InVisemeOffsetsMs.GetData(), NumVisemes);
+	VisemeIDs.Append(InVisemeIDs.GetData(), NumVisemes);
+
+	if (NumChannels <= 0)
+	{
+		return;
+	}
+
+	for (const FAzSpeechBlendShapeMatrix::FSegment& Iterator : InSegments)
+	{
+		const int64 FirstValue = static_cast<int64>(Iterator.FirstRow) * NumChannels;
+		const int64 NumValues = static_cast<int64>(Iterator.NumRows) * NumChannels;
+
+		if (Iterator.NumRows > 0 && FirstValue >= 0 && FirstValue + NumValues <= InValues.Num())
+		{
+			BlendShapes.AppendSegment(Iterator.FrameIndex, NumChannels, InValues.Slice(static_cast<int32>(FirstValue), static_cast<int32>(NumValues)));
+		}
+	}
+}
+
+void FAzSpeechVisemeTimeline::Reset()
+{
+	VisemeOffsetsMs.Reset();
+	VisemeIDs.Reset();
+	BlendShapes.Reset();
+	SyncedSegments = 0;
+	SourceTaskID = 0u;
+}
+
+void FAzSpeechVisemeTimeline::SetSourceTaskID(const uint32 InTaskID)
+{
+	SourceTaskID = InTaskID;
+}
+
+const uint32 FAzSpeechVisemeTimeline::GetSourceTaskID() const
+{
+	return SourceTaskID;
+}
+
+const int32 FAzSpeechVisemeTimeline::GetNumVisemes() const
+{
+	return VisemeIDs.Num();
+}
+
+const int32 FAzSpeechVisemeTimeline::GetNumChannels() const
+{
+	return BlendShapes.GetNumChannels();
+}
+
+const float FAzSpeechVisemeTimeline::GetDuration() const
+{
+	float Output = VisemeOffsetsMs.Num() == 0 ? 0.f : VisemeOffsetsMs.Last() / 1000.f;
+
+	if (const TArray<FAzSpeechBlendShapeMatrix::FSegment>& Segments = BlendShapes.GetSegments(); Segments.Num() > 0)
+	{
+		Output = FMath::Max(Output, static_cast<float>(Segments.Last().FrameIndex + Segments.Last().NumRows) / FAzSpeechBlendShapeMatrix::FrameRate);
+	}
+
+	return Output;
+}
+
+const bool FAzSpeechVisemeTimeline::SampleViseme(const float TimeInSeconds, int32& OutVisemeID, int32& OutNextVisemeID, float& OutAlpha) const
+{
+	const int64 TimeInMs = static_cast<int64>(TimeInSeconds * 1000.f);
+
+	const int32 NextIndex = Algo::UpperBound(VisemeOffsetsMs, TimeInMs);
+	if (NextIndex == 0)
+	{
+		OutVisemeID = INDEX_NONE;
+		OutNextVisemeID = VisemeIDs.Num() == 0 ? INDEX_NONE : VisemeIDs[0];
+		OutAlpha = 0.f;
+
+		return false;
+	}
+
+	const int32 CurrentIndex = NextIndex - 1;
+	OutVisemeID = VisemeIDs[CurrentIndex];
+
+	if (!VisemeIDs.IsValidIndex(NextIndex))
+	{
+		OutNextVisemeID = OutVisemeID;
+		OutAlpha = 0.f;
+
+		return true;
+	}
+
+	OutNextVisemeID = VisemeIDs[NextIndex];
+
+	const float Length = static_cast<float>(VisemeOffsetsMs[NextIndex] - VisemeOffsetsMs[CurrentIndex]);
+	OutAlpha = Length > 0.f ? FMath::Clamp((TimeInSeconds * 1000.f - VisemeOffsetsMs[CurrentIndex]) / Length, 0.f, 1.f) : 0.f;
+
+	return true;
+}
+
+const bool FAzSpeechVisemeTimeline::SampleBlendShapes(const float TimeInSeconds, const TArrayView<float> OutValues) const
+{
+	return BlendShapes.Sample(TimeInSeconds, OutValues);
+}
+
+const TArray<int64>& FAzSpeechVisemeTimeline::GetVisemeOffsets() const
+{
+	return VisemeOffsetsMs;
+}
+
+const TArray<int32>& FAzSpeechVisemeTimeline::GetVisemeIDs() const
+{
+	return VisemeIDs;
+}
+
+const FAzSpeechBlendShapeMatrix& FAzSpeechVisemeTimeline::GetBlendShapes() const
+{
+	return BlendShapes;
+}
+
+UAzSpeechVisemeTimeline* UAzSpeechVisemeTimeline::CreateVisemeTimeline(UAzSpeechSynthesizerTaskBase* Task)
+{
+	if (!IsValid(Task))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Invalid task"), *FString(__func__));
+		return nullptr;
+	}
+
+	UAzSpeechVisemeTimeline* const NewTimeline = NewObject<UAzSpeechVisemeTimeline>();
+	NewTimeline->Task = Task;
+	NewTimeline->UpdateFromTask();
+
+	return NewTimeline;
+}
+
+UAzSpeechVisemeTimeline* UAzSpeechVisemeTimeline::CreateVisemeTimelineFromLineFile(const FAzSpeechLineFile& LineFile)
+{
+	if (!LineFile.IsOpen())
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Line file is not open"), *FString(__func__));
+		return nullptr;
+	}
+
+	UAzSpeechVisemeTimeline* const NewTimeline = NewObject<UAzSpeechVisemeTimeline>();
+	NewTimeline->Timeline.Load(LineFile.GetVisemeOffsets(), LineFile.GetVisemeIDs(), LineFile.GetNumBlendShapeChannels(), LineFile.GetBlendShapeSegments(), LineFile.GetBlendShapeValues());
+
+	return NewTimeline;
+}
+
+void UAzSpeechVisemeTimeline::BindAudioComponent(UAudioComponent* AudioComponent)
+{
+	UnbindAudioComponent();
+
+	if (!IsValid(AudioComponent))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Invalid audio component"), *FString(__func__));
+		return;
+	}
+
+	BoundAudioComponent = AudioComponent;
+	PlaybackPercentHandle = AudioComponent->OnAudioPlaybackPercentNative.AddUObject(this, &UAzSpeechVisemeTimeline::OnAudioPlaybackPercent);
+
+	LastPlaybackTime = 0.f;
+	LastPlaybackUpdateSeconds = 0.;
+}
+
+void UAzSpeechVisemeTimeline::UnbindAudioComponent()
+{
+	if (UAudioComponent* const AudioComponent = BoundAudioComponent.Get())
+	{
+		AudioComponent->OnAudioPlaybackPercentNative.Remove(PlaybackPercentHandle);
+	}
+
+	BoundAudioComponent.Reset();
+	PlaybackPercentHandle.Reset();
+}
+
+const float UAzSpeechVisemeTimeline::GetPlaybackTime() const
+{
+	const UAudioComponent* const AudioComponent = BoundAudioComponent.Get();
+	if (!AudioComponent || LastPlaybackUpdateSeconds <= 0. || AudioComponent->GetPlayState() != EAudioComponentPlayState::Playing)
+	{
+		return LastPlaybackTime;
+	}
+
+	// Extrapolates between the audio updates to sample a new frame on every game frame
+	const double ElapsedSeconds = FMath::Min(FPlatformTime::Seconds() - LastPlaybackUpdateSeconds, AzSpeech::Internal::MaxPlaybackExtrapolationSeconds);
+
+	return LastPlaybackTime + static_cast<float>(ElapsedSeconds);
+}
+
+const float UAzSpeechVisemeTimeline::GetDuration() const
+{
+	return Timeline.GetDuration();
+}
+
+const int32 UAzSpeechVisemeTimeline::GetCurrentVisemeID(int32& NextVisemeID, float& Alpha)
+{
+	UpdateFromTask();
+
+	int32 Output = INDEX_NONE;
+	Timeline.SampleViseme(GetPlaybackTime(), Output, NextVisemeID, Alpha);
+
+	return Output;
+}
+
+const TArray<float> UAzSpeechVisemeTimeline::GetCurrentBlendShapes()
+{
+	return GetBlendShapesAtTime(GetPlaybackTime());
+}
+
+const TArray<float> UAzSpeechVisemeTimeline::GetBlendShapesAtTime(const float TimeInSeconds)
+{
+	UpdateFromTask();
+
+	TArray<float> Output;
+	Output.SetNumUninitialized(Timeline.GetNumChannels());
+
+	if (!Timeline.SampleBlendShapes(TimeInSeconds, Output))
+	{
+		Output.Empty();
+	}
+
+	return Output;
+}
+
+void UAzSpeechVisemeTimeline::UpdateFromTask()
+{
+	if (const UAzSpeechSynthesizerTaskBase* const SynthesisTask = Task.Get())
+	{
+		SynthesisTask->UpdateVisemeTimeline(Timeline);
+	}
+}
+
+const FAzSpeechVisemeTimeline& UAzSpeechVisemeTimeline::GetTimeline() const
+{
+	return Timeline;
+}
+
+void UAzSpeechVisemeTimeline::BeginDestroy()
+{
+	UnbindAudioComponent();
+
+	Super::BeginDestroy();
+}
+
+void UAzSpeechVisemeTimeline::OnAudioPlaybackPercent([[maybe_unused]] const UAudioComponent* AudioComponent, const USoundWave* SoundWave, const float Percent)
+{
+	if (!SoundWave)
+	{
+		return;
+	}
+
+	LastPlaybackTime = Percent * SoundWave->Duration;
+	LastPlaybackUpdateSeconds = FPlatformTime::Seconds();
+}
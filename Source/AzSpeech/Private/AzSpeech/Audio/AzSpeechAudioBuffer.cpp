@@ -0,0 +1,62 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Audio/AzSpeechAudioBuffer.h"
+
+FAzSpeechAudioBuffer::FAzSpeechAudioBuffer(std::shared_ptr<const std::vector<uint8_t>> InData) : Data(MoveTemp(InData))
+{
+}
+
+FAzSpeechAudioBuffer FAzSpeechAudioBuffer::Clone(const TArrayView<const uint8> InData)
+{
+	if (InData.Num() == 0)
+	{
+		return FAzSpeechAudioBuffer();
+	}
+
+	return FAzSpeechAudioBuffer(std::make_shared<const std::vector<uint8_t>>(InData.GetData(), InData.GetData() + InData.Num()));
+}
+
+const uint8* FAzSpeechAudioBuffer::GetData() const
+{
+	return Data ? reinterpret_cast<const uint8*>(Data->data()) : nullptr;
+}
+
+const int32 FAzSpeechAudioBuffer::Num() const
+{
+	return Data ? static_cast<int32>(Data->size()) : 0;
+}
+
+const bool FAzSpeechAudioBuffer::IsEmpty() const
+{
+	return Num() == 0;
+}
+
+const TArrayView<const uint8> FAzSpeechAudioBuffer::GetView() const
+{
+	return TArrayView<const uint8>(GetData(), Num());
+}
+
+const TArray<uint8> FAzSpeechAudioBuffer::ToArray() const
+{
+	return TArray<uint8>(GetData(), Num());
+}
+
+#if ENGINE_MAJOR_VERSION >= 5
+FSharedBuffer FAzSpeechAudioBuffer::ToSharedBuffer() const
+{
+	if (IsEmpty())
+	{
+		return FSharedBuffer();
+	}
+
+	// The deleter owns a reference to the data and releases it with the shared buffer
+	return FSharedBuffer::TakeOwnership(GetData(), static_cast<uint64>(Num()), [Owner = Data](void*) {});
+}
+#endif
+
+void FAzSpeechAudioBuffer::Reset()
+{
+	Data.reset();
+}
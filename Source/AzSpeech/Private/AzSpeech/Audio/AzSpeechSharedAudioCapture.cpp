@@ -0,0 +1,411 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Audio/AzSpeechSharedAudioCapture.h"
+#include "AzSpeech/Managers/AzSpeechAudioInputDeviceRegistry.h"
+#include "AzSpeechInternalFuncs.h"
+#include "LogAzSpeech.h"
+#include <AudioCaptureCore.h>
+#include <DSP/Dsp.h>
+#include <AudioResampler.h>
+#include <HAL/RunnableThread.h>
+
+THIRD_PARTY_INCLUDES_START
+#include <speechapi_cxx_audio_stream_format.h>
+THIRD_PARTY_INCLUDES_END
+
+struct FAzSpeechSharedAudioCapture::FCaptureRingBuffer
+{
+	explicit FCaptureRingBuffer(const uint32 InCapacity) : Buffer(InCapacity)
+	{
+	}
+
+	Audio::TCircularAudioBuffer<float> Buffer;
+};
+
+FCriticalSection FAzSpeechSharedAudioCapture::RegistryMutex;
+TMap<FString, TWeakPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe>> FAzSpeechSharedAudioCapture::ActiveCaptures;
+
+FAzSpeechAudioCaptureListener::FAzSpeechAudioCaptureListener() : bIsClosed(false)
+{
+	const auto StreamFormat = Microsoft::CognitiveServices::Speech::Audio::AudioStreamFormat::GetWaveFormatPCM(FAzSpeechSharedAudioCapture::OutputSampleRate, 16, 1);
+	PushStream = Microsoft::CognitiveServices::Speech::Audio::AudioInputStream::CreatePushStream(StreamFormat);
+}
+
+FAzSpeechAudioCaptureListener::~FAzSpeechAudioCaptureListener()
+{
+	Close();
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::PushAudioInputStream> FAzSpeechAudioCaptureListener::GetStream() const
+{
+	return PushStream;
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> FAzSpeechAudioCaptureListener::CreateAudioConfig() const
+{
+	return Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromStreamInput(PushStream);
+}
+
+void FAzSpeechAudioCaptureListener::Close()
+{
+	if (bIsClosed.exchange(true))
+	{
+		return;
+	}
+
+	if (PushStream)
+	{
+		PushStream->Close();
+	}
+}
+
+const uint64 FAzSpeechAudioCaptureListener::GetStartSample() const
+{
+	return StartSample;
+}
+
+void FAzSpeechAudioCaptureListener::ProcessAudio(const float* InSamples, const int32 NumSamples)
+{
+	WriteToStream(InSamples, NumSamples);
+}
+
+void FAzSpeechAudioCaptureListener::WriteToStream(const float* InSamples, const int32 NumSamples)
+{
+	if (bIsClosed || !PushStream || NumSamples <= 0)
+	{
+		return;
+	}
+
+	ConversionBuffer.SetNumUninitialized(NumSamples, false);
+	for (int32 Iterator = 0; Iterator < NumSamples; ++Iterator)
+	{
+		ConversionBuffer[Iterator] = static_cast<int16>(FMath::Clamp(InSamples[Iterator], -1.f, 1.f) * 32767.f);
+	}
+
+	PushStream->Write(reinterpret_cast<uint8_t*>(ConversionBuffer.GetData()), static_cast<uint32_t>(NumSamples * sizeof(int16)));
+}
+
+TSharedPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe> FAzSpeechSharedAudioCapture::FindOrCreate(const FString& DeviceID)
+{
+	const bool bIsDefaultDevice = AzSpeech::Internal::HasEmptyParam(DeviceID) || DeviceID.Equals("Default", ESearchCase::IgnoreCase);
+	const FString RegistryKey = bIsDefaultDevice ? FString("Default") : DeviceID;
+
+	FScopeLock Lock(&RegistryMutex);
+
+	if (const TWeakPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe>* const ExistingCapture = ActiveCaptures.Find(RegistryKey))
+	{
+		if (TSharedPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe> PinnedCapture = ExistingCapture->Pin(); PinnedCapture.IsValid())
+		{
+			UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Using active shared audio capture of device %s"), *FString(__func__), *RegistryKey);
+			return PinnedCapture;
+		}
+	}
+
+	int32 DeviceIndex = INDEX_NONE;
+	if (!bIsDefaultDevice)
+	{
+		DeviceIndex = FAzSpeechAudioInputDeviceRegistry::Get().FindDeviceIndex(DeviceID);
+		if (DeviceIndex == INDEX_NONE)
+		{
+			UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Audio input device %s isn't available"), *FString(__func__), *DeviceID);
+			return nullptr;
+		}
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Creating shared audio capture of device %s"), *FString(__func__), *RegistryKey);
+
+	TSharedPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe> NewCapture = MakeShared<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe>(RegistryKey, DeviceIndex);
+	if (!NewCapture->OpenCaptureStream())
+	{
+		return nullptr;
+	}
+
+	ActiveCaptures.Add(RegistryKey, NewCapture);
+
+	return NewCapture;
+}
+
+FAzSpeechSharedAudioCapture::FAzSpeechSharedAudioCapture(const FString& InDeviceID, const int32 InDeviceIndex) : DeviceID(InDeviceID), DeviceIndex(InDeviceIndex), CapturedSamples(0u), DroppedSamples(0u), bStopCapture(false), bIsCapturing(false)
+{
+	// One second of margin between the capture callback and the pump thread
+	CaptureBuffer = MakeUnique<FCaptureRingBuffer>(OutputSampleRate);
+
+	History.SetNumZeroed(OutputSampleRate * HistoryLengthMs / 1000);
+}
+
+FAzSpeechSharedAudioCapture::~FAzSpeechSharedAudioCapture()
+{
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Destroying shared audio capture of device %s"), *FString(__func__), *DeviceID);
+
+	CloseCaptureStream();
+
+	{
+		FScopeLock Lock(&ListenersMutex);
+		for (const FAzSpeechAudioCaptureListenerPtr& Listener : Listeners)
+		{
+			Listener->Close();
+		}
+
+		Listeners.Empty();
+	}
+
+	FScopeLock Lock(&RegistryMutex);
+	if (const TWeakPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe>* const ExistingCapture = ActiveCaptures.Find(DeviceID); ExistingCapture && !ExistingCapture->IsValid())
+	{
+		ActiveCaptures.Remove(DeviceID);
+	}
+}
+
+FAzSpeechAudioCaptureListenerPtr FAzSpeechSharedAudioCapture::AddListener(const int32 PreRollMs)
+{
+	FAzSpeechAudioCaptureListenerPtr NewListener = MakeShared<FAzSpeechAudioCaptureListener, ESPMode::ThreadSafe>();
+	AddListener(NewListener, PreRollMs * OutputSampleRate / 1000);
+
+	return NewListener;
+}
+
+void FAzSpeechSharedAudioCapture::AddListener(const FAzSpeechAudioCaptureListenerPtr& Listener, const int32 PreRollSamples)
+{
+	if (!Listener.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&ListenersMutex);
+	AddListener_Internal(Listener, PreRollSamples);
+}
+
+void FAzSpeechSharedAudioCapture::AddListenerFromSample(const FAzSpeechAudioCaptureListenerPtr& Listener, const uint64 InStartSample)
+{
+	if (!Listener.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&ListenersMutex);
+
+	// The captured samples only change under this lock: the listener starts exactly at the requested sample if it's still in the history
+	const uint64 CurrentSamples = CapturedSamples.load();
+	const int32 PreRollSamples = static_cast<int32>(FMath::Min<uint64>(CurrentSamples - FMath::Min(InStartSample, CurrentSamples), MAX_int32));
+
+	AddListener_Internal(Listener, PreRollSamples);
+}
+
+void FAzSpeechSharedAudioCapture::AddListener_Internal(const FAzSpeechAudioCaptureListenerPtr& Listener, const int32 PreRollSamples)
+{
+	// Write the requested pre-roll from the history before adding the listener, so the stream stays sample-aligned with the live data
+	const int32 UsedPreRollSamples = FMath::Clamp(PreRollSamples, 0, HistoryNum);
+	Listener->StartSample = CapturedSamples.load() - UsedPreRollSamples;
+
+	if (UsedPreRollSamples > 0)
+	{
+		const int32 ReadStart = (HistoryWriteIndex - UsedPreRollSamples + History.Num()) % History.Num();
+		const int32 FirstSegmentNum = FMath::Min(UsedPreRollSamples, History.Num() - ReadStart);
+
+		Listener->ProcessAudio(History.GetData() + ReadStart, FirstSegmentNum);
+		if (FirstSegmentNum < UsedPreRollSamples)
+		{
+			Listener->ProcessAudio(History.GetData(), UsedPreRollSamples - FirstSegmentNum);
+		}
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Adding listener to shared audio capture of device %s with %d samples of pre-roll"), *FString(__func__), *DeviceID, UsedPreRollSamples);
+	Listeners.Add(Listener);
+}
+
+void FAzSpeechSharedAudioCapture::RemoveListener(const FAzSpeechAudioCaptureListenerPtr& Listener)
+{
+	if (!Listener.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&ListenersMutex);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Removing listener from shared audio capture of device %s"), *FString(__func__), *DeviceID);
+	Listeners.Remove(Listener);
+	Listener->Close();
+}
+
+const uint64 FAzSpeechSharedAudioCapture::GetCapturedSamples() const
+{
+	return CapturedSamples.load();
+}
+
+const bool FAzSpeechSharedAudioCapture::IsCapturing() const
+{
+	return bIsCapturing.load();
+}
+
+const FString FAzSpeechSharedAudioCapture::GetDeviceID() const
+{
+	return DeviceID;
+}
+
+uint32 FAzSpeechSharedAudioCapture::Run()
+{
+	// 10 ms chunks at the output sample rate
+	constexpr int32 ChunkSize = OutputSampleRate / 100;
+	TArray<float> Chunk;
+	Chunk.SetNumUninitialized(ChunkSize);
+
+	while (!bStopCapture)
+	{
+		if (const uint32 NumDroppedSamples = DroppedSamples.exchange(0u); NumDroppedSamples > 0u)
+		{
+			UE_LOG(LogAzSpeech_Internal, Warning, TEXT("%s: Shared audio capture buffer of device %s overflowed, %u samples dropped"), *FString(__func__), *DeviceID, NumDroppedSamples);
+		}
+
+		const int32 PoppedSamples = static_cast<int32>(CaptureBuffer->Buffer.Pop(Chunk.GetData(), ChunkSize));
+		if (PoppedSamples <= 0)
+		{
+			FPlatformProcess::Sleep(0.005f);
+			continue;
+		}
+
+		DispatchCapturedAudio(Chunk.GetData(), PoppedSamples);
+	}
+
+	return 0u;
+}
+
+void FAzSpeechSharedAudioCapture::Stop()
+{
+	bStopCapture = true;
+}
+
+bool FAzSpeechSharedAudioCapture::OpenCaptureStream()
+{
+	AudioCapture = MakeUnique<Audio::FAudioCapture>();
+
+	Audio::FAudioCaptureDeviceParams Params;
+	Params.DeviceIndex = DeviceIndex;
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3)
+	const Audio::FOnAudioCaptureFunction OnCapture = [this](const void* InAudio, int32 NumFrames, int32 NumChannels, int32 InSampleRate, [[maybe_unused]] double StreamTime, [[maybe_unused]] bool bOverFlow)
+	{
+		OnAudioCaptured(static_cast<const float*>(InAudio), NumFrames, NumChannels, InSampleRate);
+	};
+
+	const bool bOpened = AudioCapture->OpenAudioCaptureStream(Params, OnCapture, 1024);
+#else
+	const Audio::FOnCaptureFunction OnCapture = [this](const float* InAudio, int32 NumFrames, int32 NumChannels, int32 InSampleRate, [[maybe_unused]] double StreamTime, [[maybe_unused]] bool bOverFlow)
+	{
+		OnAudioCaptured(InAudio, NumFrames, NumChannels, InSampleRate);
+	};
+
+	const bool bOpened = AudioCapture->OpenCaptureStream(Params, OnCapture, 1024);
+#endif
+
+	if (!bOpened || !AudioCapture->StartStream())
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Failed to open the audio capture stream of device %s"), *FString(__func__), *DeviceID);
+
+		AudioCapture.Reset();
+		return false;
+	}
+
+	bIsCapturing = true;
+	Thread.Reset(FRunnableThread::Create(this, *FString::Printf(TEXT("AzSpeech_SharedAudioCapture_%s"), *DeviceID), 0u, TPri_AboveNormal));
+
+	return true;
+}
+
+void FAzSpeechSharedAudioCapture::CloseCaptureStream()
+{
+	if (AudioCapture.IsValid())
+	{
+		AudioCapture->StopStream();
+		AudioCapture->CloseStream();
+		AudioCapture.Reset();
+	}
+
+	bIsCapturing = false;
+
+	if (Thread.IsValid())
+	{
+		Thread->Kill(true);
+		Thread.Reset();
+	}
+}
+
+void FAzSpeechSharedAudioCapture::OnAudioCaptured(const float* InAudio, const int32 NumFrames, const int32 NumChannels, const int32 InSampleRate)
+{
+	if (!InAudio || NumFrames <= 0 || NumChannels <= 0 || InSampleRate <= 0)
+	{
+		return;
+	}
+
+	// Downmix to mono
+	const float ChannelScale = 1.f / static_cast<float>(NumChannels);
+
+	MonoBuffer.Reset(NumFrames);
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		float Sum = 0.f;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Sum += InAudio[Frame * NumChannels + Channel];
+		}
+
+		MonoBuffer.Add(Sum * ChannelScale);
+	}
+
+	const float* OutputSamples = MonoBuffer.GetData();
+	int32 NumOutputSamples = NumFrames;
+
+	if (InSampleRate != OutputSampleRate)
+	{
+		// Band-limited resampling: The content above the output Nyquist frequency is filtered out instead of aliasing into the speech band. The resampler keeps its state between callbacks
+		if (!Resampler.IsValid() || ResamplerInputRate != InSampleRate)
+		{
+			Resampler = MakeUnique<Audio::FResampler>();
+			Resampler->Init(Audio::EResamplingMethod::FastSinc, static_cast<float>(OutputSampleRate) / static_cast<float>(InSampleRate), 1);
+			ResamplerInputRate = InSampleRate;
+		}
+
+		const int32 MaxOutputSamples = FMath::CeilToInt(static_cast<float>(NumFrames) * OutputSampleRate / InSampleRate) + 16;
+		ResampleBuffer.Reset(MaxOutputSamples);
+		ResampleBuffer.AddUninitialized(MaxOutputSamples);
+
+		NumOutputSamples = 0;
+		if (Resampler->ProcessAudio(MonoBuffer.GetData(), NumFrames, false, ResampleBuffer.GetData(), MaxOutputSamples, NumOutputSamples) != 0)
+		{
+			NumOutputSamples = 0;
+		}
+
+		OutputSamples = ResampleBuffer.GetData();
+	}
+
+	if (NumOutputSamples <= 0)
+	{
+		return;
+	}
+
+	// Called from the audio device thread: The overflows are only counted here and logged by the pump thread
+	if (const uint32 PushedSamples = CaptureBuffer->Buffer.Push(OutputSamples, NumOutputSamples); PushedSamples < static_cast<uint32>(NumOutputSamples))
+	{
+		DroppedSamples += static_cast<uint32>(NumOutputSamples) - PushedSamples;
+	}
+}
+
+void FAzSpeechSharedAudioCapture::DispatchCapturedAudio(const float* InSamples, const int32 NumSamples)
+{
+	FScopeLock Lock(&ListenersMutex);
+
+	for (int32 Iterator = 0; Iterator < NumSamples; ++Iterator)
+	{
+		History[HistoryWriteIndex] = InSamples[Iterator];
+		HistoryWriteIndex = (HistoryWriteIndex + 1) % History.Num();
+	}
+
+	HistoryNum = FMath::Min(HistoryNum + NumSamples, History.Num());
+	CapturedSamples += NumSamples;
+
+	for (const FAzSpeechAudioCaptureListenerPtr& Listener : Listeners)
+	{
+		Listener->ProcessAudio(InSamples, NumSamples);
+	}
+}
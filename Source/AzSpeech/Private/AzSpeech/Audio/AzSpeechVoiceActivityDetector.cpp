@@ -0,0 +1,263 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Audio/AzSpeechVoiceActivityDetector.h"
+#include "LogAzSpeech.h"
+#include <Runtime/Launch/Resources/Version.h>
+
+#if ENGINE_MAJOR_VERSION >= 5
+typedef VectorRegister4Float FAzSpeechVectorRegister;
+#define AZSPEECH_VECTOR_ZERO VectorZeroFloat
+#else
+typedef VectorRegister FAzSpeechVectorRegister;
+#define AZSPEECH_VECTOR_ZERO VectorZero
+#endif
+
+namespace AzSpeech::Internal
+{
+	constexpr float InitialNoiseFloorDb = -70.f;
+	constexpr float MinimumEnergy = 1.e-10f;
+
+	// Frames barely above the threshold with a high zero crossing rate are usually broadband noise (fans, hiss) instead of voice
+	constexpr float NoiseRejectionMarginDb = 6.f;
+	constexpr float NoiseZeroCrossingRate = 0.5f;
+}
+
+FAzSpeechVoiceActivityDetector::FAzSpeechVoiceActivityDetector(const FAzSpeechVoiceActivityOptions& InOptions, const int32 InSampleRate) : Options(InOptions), NoiseFloorDb(AzSpeech::Internal::InitialNoiseFloorDb)
+{
+	FrameSize = FMath::Max(1, InSampleRate * FrameLengthMs / 1000);
+	MinSpeechFrames = FMath::Max(1, Options.MinSpeechDurationMs / FrameLengthMs);
+	HangoverFrames = FMath::Max(1, Options.HangoverMs / FrameLengthMs);
+}
+
+EAzSpeechVoiceActivityEvent FAzSpeechVoiceActivityDetector::ProcessFrame(const float* InFrame)
+{
+	const float EnergyDb = 10.f * FMath::LogX(10.f, FMath::Max(GetMeanSquare(InFrame, FrameSize), AzSpeech::Internal::MinimumEnergy));
+	const float Threshold = Options.bUseAdaptiveNoiseFloor ? FMath::Max(Options.ThresholdDb, NoiseFloorDb + Options.NoiseFloorMarginDb) : Options.ThresholdDb;
+
+	bool bIsVoiced = EnergyDb >= Threshold;
+	if (bIsVoiced && EnergyDb < Threshold + AzSpeech::Internal::NoiseRejectionMarginDb)
+	{
+		bIsVoiced = GetZeroCrossingRate(InFrame, FrameSize) < AzSpeech::Internal::NoiseZeroCrossingRate;
+	}
+
+	if (!bIsSpeechActive)
+	{
+		if (!bIsVoiced)
+		{
+			VoicedFrames = 0;
+
+			// Fast attack when the noise decreases, slow release when it increases
+			const float Smoothing = EnergyDb < NoiseFloorDb ? 0.5f : 0.05f;
+			NoiseFloorDb += (EnergyDb - NoiseFloorDb) * Smoothing;
+
+			return EAzSpeechVoiceActivityEvent::None;
+		}
+
+		if (++VoicedFrames < MinSpeechFrames)
+		{
+			return EAzSpeechVoiceActivityEvent::None;
+		}
+
+		bIsSpeechActive = true;
+		SilenceFrames = 0;
+
+		return EAzSpeechVoiceActivityEvent::SpeechStarted;
+	}
+
+	if (bIsVoiced)
+	{
+		SilenceFrames = 0;
+		return EAzSpeechVoiceActivityEvent::None;
+	}
+
+	if (++SilenceFrames < HangoverFrames)
+	{
+		return EAzSpeechVoiceActivityEvent::None;
+	}
+
+	bIsSpeechActive = false;
+	VoicedFrames = 0;
+
+	return EAzSpeechVoiceActivityEvent::SpeechEnded;
+}
+
+void FAzSpeechVoiceActivityDetector::Reset()
+{
+	bIsSpeechActive = false;
+	VoicedFrames = 0;
+	SilenceFrames = 0;
+	NoiseFloorDb = AzSpeech::Internal::InitialNoiseFloorDb;
+}
+
+const int32 FAzSpeechVoiceActivityDetector::GetFrameSize() const
+{
+	return FrameSize;
+}
+
+const bool FAzSpeechVoiceActivityDetector::IsSpeechActive() const
+{
+	return bIsSpeechActive;
+}
+
+const float FAzSpeechVoiceActivityDetector::GetNoiseFloorDb() const
+{
+	return NoiseFloorDb;
+}
+
+const float FAzSpeechVoiceActivityDetector::GetMeanSquare(const float* InSamples, const int32 NumSamples)
+{
+	if (NumSamples <= 0)
+	{
+		return 0.f;
+	}
+
+	FAzSpeechVectorRegister Accumulator = AZSPEECH_VECTOR_ZERO();
+
+	int32 Iterator = 0;
+	for (; Iterator + 4 <= NumSamples; Iterator += 4)
+	{
+		const FAzSpeechVectorRegister Samples = VectorLoad(InSamples + Iterator);
+		Accumulator = VectorMultiplyAdd(Samples, Samples, Accumulator);
+	}
+
+	alignas(16) float Partial[4];
+	VectorStoreAligned(Accumulator, Partial);
+
+	float Sum = Partial[0] + Partial[1] + Partial[2] + Partial[3];
+	for (; Iterator < NumSamples; ++Iterator)
+	{
+		Sum += InSamples[Iterator] * InSamples[Iterator];
+	}
+
+	return Sum / static_cast<float>(NumSamples);
+}
+
+const float FAzSpeechVoiceActivityDetector::GetZeroCrossingRate(const float* InSamples, const int32 NumSamples)
+{
+	if (NumSamples <= 1)
+	{
+		return 0.f;
+	}
+
+	int32 Crossings = 0;
+	for (int32 Iterator = 1; Iterator < NumSamples; ++Iterator)
+	{
+		Crossings += (InSamples[Iterator - 1] >= 0.f) != (InSamples[Iterator] >= 0.f);
+	}
+
+	return static_cast<float>(Crossings) / static_cast<float>(NumSamples - 1);
+}
+
+FAzSpeechVoiceActivityListener::FAzSpeechVoiceActivityListener(const FAzSpeechVoiceActivityOptions& InOptions, const int32 InFlushSilenceMs) : Detector(InOptions, FAzSpeechSharedAudioCapture::OutputSampleRate), bFlushOnSpeechEnd(InOptions.bFlushOnSpeechEnd)
+{
+	FlushSilenceSamples = FMath::Max(0, InFlushSilenceMs) * FAzSpeechSharedAudioCapture::OutputSampleRate / 1000;
+
+	PendingFrame.SetNumZeroed(Detector.GetFrameSize());
+
+	if (bFlushOnSpeechEnd)
+	{
+		SilenceBuffer.SetNumZeroed(FlushSilenceSamples);
+	}
+
+	// The frames used to confirm the speech start are also kept, so they're sent with the pre-roll
+	const int32 PreRollSamples = (FMath::Max(0, InOptions.PreRollMs) + InOptions.MinSpeechDurationMs + FAzSpeechVoiceActivityDetector::FrameLengthMs) * FAzSpeechSharedAudioCapture::OutputSampleRate / 1000;
+	PreRoll.SetNumZeroed(FMath::Max(PreRollSamples, Detector.GetFrameSize()));
+}
+
+void FAzSpeechVoiceActivityListener::ProcessAudio(const float* InSamples, const int32 NumSamples)
+{
+	const int32 FrameSize = Detector.GetFrameSize();
+
+	int32 Offset = 0;
+	while (Offset < NumSamples)
+	{
+		const int32 CopiedSamples = FMath::Min(FrameSize - PendingSamples, NumSamples - Offset);
+		FMemory::Memcpy(PendingFrame.GetData() + PendingSamples, InSamples + Offset, CopiedSamples * sizeof(float));
+
+		PendingSamples += CopiedSamples;
+		Offset += CopiedSamples;
+
+		if (PendingSamples == FrameSize)
+		{
+			ProcessFrame(PendingFrame.GetData());
+			PendingSamples = 0;
+		}
+	}
+}
+
+void FAzSpeechVoiceActivityListener::ProcessFrame(const float* InFrame)
+{
+	const bool bWasSpeechActive = Detector.IsSpeechActive();
+
+	switch (Detector.ProcessFrame(InFrame))
+	{
+		case EAzSpeechVoiceActivityEvent::SpeechStarted:
+			UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Speech started. Noise floor: %.1f dBFS"), *FString(__func__), Detector.GetNoiseFloorDb());
+
+			WritePreRoll(InFrame);
+			FlushPreRoll();
+
+			if (OnSpeechStarted)
+			{
+				OnSpeechStarted();
+			}
+			return;
+
+		case EAzSpeechVoiceActivityEvent::SpeechEnded:
+			UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Speech ended"), *FString(__func__));
+
+			WriteToStream(InFrame, Detector.GetFrameSize());
+
+			if (bFlushOnSpeechEnd && SilenceBuffer.Num() > 0)
+			{
+				// Let the service finalize the segment now instead of waiting for the real silence timeout
+				WriteToStream(SilenceBuffer.GetData(), SilenceBuffer.Num());
+			}
+
+			if (OnSpeechEnded)
+			{
+				OnSpeechEnded();
+			}
+			return;
+
+		default:
+			break;
+	}
+
+	if (bWasSpeechActive)
+	{
+		WriteToStream(InFrame, Detector.GetFrameSize());
+	}
+	else
+	{
+		WritePreRoll(InFrame);
+	}
+}
+
+void FAzSpeechVoiceActivityListener::WritePreRoll(const float* InFrame)
+{
+	for (int32 Iterator = 0; Iterator < Detector.GetFrameSize(); ++Iterator)
+	{
+		PreRoll[PreRollWriteIndex] = InFrame[Iterator];
+		PreRollWriteIndex = (PreRollWriteIndex + 1) % PreRoll.Num();
+	}
+
+	PreRollNum = FMath::Min(PreRollNum + Detector.GetFrameSize(), PreRoll.Num());
+}
+
+void FAzSpeechVoiceActivityListener::FlushPreRoll()
+{
+	const int32 ReadStart = (PreRollWriteIndex - PreRollNum + PreRoll.Num()) % PreRoll.Num();
+	const int32 FirstSegmentNum = FMath::Min(PreRollNum, PreRoll.Num() - ReadStart);
+
+	WriteToStream(PreRoll.GetData() + ReadStart, FirstSegmentNum);
+	if (FirstSegmentNum < PreRollNum)
+	{
+		WriteToStream(PreRoll.GetData(), PreRollNum - FirstSegmentNum);
+	}
+
+	PreRollNum = 0;
+	PreRollWriteIndex = 0;
+}
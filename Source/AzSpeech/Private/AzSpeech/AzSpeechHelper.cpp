@@ -4,7 +4,16 @@
 
 #include "AzSpeech/AzSpeechHelper.h"
 #include "AzSpeechInternalFuncs.h"
+#include "AzSpeechMemory.h"
 #include "AzSpeech/AzSpeechSettings.h"
+#include "AzSpeech/Managers/AzSpeechAudioInputDeviceRegistry.h"
+#include "AzSpeech/Managers/AzSpeechEndpointManager.h"
+#include "AzSpeech/Managers/AzSpeechCircuitBreaker.h"
+#include "AzSpeech/Managers/AzSpeechHedgingManager.h"
+#include "AzSpeech/Managers/AzSpeechMetricsRegistry.h"
+#include "AzSpeech/Animation/AzSpeechAnimationParser.h"
+#include "AzSpeech/Animation/AzSpeechVisemeTimeline.h"
+#include "AzSpeech/Container/AzSpeechLineFile.h"
 #include "AzSpeech/Tasks/Bases/AzSpeechRecognizerTaskBase.h"
 #include "AzSpeech/Tasks/Bases/AzSpeechSynthesizerTaskBase.h"
 #include <Sound/SoundWave.h>
@@ -12,7 +21,6 @@
 #include <Misc/Paths.h>
 #include <DesktopPlatformModule.h>
 #include <Kismet/GameplayStatics.h>
-#include <AudioCaptureCore.h>
 #include <Misc/Paths.h>
 #include <HAL/FileManager.h>
 #include <AssetRegistry/AssetRegistryModule.h>
@@ -22,9 +30,6 @@
 #include <Sound/AudioSettings.h>
 #include <Engine/Engine.h>
 #include <Interfaces/IPluginManager.h>
-#include <Serialization/JsonReader.h>
-#include <Serialization/JsonSerializer.h>
-#include <Dom/JsonObject.h>
 
 #if WITH_EDITORONLY_DATA
 #include <EditorFramework/AssetImportData.h>
@@ -135,6 +140,19 @@ USoundWave* UAzSpeechHelper::ConvertWavFileToSoundWave(const FString& FilePath,
 
 USoundWave* UAzSpeechHelper::ConvertAudioDataToSoundWave(const TArray<uint8>& RawData, const FString& OutputModulePath, const FString& RelativeOutputDirectory, const FString& OutputAssetName)
 {
+	return CreateSoundWaveFromAudioData(RawData, nullptr, OutputModulePath, RelativeOutputDirectory, OutputAssetName);
+}
+
+USoundWave* UAzSpeechHelper::ConvertAudioBufferToSoundWave(const FAzSpeechAudioBuffer& AudioBuffer, const FString& OutputModulePath, const FString& RelativeOutputDirectory, const FString& OutputAssetName)
+{
+	return CreateSoundWaveFromAudioData(AudioBuffer.GetView(), &AudioBuffer, OutputModulePath, RelativeOutputDirectory, OutputAssetName);
+}
+
+USoundWave* UAzSpeechHelper::CreateSoundWaveFromAudioData(const TArrayView<const uint8> RawData, const FAzSpeechAudioBuffer* const SharedData, const FString& OutputModulePath, const FString& RelativeOutputDirectory, const FString& OutputAssetName)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Helper_ConvertAudioDataToSoundWave);
+	AZSPEECH_LLM_SCOPE(Audio);
+
 #if PLATFORM_ANDROID
 	if (!CheckAndroidPermission("android.permission.WRITE_EXTERNAL_STORAGE"))
 	{
@@ -142,7 +160,7 @@ USoundWave* UAzSpeechHelper::ConvertAudioDataToSoundWave(const TArray<uint8>& Ra
 	}
 #endif
 
-	if (!IsAudioDataValid(RawData))
+	if (RawData.Num() == 0)
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: RawData is empty"), *FString(__func__));
 		return nullptr;
@@ -201,7 +219,8 @@ USoundWave* UAzSpeechHelper::ConvertAudioDataToSoundWave(const TArray<uint8>& Ra
 	{
 #if WITH_EDITORONLY_DATA
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-		SoundWave->RawData.UpdatePayload(FSharedBuffer::Clone(RawData.GetData(), RawData.Num()));
+		// Reference the task's audio data instead of cloning it when available
+		SoundWave->RawData.UpdatePayload(SharedData ? SharedData->ToSharedBuffer() : FSharedBuffer::Clone(RawData.GetData(), RawData.Num()));
 #else
 		SoundWave->RawData.Lock(LOCK_READ_WRITE);
 		void* LockedData = SoundWave->RawData.Realloc(RawData.Num());
@@ -210,6 +229,7 @@ USoundWave* UAzSpeechHelper::ConvertAudioDataToSoundWave(const TArray<uint8>& Ra
 #endif
 #endif
 
+		// The sound wave owns and frees the PCM data: This is the only copy required outside of the editor
 		SoundWave->RawPCMDataSize = WaveInfo.SampleDataSize;
 		SoundWave->RawPCMData = static_cast<uint8*>(FMemory::Malloc(WaveInfo.SampleDataSize));
 		FMemory::Memcpy(SoundWave->RawPCMData, WaveInfo.SampleDataStart, WaveInfo.SampleDataSize);
@@ -292,6 +312,129 @@ USoundWave* UAzSpeechHelper::ConvertAudioDataToSoundWave(const TArray<uint8>& Ra
 	return nullptr;
 }
 
+const bool UAzSpeechHelper::SaveSpeechLineFile(UAzSpeechSynthesizerTaskBase* Task, const FString& FilePath, const FString& FileName)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Helper_SaveSpeechLineFile);
+
+	if (!IsValid(Task) || !Task->IsLastResultValid())
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Invalid task or result"), *FString(__func__));
+		return false;
+	}
+
+	if (AzSpeech::Internal::HasEmptyParam(FilePath, FileName))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: FilePath or FileName is empty"), *FString(__func__));
+		return false;
+	}
+
+	if (!CreateNewDirectory(FilePath))
+	{
+		return false;
+	}
+
+	// The timeline holds the visemes and the packed blend shapes with the same layout as the file
+	FAzSpeechVisemeTimeline Timeline;
+	Task->UpdateVisemeTimeline(Timeline);
+
+	const FAzSpeechAudioBuffer AudioBuffer = Task->GetAudioBuffer();
+
+	TArray<FAzSpeechWordBoundary> WordBoundaries;
+	Task->CopyWordBoundaries(WordBoundaries);
+
+	FAzSpeechLineFile::FLineData LineData;
+	LineData.AudioData = AudioBuffer.GetView();
+	LineData.VisemeOffsets = Timeline.GetVisemeOffsets();
+	LineData.VisemeIDs = Timeline.GetVisemeIDs();
+	LineData.BlendShapes = &Timeline.GetBlendShapes();
+	LineData.WordBoundaries = WordBoundaries;
+	LineData.Text = Task->GetSynthesisText();
+	const FAzSpeechSettingsOptions TaskOptions = Task->GetTaskOptions();
+	LineData.SourceHash = FAzSpeechLineFile::ComputeSourceHash(LineData.Text, TaskOptions.VoiceName, TaskOptions.LanguageID, TaskOptions.SpeechSynthesisOutputFormat);
+
+	const FString Full_FileName = QualifySpeechLineFileName(FilePath, FileName);
+	if (!FAzSpeechLineFile::Write(Full_FileName, LineData))
+	{
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Result: '%s' saved"), *FString(__func__), *Full_FileName);
+	return true;
+}
+
+const bool UAzSpeechHelper::LoadSpeechLineFile(const FString& FilePath, const FString& FileName, USoundWave*& OutSoundWave, UAzSpeechVisemeTimeline*& OutTimeline, const FString& OutputModulePath, const FString& RelativeOutputDirectory, const FString& OutputAssetName)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Helper_LoadSpeechLineFile);
+
+	OutSoundWave = nullptr;
+	OutTimeline = nullptr;
+
+	if (AzSpeech::Internal::HasEmptyParam(FilePath, FileName))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: FilePath or FileName is empty"), *FString(__func__));
+		return false;
+	}
+
+	FAzSpeechLineFile LineFile;
+	if (!LineFile.Open(QualifySpeechLineFileName(FilePath, FileName)))
+	{
+		return false;
+	}
+
+	// The audio is read from the mapped file: The sound wave copies only its PCM data
+	OutSoundWave = CreateSoundWaveFromAudioData(LineFile.GetAudioData(), nullptr, OutputModulePath, RelativeOutputDirectory, OutputAssetName);
+	OutTimeline = UAzSpeechVisemeTimeline::CreateVisemeTimelineFromLineFile(LineFile);
+
+	return IsValid(OutSoundWave) && IsValid(OutTimeline);
+}
+
+const TArray<FAzSpeechWordBoundaryData> UAzSpeechHelper::GetSpeechLineFileWordBoundaries(const FString& FilePath, const FString& FileName)
+{
+	TArray<FAzSpeechWordBoundaryData> Output;
+
+	if (AzSpeech::Internal::HasEmptyParam(FilePath, FileName))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: FilePath or FileName is empty"), *FString(__func__));
+		return Output;
+	}
+
+	FAzSpeechLineFile LineFile;
+	if (!LineFile.Open(QualifySpeechLineFileName(FilePath, FileName)))
+	{
+		return Output;
+	}
+
+	const FString Text = LineFile.GetText();
+	const TArrayView<const FAzSpeechWordBoundary> WordBoundaries = LineFile.GetWordBoundaries();
+
+	Output.Reserve(WordBoundaries.Num());
+	for (const FAzSpeechWordBoundary& Iterator : WordBoundaries)
+	{
+		Output.Emplace(Iterator, Text);
+	}
+
+	return Output;
+}
+
+const bool UAzSpeechHelper::IsSpeechLineFileUpToDate(const FString& FilePath, const FString& FileName, const FString& Text, const FName VoiceName, const FName LanguageID, const EAzSpeechSynthesisOutputFormat OutputFormat)
+{
+	if (AzSpeech::Internal::HasEmptyParam(FilePath, FileName))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: FilePath or FileName is empty"), *FString(__func__));
+		return false;
+	}
+
+	const FString Full_FileName = QualifySpeechLineFileName(FilePath, FileName);
+	if (!IFileManager::Get().FileExists(*Full_FileName))
+	{
+		return false;
+	}
+
+	// Mapping the file only reads the pages of its header
+	FAzSpeechLineFile LineFile;
+	return LineFile.Open(Full_FileName) && LineFile.GetSourceHash() == FAzSpeechLineFile::ComputeSourceHash(Text, VoiceName, LanguageID, OutputFormat);
+}
+
 const FString UAzSpeechHelper::LoadXMLToString(const FString& FilePath, const FString& FileName)
 {
 	if (AzSpeech::Internal::HasEmptyParam(FilePath, FileName))
@@ -393,27 +536,25 @@ const bool UAzSpeechHelper::IsAudioDataValid(const TArray<uint8>& RawData)
 
 const TArray<FAzSpeechAudioInputDeviceInfo> UAzSpeechHelper::GetAvailableAudioInputDevices()
 {
-	TArray<FAzSpeechAudioInputDeviceInfo> Output;
-	TArray<Audio::FCaptureDeviceInfo> Internal_Devices;
-
-	if (Audio::FAudioCapture AudioCapture; AudioCapture.GetCaptureDevicesAvailable(Internal_Devices) <= 0)
+	const TArray<FAzSpeechAudioInputDeviceInfo> Output = FAzSpeechAudioInputDeviceRegistry::Get().GetDevices();
+	if (AzSpeech::Internal::HasEmptyParam(Output))
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: There's no available audio input devices"), *FString(__func__));
 	}
 	else
 	{
 		UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Result: Success"), *FString(__func__));
-
-		for (const Audio::FCaptureDeviceInfo& DeviceInfo : Internal_Devices)
-		{
-			Output.Add(FAzSpeechAudioInputDeviceInfo(DeviceInfo.DeviceName, DeviceInfo.DeviceId));
-			UE_LOG(LogAzSpeech_Debugging, Display, TEXT("%s: Found available audio input device: %s - %s"), *FString(__func__), *Output.Last().DeviceName, *Output.Last().GetAudioInputDeviceEndpointID());
-		}
 	}
 
 	return Output;
 }
 
+void UAzSpeechHelper::RefreshAudioInputDevices()
+{
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Refreshing available audio input devices"), *FString(__func__));
+	FAzSpeechAudioInputDeviceRegistry::Get().Refresh();
+}
+
 template <typename ReturnTy>
 const ReturnTy GetInformationFromDeviceID_T(const FString& DeviceID)
 {
@@ -436,18 +577,15 @@ const ReturnTy GetInformationFromDeviceID_T(const FString& DeviceID)
 		return InvalidReturn_Lambda();
 	}
 
-	for (const FAzSpeechAudioInputDeviceInfo& DeviceInfo : UAzSpeechHelper::GetAvailableAudioInputDevices())
+	if (FAzSpeechAudioInputDeviceInfo DeviceInfo; FAzSpeechAudioInputDeviceRegistry::Get().FindDevice(DeviceID, DeviceInfo))
 	{
-		if (DeviceInfo.GetDeviceID().Contains(DeviceID))
+		if constexpr (std::is_base_of<ReturnTy, bool>())
 		{
-			if constexpr (std::is_base_of<ReturnTy, bool>())
-			{
-				return true;
-			}
-			else if constexpr (std::is_base_of<ReturnTy, FAzSpeechAudioInputDeviceInfo>())
-			{
-				return DeviceInfo;
-			}
+			return true;
+		}
+		else if constexpr (std::is_base_of<ReturnTy, FAzSpeechAudioInputDeviceInfo>())
+		{
+			return DeviceInfo;
 		}
 	}
 
@@ -469,6 +607,28 @@ const bool UAzSpeechHelper::IsAudioInputDeviceIDValid(const FString& DeviceID)
 	return !(DeviceID.Contains(FAzSpeechAudioInputDeviceInfo::InvalidDeviceID) || DeviceID.Len() < std::strlen(FAzSpeechAudioInputDeviceInfo::PlaceholderDeviceID));
 }
 
+const FAzSpeechEndpointHealth UAzSpeechHelper::GetEndpointHealth(const FAzSpeechEndpoint& Endpoint)
+{
+	return FAzSpeechEndpointManager::GetHealth(Endpoint);
+}
+
+void UAzSpeechHelper::ResetEndpointHealth()
+{
+	FAzSpeechEndpointManager::Reset();
+	FAzSpeechHedgingManager::Reset();
+	FAzSpeechCircuitBreaker::Reset();
+}
+
+const FAzSpeechLatencyPercentiles UAzSpeechHelper::GetLatencyPercentiles(const EAzSpeechLatencyMetric Metric, const FName Voice, const FString& EndpointID)
+{
+	return FAzSpeechMetricsRegistry::GetPercentiles(Metric, Voice, EndpointID);
+}
+
+void UAzSpeechHelper::ResetLatencyMetrics()
+{
+	FAzSpeechMetricsRegistry::Reset();
+}
+
 const TArray<FString> UAzSpeechHelper::GetAvailableContentModules()
 {
 	TArray<FString> Output{ "Game" };
@@ -491,33 +651,19 @@ const TArray<FString> UAzSpeechHelper::GetAvailableContentModules()
 
 const FAzSpeechAnimationData UAzSpeechHelper::ExtractAnimationDataFromVisemeData(const FAzSpeechVisemeData& VisemeData)
 {
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Helper_ExtractAnimationDataFromVisemeData);
+	AZSPEECH_LLM_SCOPE(Visemes);
+
 	FAzSpeechAnimationData Output;
 	if (AzSpeech::Internal::HasEmptyParam(VisemeData.Animation))
 	{
 		return Output;
 	}
 
-	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(VisemeData.Animation);
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	FJsonSerializer::Deserialize(Reader, JsonObject);
-
-	if (!JsonObject.IsValid())
+	if (!FAzSpeechAnimationParser::Parse(VisemeData.Animation, Output))
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Failed to deserialize animation data"), *FString(__func__));
-		return Output;
-	}
-
-	Output.FrameIndex = JsonObject->GetIntegerField("FrameIndex");
-
-	for (const TSharedPtr<FJsonValue>& IteratorArray : JsonObject->GetArrayField("BlendShapes"))
-	{
-		FAzSpeechBlendShapes CurrentBlendShapes;
-		for (const TSharedPtr<FJsonValue>& IteratorValue : IteratorArray->AsArray())
-		{
-			CurrentBlendShapes.Data.Add(static_cast<float>(IteratorValue->AsNumber()));
-		}
-		
-		Output.BlendShapes.Add(CurrentBlendShapes);
+		return FAzSpeechAnimationData();
 	}
 
 	return Output;
@@ -525,7 +671,10 @@ const FAzSpeechAnimationData UAzSpeechHelper::ExtractAnimationDataFromVisemeData
 
 const TArray<FAzSpeechAnimationData> UAzSpeechHelper::ExtractAnimationDataFromVisemeDataArray(const TArray<FAzSpeechVisemeData>& VisemeData)
 {
+	AZSPEECH_LLM_SCOPE(Visemes);
+
 	TArray<FAzSpeechAnimationData> Output;
+	Output.Reserve(VisemeData.Num());
 
 	for (const FAzSpeechVisemeData& VisemeDataElement : VisemeData)
 	{
@@ -3,6 +3,7 @@
 // Repo: https://github.com/lucoiso/UEAzSpeech
 
 #include "AzSpeech/AzSpeechSettings.h"
+#include "AzSpeech/Managers/AzSpeechConfigCache.h"
 #include "AzSpeechInternalFuncs.h"
 #include <Runtime/Launch/Resources/Version.h>
 
@@ -14,7 +15,7 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AzSpeechSettings)
 #endif
 
-UAzSpeechSettings::UAzSpeechSettings(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer), SegmentationSilenceTimeoutMs(1000), InitialSilenceTimeoutMs(5000), bFilterVisemeFacialExpression(true), TimeOutInSeconds(10.f), TasksThreadPriority(EAzSpeechThreadPriority::Normal), ThreadUpdateInterval(0.033334f), bEnableSDKLogs(true), bEnableInternalLogs(false), bEnableDebuggingLogs(false), bEnableDebuggingPrints(false), StringDelimiters(" ,.;:[]{}!'\"?")
+UAzSpeechSettings::UAzSpeechSettings(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer), SegmentationSilenceTimeoutMs(1000), InitialSilenceTimeoutMs(5000), bFilterVisemeFacialExpression(true), bUseSharedAudioCapture(false), TimeOutInSeconds(10.f), MaxHedgeRatio(0.05f), TasksThreadPriority(EAzSpeechThreadPriority::Normal), ThreadUpdateInterval(0.033334f), bEnableSDKLogs(true), bEnableInternalLogs(false), bEnableDebuggingLogs(false), bEnableDebuggingPrints(false), bEnableFailureEventLog(false), bEnableSDKMemoryLogger(false), StringDelimiters(" ,.;:[]{}!'\"?")
 {
 	CategoryName = TEXT("Plugins");
 
@@ -93,6 +94,8 @@ void UAzSpeechSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyCh
 	{
 		ToggleInternalLogs();
 	}
+
+	FAzSpeechConfigCache::Reset();
 }
 #endif
 
@@ -111,10 +114,19 @@ void UAzSpeechSettings::SetToDefaults()
 	DefaultOptions.RegionID = NAME_None;
 	DefaultOptions.bUsePrivateEndpoint = false;
 	DefaultOptions.PrivateEndpoint = NAME_None;
+	DefaultOptions.bUseEndpointPool = false;
+	DefaultOptions.bEnableRequestHedging = false;
+	DefaultOptions.Backend = EAzSpeechBackend::Cloud;
+	DefaultOptions.EmbeddedRecognitionModel = NAME_None;
+	DefaultOptions.EmbeddedSynthesisVoice = NAME_None;
+	DefaultOptions.EmbeddedModelKey = NAME_None;
+	DefaultOptions.FallbackPolicy = EAzSpeechFallbackPolicy::Disabled;
+	DefaultOptions.FallbackLatencyBudgetMs = 1500;
 	DefaultOptions.LanguageID = NAME_None;
 	DefaultOptions.VoiceName = NAME_None;
 	DefaultOptions.ProfanityFilter = EAzSpeechProfanityFilter::Raw;
 	DefaultOptions.bEnableViseme = true;
+	DefaultOptions.bEnableWordBoundary = true;
 	DefaultOptions.SpeechSynthesisOutputFormat = EAzSpeechSynthesisOutputFormat::Riff16Khz16BitMonoPcm;
 	DefaultOptions.SpeechRecognitionOutputFormat = EAzSpeechRecognitionOutputFormat::Detailed;
 
@@ -244,34 +256,35 @@ const std::map<unsigned short int, std::string> UAzSpeechSettings::GetAzSpeechKe
 
 const bool UAzSpeechSettings::CheckAzSpeechSettings()
 {
-	const auto AzSpeechParams = GetAzSpeechKeys();
-	if (AzSpeechParams.empty())
+	const UAzSpeechSettings* const Instance = UAzSpeechSettings::Get();
+	if (!IsValid(Instance))
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Invalid settings. Check your AzSpeech settings on Project Settings -> AzSpeech Settings."), *FString(__func__));
 		return false;
 	}
 
-	const bool bUsingEndpoint = UAzSpeechSettings::Get()->DefaultOptions.bUsePrivateEndpoint;
+	return CheckAzSpeechSettings(Instance->DefaultOptions);
+}
 
-	for (uint8 Iterator = 0u; Iterator < AzSpeechParams.size(); ++Iterator)
+const bool UAzSpeechSettings::CheckAzSpeechSettings(const FAzSpeechSettingsOptions& Options)
+{
+	bool bOutput = true;
+
+	if (Options.UsesCloudBackend())
 	{
-		if (bUsingEndpoint && Iterator == AZSPEECH_KEY_REGION)
-		{
-			// Do not check region
-			continue;
-		}
-		else if (!bUsingEndpoint && Iterator == AZSPEECH_KEY_ENDPOINT)
-		{
-			// Do not check endpoint
-			continue;
-		}
+		bOutput = !AzSpeech::Internal::HasEmptyParam(Options.LanguageID, Options.VoiceName) && Options.HasValidEndpoint();
+	}
 
-		if (AzSpeechParams.at(Iterator).empty())
-		{
-			UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Invalid settings. Check your AzSpeech settings on Project Settings -> AzSpeech Settings."), *FString(__func__));
-			return false;
-		}
+	if (Options.UsesEmbeddedBackend() || Options.UsesEmbeddedFallback())
+	{
+		bOutput = bOutput && !AzSpeech::Internal::HasEmptyParam(Options.EmbeddedModelPaths);
+		bOutput = bOutput && !(AzSpeech::Internal::HasEmptyParam(Options.EmbeddedRecognitionModel) && AzSpeech::Internal::HasEmptyParam(Options.EmbeddedSynthesisVoice));
+	}
+
+	if (!bOutput)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Invalid settings. Check your AzSpeech settings on Project Settings -> AzSpeech Settings."), *FString(__func__));
 	}
 
-	return true;
+	return bOutput;
 }
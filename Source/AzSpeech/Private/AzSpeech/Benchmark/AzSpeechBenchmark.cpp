@@ -0,0 +1,580 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Benchmark/AzSpeechBenchmark.h"
+#include "AzSpeech/Tasks/TextToAudioDataAsync.h"
+#include "AzSpeech/Tasks/WavFileToTextAsync.h"
+#include "AzSpeech/AzSpeechHelper.h"
+#include "AzSpeech/Audio/AzSpeechWaveHeader.h"
+#include "AzSpeechInternalFuncs.h"
+#include "LogAzSpeech.h"
+#include <HAL/ThreadManager.h>
+#include <HAL/PlatformMemory.h>
+#include <HAL/IConsoleManager.h>
+#include <HAL/FileManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Misc/DateTime.h>
+#include <Misc/Parse.h>
+#include <Dom/JsonObject.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+#include <cstdlib>
+
+#ifdef UE_INLINE_GENERATED_CPP_BY_NAME
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AzSpeechBenchmark)
+#endif
+
+namespace AzSpeech::Internal
+{
+	constexpr double BenchmarkFailureGraceSeconds = 2.0;
+	constexpr int32 BenchmarkInputSampleRate = 16000;
+	constexpr int32 BenchmarkInputDurationMs = 2000;
+
+#if AZSPEECH_WITH_CALLBACK_ACCOUNTING
+	std::atomic<uint64> GameThreadCallbackCycles { 0u };
+
+	void AddGameThreadCallbackCycles(const uint64 InCycles)
+	{
+		GameThreadCallbackCycles.fetch_add(InCycles, std::memory_order_relaxed);
+	}
+
+	const uint64 GetGameThreadCallbackCycles()
+	{
+		return GameThreadCallbackCycles.load(std::memory_order_relaxed);
+	}
+#endif
+
+	/* Nearest rank percentile of the sorted values */
+	double GetPercentile(const TArray<double>& InSortedValues, const double InPercentile)
+	{
+		if (InSortedValues.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		const int32 Rank = FMath::CeilToInt(InPercentile / 100.0 * InSortedValues.Num());
+		return InSortedValues[FMath::Clamp(Rank - 1, 0, InSortedValues.Num() - 1)];
+	}
+
+	int32 GetEngineThreadCount()
+	{
+		int32 Output = 0;
+		FThreadManager::Get().ForEachThread(
+			[&Output](const uint32, FRunnableThread*)
+			{
+				++Output;
+			}
+		);
+
+		return Output;
+	}
+
+	/* Exit the application with the result of the benchmark as process return code */
+	void RequestBenchmarkExit(const uint8 ReturnCode)
+	{
+#if ENGINE_MAJOR_VERSION >= 5
+		FPlatformMisc::RequestExitWithStatus(false, ReturnCode);
+#else
+		if (ReturnCode == 0u)
+		{
+			FPlatformMisc::RequestExit(false);
+			return;
+		}
+
+		// The engine exit of UE4 always returns 0: The reports are already written, so end the process with the failure code after flushing the logs
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: Benchmark failed, exiting with code %u"), *FString(__func__), ReturnCode);
+		GLog->Flush();
+		std::_Exit(ReturnCode);
+#endif
+	}
+}
+
+TWeakObjectPtr<UAzSpeechBenchmark> UAzSpeechBenchmark::ActiveBenchmark;
+
+void UAzSpeechBenchmarkProbe::OnSynthesisUpdated()
+{
+	Benchmark->MarkFirstResult(SampleIndex);
+}
+
+void UAzSpeechBenchmarkProbe::OnSynthesisCompleted(const TArray<uint8>& FinalAudioData)
+{
+	Benchmark->MarkCompleted(SampleIndex, UAzSpeechHelper::IsAudioDataValid(FinalAudioData));
+}
+
+void UAzSpeechBenchmarkProbe::OnRecognitionUpdated(const FString UpdatedString)
+{
+	Benchmark->MarkFirstResult(SampleIndex);
+}
+
+void UAzSpeechBenchmarkProbe::OnRecognitionCompleted(const FString FinalString)
+{
+	Benchmark->MarkCompleted(SampleIndex, !AzSpeech::Internal::HasEmptyParam(FinalString));
+}
+
+void UAzSpeechBenchmarkProbe::OnTaskFailed()
+{
+	Benchmark->MarkCompleted(SampleIndex, false);
+}
+
+UAzSpeechBenchmark* UAzSpeechBenchmark::StartBenchmark(UObject* WorldContextObject, const FAzSpeechBenchmarkOptions& Options)
+{
+	if (ActiveBenchmark.IsValid())
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: A benchmark is already running"), *FString(__func__));
+		return nullptr;
+	}
+
+	UAzSpeechBenchmark* const NewBenchmark = NewObject<UAzSpeechBenchmark>();
+	NewBenchmark->Options = Options;
+
+	if (!NewBenchmark->Start(WorldContextObject))
+	{
+		return nullptr;
+	}
+
+	return NewBenchmark;
+}
+
+UAzSpeechBenchmark* UAzSpeechBenchmark::GetActiveBenchmark()
+{
+	return ActiveBenchmark.Get();
+}
+
+void UAzSpeechBenchmark::StopBenchmark()
+{
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	for (UAzSpeechTaskBase* const Iterator : Tasks)
+	{
+		if (UAzSpeechTaskStatus::IsTaskActive(Iterator))
+		{
+			Iterator->StopAzSpeechTask();
+		}
+	}
+
+	Finish();
+}
+
+const bool UAzSpeechBenchmark::IsRunning() const
+{
+	return bIsRunning;
+}
+
+const FAzSpeechBenchmarkResult UAzSpeechBenchmark::GetResult() const
+{
+	return Result;
+}
+
+bool UAzSpeechBenchmark::Start(UObject* WorldContextObject)
+{
+	const FString RecognitionInput = Options.RecognitionTasks > 0 ? CreateRecognitionInput() : FString();
+	if (Options.RecognitionTasks > 0 && RecognitionInput.IsEmpty())
+	{
+		return false;
+	}
+
+	ReportName = FString::Printf(TEXT("AzSpeechBenchmark_%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+#if AZSPEECH_WITH_CALLBACK_ACCOUNTING
+	StartCallbackCycles = AzSpeech::Internal::GetGameThreadCallbackCycles();
+#endif
+	StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	PeakUsedPhysical = StartUsedPhysical;
+	PeakThreadCount = AzSpeech::Internal::GetEngineThreadCount();
+
+	const FAzSpeechSettingsOptions TaskOptions = GetTaskOptions();
+	const int32 TotalTasks = FMath::Max(0, Options.SynthesisTasks) + FMath::Max(0, Options.RecognitionTasks);
+
+	Samples.Reserve(TotalTasks);
+	Tasks.Reserve(TotalTasks);
+	Probes.Reserve(TotalTasks);
+
+	// All the tasks are created first, so the activation loop measures the concurrent start only
+	for (int32 Index = 0; Index < TotalTasks; ++Index)
+	{
+		UAzSpeechBenchmarkProbe* const NewProbe = NewObject<UAzSpeechBenchmarkProbe>(this);
+		NewProbe->Benchmark = this;
+		NewProbe->SampleIndex = Index;
+
+		FAzSpeechBenchmarkSample& NewSample = Samples.AddDefaulted_GetRef();
+		NewSample.bIsSynthesis = Index < Options.SynthesisTasks;
+
+		if (NewSample.bIsSynthesis)
+		{
+			UTextToAudioDataAsync* const NewTask = UTextToAudioDataAsync::TextToAudioData_CustomOptions(WorldContextObject, Options.SynthesisText, TaskOptions);
+			NewTask->SynthesisUpdated.AddDynamic(NewProbe, &UAzSpeechBenchmarkProbe::OnSynthesisUpdated);
+			NewTask->SynthesisCompleted.AddDynamic(NewProbe, &UAzSpeechBenchmarkProbe::OnSynthesisCompleted);
+			NewTask->SynthesisFailed.AddDynamic(NewProbe, &UAzSpeechBenchmarkProbe::OnTaskFailed);
+			Tasks.Add(NewTask);
+		}
+		else
+		{
+			UWavFileToTextAsync* const NewTask = UWavFileToTextAsync::WavFileToText_CustomOptions(WorldContextObject, FPaths::GetPath(RecognitionInput), FPaths::GetCleanFilename(RecognitionInput), TaskOptions);
+			NewTask->RecognitionUpdated.AddDynamic(NewProbe, &UAzSpeechBenchmarkProbe::OnRecognitionUpdated);
+			NewTask->RecognitionCompleted.AddDynamic(NewProbe, &UAzSpeechBenchmarkProbe::OnRecognitionCompleted);
+			NewTask->RecognitionFailed.AddDynamic(NewProbe, &UAzSpeechBenchmarkProbe::OnTaskFailed);
+			Tasks.Add(NewTask);
+		}
+
+		NewSample.TaskName = Tasks.Last()->GetTaskName();
+		Probes.Add(NewProbe);
+	}
+
+	if (Tasks.Num() == 0)
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: No task to run"), *FString(__func__));
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech, Display, TEXT("%s: Starting %d synthesis and %d recognition tasks"), *FString(__func__), Options.SynthesisTasks, Options.RecognitionTasks);
+
+	AddToRoot();
+	ActiveBenchmark = this;
+	bIsRunning = true;
+	StartTime = FPlatformTime::Seconds();
+
+	for (int32 Index = 0; Index < Tasks.Num(); ++Index)
+	{
+		Samples[Index].StartTime = FPlatformTime::Seconds();
+		Tasks[Index]->Activate();
+	}
+
+#if ENGINE_MAJOR_VERSION >= 5
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAzSpeechBenchmark::Tick));
+#else
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAzSpeechBenchmark::Tick));
+#endif
+
+	return true;
+}
+
+bool UAzSpeechBenchmark::Tick(float DeltaTime)
+{
+	if (!bIsRunning)
+	{
+		return false;
+	}
+
+	SampleResources();
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	bool bHasPendingTasks = false;
+
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		FAzSpeechBenchmarkSample& Sample = Samples[Index];
+		if (Sample.bIsFinished)
+		{
+			continue;
+		}
+
+		// Tasks failing before the SDK starts don't broadcast any delegate, but the final result is also broadcasted after the task is ready to destroy
+		if (UAzSpeechTaskStatus::IsTaskReadyToDestroy(Tasks[Index]))
+		{
+			if (Sample.ReadyToDestroyTime < 0.0)
+			{
+				Sample.ReadyToDestroyTime = CurrentTime;
+			}
+			else if (CurrentTime - Sample.ReadyToDestroyTime > AzSpeech::Internal::BenchmarkFailureGraceSeconds)
+			{
+				MarkCompleted(Index, false);
+				continue;
+			}
+		}
+
+		bHasPendingTasks = true;
+	}
+
+	if (!bHasPendingTasks)
+	{
+		Finish();
+		return false;
+	}
+
+	if (CurrentTime - StartTime > Options.TimeoutSeconds)
+	{
+		UE_LOG(LogAzSpeech, Warning, TEXT("%s: Benchmark timed out after %.1f seconds"), *FString(__func__), Options.TimeoutSeconds);
+		StopBenchmark();
+		return false;
+	}
+
+	return true;
+}
+
+void UAzSpeechBenchmark::Finish()
+{
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	bIsRunning = false;
+	EndTime = FPlatformTime::Seconds();
+
+#if ENGINE_MAJOR_VERSION >= 5
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#else
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#endif
+
+	SampleResources();
+	ComputeResult();
+	WriteReports();
+
+	UE_LOG(LogAzSpeech, Display, TEXT("%s: %d/%d tasks succeeded in %.2fs (%.2f tasks/s); Completion p50/p95/p99: %.1f/%.1f/%.1fms; First result p50/p95/p99: %.1f/%.1f/%.1fms; Peak threads: %d; Peak memory: %.1fMB (%+.1fMB); Game thread callbacks: %.2fms"),
+		*FString(__func__), Result.SucceededTasks, Result.TotalTasks, Result.DurationSeconds, Result.TasksPerSecond,
+		Result.CompletionP50Ms, Result.CompletionP95Ms, Result.CompletionP99Ms,
+		Result.FirstResultP50Ms, Result.FirstResultP95Ms, Result.FirstResultP99Ms,
+		Result.PeakThreadCount, Result.PeakUsedPhysicalMB, Result.UsedPhysicalDeltaMB, Result.GameThreadCallbackMs);
+
+	Tasks.Empty();
+	Probes.Empty();
+	ActiveBenchmark.Reset();
+	RemoveFromRoot();
+
+	if (Options.bExitWhenFinished)
+	{
+		AzSpeech::Internal::RequestBenchmarkExit(Result.FailedTasks > 0 ? 1u : 0u);
+	}
+}
+
+void UAzSpeechBenchmark::MarkFirstResult(const int32 InSampleIndex)
+{
+	if (!Samples.IsValidIndex(InSampleIndex) || Samples[InSampleIndex].FirstResultTime >= 0.0)
+	{
+		return;
+	}
+
+	Samples[InSampleIndex].FirstResultTime = FPlatformTime::Seconds();
+}
+
+void UAzSpeechBenchmark::MarkCompleted(const int32 InSampleIndex, const bool bSucceeded)
+{
+	if (!Samples.IsValidIndex(InSampleIndex) || Samples[InSampleIndex].bIsFinished)
+	{
+		return;
+	}
+
+	FAzSpeechBenchmarkSample& Sample = Samples[InSampleIndex];
+	Sample.bIsFinished = true;
+	Sample.bSucceeded = bSucceeded;
+	Sample.CompletedTime = FPlatformTime::Seconds();
+}
+
+void UAzSpeechBenchmark::SampleResources()
+{
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	PeakThreadCount = FMath::Max(PeakThreadCount, AzSpeech::Internal::GetEngineThreadCount());
+}
+
+void UAzSpeechBenchmark::ComputeResult()
+{
+	TArray<double> CompletionLatencies;
+	TArray<double> FirstResultLatencies;
+
+	Result = FAzSpeechBenchmarkResult();
+	Result.TotalTasks = Samples.Num();
+
+	for (const FAzSpeechBenchmarkSample& Iterator : Samples)
+	{
+		if (!Iterator.bSucceeded)
+		{
+			++Result.FailedTasks;
+			continue;
+		}
+
+		++Result.SucceededTasks;
+		CompletionLatencies.Add((Iterator.CompletedTime - Iterator.StartTime) * 1000.0);
+
+		if (Iterator.FirstResultTime >= 0.0)
+		{
+			FirstResultLatencies.Add((Iterator.FirstResultTime - Iterator.StartTime) * 1000.0);
+		}
+	}
+
+	CompletionLatencies.Sort();
+	FirstResultLatencies.Sort();
+
+	constexpr double BytesToMB = 1.0 / (1024.0 * 1024.0);
+
+	Result.DurationSeconds = EndTime - StartTime;
+	Result.TasksPerSecond = Result.DurationSeconds > 0.0 ? Result.SucceededTasks / Result.DurationSeconds : 0.0;
+	Result.CompletionP50Ms = AzSpeech::Internal::GetPercentile(CompletionLatencies, 50.0);
+	Result.CompletionP95Ms = AzSpeech::Internal::GetPercentile(CompletionLatencies, 95.0);
+	Result.CompletionP99Ms = AzSpeech::Internal::GetPercentile(CompletionLatencies, 99.0);
+	Result.FirstResultP50Ms = AzSpeech::Internal::GetPercentile(FirstResultLatencies, 50.0);
+	Result.FirstResultP95Ms = AzSpeech::Internal::GetPercentile(FirstResultLatencies, 95.0);
+	Result.FirstResultP99Ms = AzSpeech::Internal::GetPercentile(FirstResultLatencies, 99.0);
+	Result.PeakThreadCount = PeakThreadCount;
+	Result.PeakUsedPhysicalMB = PeakUsedPhysical * BytesToMB;
+	Result.UsedPhysicalDeltaMB = (static_cast<double>(PeakUsedPhysical) - static_cast<double>(StartUsedPhysical)) * BytesToMB;
+#if AZSPEECH_WITH_CALLBACK_ACCOUNTING
+	Result.GameThreadCallbackMs = FPlatformTime::ToMilliseconds64(AzSpeech::Internal::GetGameThreadCallbackCycles() - StartCallbackCycles);
+#else
+	Result.GameThreadCallbackMs = -1.0;
+#endif
+}
+
+void UAzSpeechBenchmark::WriteReports() const
+{
+	const FString OutputDirectory = Options.OutputDirectory.IsEmpty() ? FPaths::Combine(UAzSpeechHelper::GetAzSpeechLogsBaseDir(), TEXT("Benchmark")) : Options.OutputDirectory;
+	if (!UAzSpeechHelper::CreateNewDirectory(OutputDirectory))
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: Failed to create directory '%s'"), *FString(__func__), *OutputDirectory);
+		return;
+	}
+
+	const TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+	Summary->SetNumberField(TEXT("total_tasks"), Result.TotalTasks);
+	Summary->SetNumberField(TEXT("succeeded_tasks"), Result.SucceededTasks);
+	Summary->SetNumberField(TEXT("failed_tasks"), Result.FailedTasks);
+	Summary->SetNumberField(TEXT("duration_s"), Result.DurationSeconds);
+	Summary->SetNumberField(TEXT("tasks_per_second"), Result.TasksPerSecond);
+	Summary->SetNumberField(TEXT("completion_p50_ms"), Result.CompletionP50Ms);
+	Summary->SetNumberField(TEXT("completion_p95_ms"), Result.CompletionP95Ms);
+	Summary->SetNumberField(TEXT("completion_p99_ms"), Result.CompletionP99Ms);
+	Summary->SetNumberField(TEXT("first_result_p50_ms"), Result.FirstResultP50Ms);
+	Summary->SetNumberField(TEXT("first_result_p95_ms"), Result.FirstResultP95Ms);
+	Summary->SetNumberField(TEXT("first_result_p99_ms"), Result.FirstResultP99Ms);
+	Summary->SetNumberField(TEXT("peak_thread_count"), Result.PeakThreadCount);
+	Summary->SetNumberField(TEXT("peak_used_physical_mb"), Result.PeakUsedPhysicalMB);
+	Summary->SetNumberField(TEXT("used_physical_delta_mb"), Result.UsedPhysicalDeltaMB);
+	Summary->SetNumberField(TEXT("game_thread_callback_ms"), Result.GameThreadCallbackMs);
+
+	TArray<TSharedPtr<FJsonValue>> SampleValues;
+	FString SamplesCSV = TEXT("task,type,succeeded,first_result_ms,completion_ms\n");
+
+	for (const FAzSpeechBenchmarkSample& Iterator : Samples)
+	{
+		const double FirstResultMs = Iterator.FirstResultTime >= 0.0 ? (Iterator.FirstResultTime - Iterator.StartTime) * 1000.0 : -1.0;
+		const double CompletionMs = Iterator.CompletedTime >= 0.0 ? (Iterator.CompletedTime - Iterator.StartTime) * 1000.0 : -1.0;
+
+		const TSharedRef<FJsonObject> SampleObject = MakeShared<FJsonObject>();
+		SampleObject->SetStringField(TEXT("task"), Iterator.TaskName.ToString());
+		SampleObject->SetStringField(TEXT("type"), Iterator.bIsSynthesis ? TEXT("synthesis") : TEXT("recognition"));
+		SampleObject->SetBoolField(TEXT("succeeded"), Iterator.bSucceeded);
+		SampleObject->SetNumberField(TEXT("first_result_ms"), FirstResultMs);
+		SampleObject->SetNumberField(TEXT("completion_ms"), CompletionMs);
+		SampleValues.Add(MakeShared<FJsonValueObject>(SampleObject));
+
+		SamplesCSV += FString::Printf(TEXT("%s,%s,%d,%.3f,%.3f\n"), *Iterator.TaskName.ToString(), Iterator.bIsSynthesis ? TEXT("synthesis") : TEXT("recognition"), Iterator.bSucceeded ? 1 : 0, FirstResultMs, CompletionMs);
+	}
+
+	const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetObjectField(TEXT("summary"), Summary);
+	Report->SetArrayField(TEXT("samples"), SampleValues);
+
+	FString ReportJSON;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportJSON));
+
+	// Single row summary, easy to append to the history of a CI job
+	TArray<FString> SummaryKeys;
+	TArray<FString> SummaryValues;
+	for (const auto& Iterator : Summary->Values)
+	{
+		SummaryKeys.Add(Iterator.Key);
+		SummaryValues.Add(FString::SanitizeFloat(Iterator.Value->AsNumber()));
+	}
+
+	const FString SummaryCSV = FString::Join(SummaryKeys, TEXT(",")) + TEXT("\n") + FString::Join(SummaryValues, TEXT(",")) + TEXT("\n");
+
+	const FString BasePath = FPaths::Combine(OutputDirectory, ReportName);
+	if (!FFileHelper::SaveStringToFile(ReportJSON, *(BasePath + TEXT(".json"))) || !FFileHelper::SaveStringToFile(SummaryCSV, *(BasePath + TEXT(".csv"))) || !FFileHelper::SaveStringToFile(SamplesCSV, *(BasePath + TEXT("_Samples.csv"))))
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: Failed to write the reports to '%s'"), *FString(__func__), *OutputDirectory);
+		return;
+	}
+
+	UE_LOG(LogAzSpeech, Display, TEXT("%s: Reports written to '%s'"), *FString(__func__), *BasePath);
+}
+
+const FString UAzSpeechBenchmark::CreateRecognitionInput() const
+{
+	// Silent 16 bit mono wav: the mock backend and the test server don't process the audio content
+	const FString FilePath = FPaths::Combine(UAzSpeechHelper::GetAzSpeechLogsBaseDir(), TEXT("Benchmark"), TEXT("BenchmarkInput.wav"));
+	if (IFileManager::Get().FileSize(*FilePath) > 0)
+	{
+		return FilePath;
+	}
+
+	const uint32 DataSize = AzSpeech::Internal::BenchmarkInputSampleRate * 2 * AzSpeech::Internal::BenchmarkInputDurationMs / 1000;
+
+	TArray<uint8> WaveData;
+	AzSpeech::Wave::AppendHeader(WaveData, AzSpeech::Internal::BenchmarkInputSampleRate, DataSize);
+	WaveData.AddZeroed(DataSize);
+
+	if (!FFileHelper::SaveArrayToFile(WaveData, *FilePath))
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: Failed to write the recognition input '%s'"), *FString(__func__), *FilePath);
+		return FString();
+	}
+
+	return FilePath;
+}
+
+const FAzSpeechSettingsOptions UAzSpeechBenchmark::GetTaskOptions() const
+{
+	FAzSpeechSettingsOptions Output;
+	Output.Backend = Options.Backend;
+	Output.bUseEndpointPool = false;
+
+	if (!Options.Endpoint.IsEmpty())
+	{
+		Output.Backend = EAzSpeechBackend::Cloud;
+		Output.bUsePrivateEndpoint = true;
+		Output.PrivateEndpoint = *Options.Endpoint;
+
+		// The test server doesn't validate the subscription
+		if (AzSpeech::Internal::HasEmptyParam(Output.SubscriptionKey))
+		{
+			Output.SubscriptionKey = TEXT("AzSpeechBenchmark");
+		}
+	}
+
+	return Output;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs AzSpeechBenchmarkCommand(
+	TEXT("AzSpeech.Benchmark"),
+	TEXT("Run concurrent AzSpeech tasks and write JSON/CSV reports. Usage: AzSpeech.Benchmark [Synthesis=8] [Recognition=8] [Backend=Mock|Cloud] [Endpoint=ws://127.0.0.1:5000] [Timeout=60] [Output=Directory] [Exit] | AzSpeech.Benchmark Stop"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda(
+		[](const TArray<FString>& Args, UWorld* World)
+		{
+			if (Args.Contains(TEXT("Stop")))
+			{
+				if (UAzSpeechBenchmark* const Benchmark = UAzSpeechBenchmark::GetActiveBenchmark())
+				{
+					Benchmark->StopBenchmark();
+				}
+
+				return;
+			}
+
+			const FString Params = FString::Join(Args, TEXT(" "));
+
+			FAzSpeechBenchmarkOptions Options;
+			FParse::Value(*Params, TEXT("Synthesis="), Options.SynthesisTasks);
+			FParse::Value(*Params, TEXT("Recognition="), Options.RecognitionTasks);
+			FParse::Value(*Params, TEXT("Endpoint="), Options.Endpoint);
+			FParse::Value(*Params, TEXT("Timeout="), Options.TimeoutSeconds);
+			FParse::Value(*Params, TEXT("Output="), Options.OutputDirectory);
+			Options.bExitWhenFinished = Args.Contains(TEXT("Exit"));
+
+			if (FString Backend; FParse::Value(*Params, TEXT("Backend="), Backend))
+			{
+				Options.Backend = Backend.Equals(TEXT("Cloud"), ESearchCase::IgnoreCase) ? EAzSpeechBackend::Cloud : EAzSpeechBackend::Mock;
+			}
+
+			if (!UAzSpeechBenchmark::StartBenchmark(World, Options) && Options.bExitWhenFinished)
+			{
+				AzSpeech::Internal::RequestBenchmarkExit(1u);
+			}
+		}
+	)
+);
+#endif
@@ -0,0 +1,441 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Benchmark/AzSpeechMicrobenchmark.h"
+#include "AzSpeech/Tasks/RecognitionMapCheckAsync.h"
+#include "AzSpeech/Tasks/TextToAudioDataAsync.h"
+#include "AzSpeech/Tasks/SpeechToTextAsync.h"
+#include "AzSpeech/AzSpeechHelper.h"
+#include "AzSpeech/AzSpeechSettings.h"
+#include "AzSpeech/Audio/AzSpeechWaveHeader.h"
+#include "AzSpeechInternalFuncs.h"
+#include "LogAzSpeech.h"
+#include <HAL/MemoryBase.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Misc/DateTime.h>
+#include <Misc/Parse.h>
+#include <Sound/SoundWave.h>
+#include <atomic>
+
+namespace AzSpeech::Internal
+{
+	/* Allocations of the calling thread while it's counting - Each thread only writes its own counters */
+	thread_local bool bIsCountingAllocations = false;
+	thread_local uint64 CountedAllocations = 0u;
+	thread_local uint64 CountedAllocatedBytes = 0u;
+
+	/* Forwards to the engine allocator, counting the allocations of the threads that enabled the counting */
+	class FAzSpeechCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FAzSpeechCountingMalloc(FMalloc* InInnerMalloc) : InnerMalloc(InInnerMalloc)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Count_Internal(Count);
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			Count_Internal(Count);
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			InnerMalloc->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual void UpdateStats() override
+		{
+			InnerMalloc->UpdateStats();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return InnerMalloc->GetDescriptiveName();
+		}
+
+	private:
+		static void Count_Internal(const SIZE_T Count)
+		{
+			// Realloc to zero bytes is a free
+			if (bIsCountingAllocations && Count > 0u)
+			{
+				++CountedAllocations;
+				CountedAllocatedBytes += Count;
+			}
+		}
+
+		FMalloc* const InnerMalloc;
+	};
+
+	std::atomic<bool> bIsCountingMallocInstalled { false };
+
+	const FName MicrobenchmarkGroupName = TEXT("AzSpeechMicrobenchmark");
+
+	/* Test access to the protected functions of the tasks - Only used to reach the members, never instantiated */
+	struct FMapCheckTaskAccess : URecognitionMapCheckAsync
+	{
+		static int32 CheckResult(const URecognitionMapCheckAsync* const Task)
+		{
+			return (Task->*(&FMapCheckTaskAccess::CheckRecognitionResult))();
+		}
+	};
+
+	struct FSynthesizerTaskAccess : UAzSpeechSynthesizerTaskBase
+	{
+		/* Fill the task as the runnables do when a synthesis result is received */
+		static void UpdateSynthesis(UAzSpeechSynthesizerTaskBase* const Task, const FAzSpeechSynthesisResultData& Result)
+		{
+			(Task->*(&FSynthesizerTaskAccess::OnSynthesisUpdate))(Result);
+		}
+	};
+
+	struct FRecognizerTaskAccess : UAzSpeechRecognizerTaskBase
+	{
+		/* Fill the task as the runnables do when a recognition result is received */
+		static void UpdateRecognition(UAzSpeechRecognizerTaskBase* const Task, const FAzSpeechRecognitionResultData& Result)
+		{
+			(Task->*(&FRecognizerTaskAccess::OnRecognitionUpdated))(Result);
+		}
+	};
+
+	FString CreateAnimationFixture(const int32 FrameIndex)
+	{
+		// 30 frames with the 55 blend shapes of the Azure 3D viseme output
+		constexpr int32 FrameCount = 30;
+		constexpr int32 BlendShapeCount = 55;
+
+		FString Output = FString::Printf(TEXT("{\"FrameIndex\":%d,\"BlendShapes\":["), FrameIndex);
+		for (int32 Frame = 0; Frame < FrameCount; ++Frame)
+		{
+			Output += Frame > 0 ? TEXT(",[") : TEXT("[");
+			for (int32 Shape = 0; Shape < BlendShapeCount; ++Shape)
+			{
+				Output += FString::Printf(Shape > 0 ? TEXT(",%.3f") : TEXT("%.3f"), ((Frame * 7 + Shape * 13) % 1000) / 1000.f);
+			}
+			Output += TEXT("]");
+		}
+		Output += TEXT("]}");
+
+		return Output;
+	}
+
+	TArray<uint8> CreateWaveFixture(const int32 DurationMs)
+	{
+		constexpr uint32 SampleRate = 16000u;
+		const uint32 DataSize = SampleRate * 2u * DurationMs / 1000u;
+
+		TArray<uint8> Output;
+		Output.Reserve(AzSpeech::Wave::HeaderSize + DataSize);
+		AzSpeech::Wave::AppendHeader(Output, SampleRate, DataSize);
+
+		// Deterministic non silent content
+		for (uint32 Index = 0u; Index < DataSize; ++Index)
+		{
+			Output.Add(static_cast<uint8>((Index * 31u) & 0xFF));
+		}
+
+		return Output;
+	}
+
+	/* Keeps the results alive so the compiler doesn't remove the benchmarked calls */
+	volatile int64 MicrobenchmarkSink = 0;
+}
+
+void FAzSpeechMicrobenchmark::InstallAllocationCounter()
+{
+	if (AzSpeech::Internal::bIsCountingMallocInstalled.exchange(true))
+	{
+		return;
+	}
+
+	// Installed once and never removed: Threads still holding the engine allocator are fine, the proxy forwards to it
+	AzSpeech::Internal::FAzSpeechCountingMalloc* const CountingMalloc = new AzSpeech::Internal::FAzSpeechCountingMalloc(GMalloc);
+	FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), CountingMalloc);
+
+	UE_LOG(LogAzSpeech, Display, TEXT("%s: Microbenchmark allocation counter installed"), *FString(__func__));
+}
+
+TArray<FAzSpeechMicrobenchmarkResult> FAzSpeechMicrobenchmark::RunAll(const int32 Iterations)
+{
+	check(IsInGameThread());
+
+	if (!AzSpeech::Internal::bIsCountingMallocInstalled.load())
+	{
+		UE_LOG(LogAzSpeech, Warning, TEXT("%s: Allocations aren't counted - Start the application with -%s to install the allocation counter"), *FString(__func__), AllocationCounterParam);
+	}
+
+	const int32 ValidIterations = FMath::Max(1, Iterations);
+
+	// Cases creating objects or parsing large inputs run less iterations
+	const int32 HeavyIterations = FMath::Max(1, ValidIterations / 100);
+
+	TArray<FAzSpeechMicrobenchmarkResult> Output;
+	Output.Add(RunRecognitionMapCheck(ValidIterations, 10));
+	Output.Add(RunRecognitionMapCheck(HeavyIterations, 1000));
+	Output.Add(RunExtractAnimationData(ValidIterations));
+	Output.Add(RunExtractAnimationDataArray(HeavyIterations, 50));
+	Output.Add(RunConvertAudioDataToSoundWave(HeavyIterations));
+	Output.Add(RunGetAudioData(ValidIterations));
+	Output.Add(RunGetRecognizedString(ValidIterations));
+
+	for (const FAzSpeechMicrobenchmarkResult& Iterator : Output)
+	{
+		UE_LOG(LogAzSpeech, Display, TEXT("%s: %s: %.1f ns/op; %.2f allocs/op; %.1f bytes/op (%d iterations)"), *FString(__func__), *Iterator.Name, Iterator.NanosecondsPerOp, Iterator.AllocationsPerOp, Iterator.BytesPerOp, Iterator.Iterations);
+	}
+
+	return Output;
+}
+
+void FAzSpeechMicrobenchmark::WriteReports(const TArray<FAzSpeechMicrobenchmarkResult>& Results, const FString& OutputDirectory)
+{
+	const FString ValidOutputDirectory = OutputDirectory.IsEmpty() ? FPaths::Combine(UAzSpeechHelper::GetAzSpeechLogsBaseDir(), TEXT("Benchmark")) : OutputDirectory;
+	if (!UAzSpeechHelper::CreateNewDirectory(ValidOutputDirectory))
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: Failed to create directory '%s'"), *FString(__func__), *ValidOutputDirectory);
+		return;
+	}
+
+	FString ReportCSV = TEXT("case,iterations,ns_per_op,allocs_per_op,bytes_per_op\n");
+	FString ReportJSON = TEXT("[");
+
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		const FAzSpeechMicrobenchmarkResult& Iterator = Results[Index];
+		ReportCSV += FString::Printf(TEXT("%s,%d,%.3f,%.3f,%.3f\n"), *Iterator.Name, Iterator.Iterations, Iterator.NanosecondsPerOp, Iterator.AllocationsPerOp, Iterator.BytesPerOp);
+		ReportJSON += FString::Printf(TEXT("%s{\"case\":\"%s\",\"iterations\":%d,\"ns_per_op\":%.3f,\"allocs_per_op\":%.3f,\"bytes_per_op\":%.3f}"), Index > 0 ? TEXT(",") : TEXT(""), *Iterator.Name, Iterator.Iterations, Iterator.NanosecondsPerOp, Iterator.AllocationsPerOp, Iterator.BytesPerOp);
+	}
+
+	ReportJSON += TEXT("]");
+
+	const FString BasePath = FPaths::Combine(ValidOutputDirectory, FString::Printf(TEXT("AzSpeechMicrobenchmark_%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+	if (!FFileHelper::SaveStringToFile(ReportCSV, *(BasePath + TEXT(".csv"))) || !FFileHelper::SaveStringToFile(ReportJSON, *(BasePath + TEXT(".json"))))
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: Failed to write the reports to '%s'"), *FString(__func__), *ValidOutputDirectory);
+		return;
+	}
+
+	UE_LOG(LogAzSpeech, Display, TEXT("%s: Reports written to '%s'"), *FString(__func__), *BasePath);
+}
+
+FAzSpeechMicrobenchmarkResult FAzSpeechMicrobenchmark::RunCase(const FString& Name, const int32 Iterations, const TFunctionRef<void()> Function)
+{
+	// Warm up caches and lazily initialized statics before measuring
+	Function();
+
+	AzSpeech::Internal::CountedAllocations = 0u;
+	AzSpeech::Internal::CountedAllocatedBytes = 0u;
+	AzSpeech::Internal::bIsCountingAllocations = true;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Index = 0; Index < Iterations; ++Index)
+	{
+		Function();
+	}
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+
+	AzSpeech::Internal::bIsCountingAllocations = false;
+
+	FAzSpeechMicrobenchmarkResult Output;
+	Output.Name = Name;
+	Output.Iterations = Iterations;
+	Output.NanosecondsPerOp = FPlatformTime::ToMilliseconds64(EndCycles - StartCycles) * 1000000.0 / Iterations;
+
+	if (AzSpeech::Internal::bIsCountingMallocInstalled.load())
+	{
+		Output.AllocationsPerOp = static_cast<double>(AzSpeech::Internal::CountedAllocations) / Iterations;
+		Output.BytesPerOp = static_cast<double>(AzSpeech::Internal::CountedAllocatedBytes) / Iterations;
+	}
+	else
+	{
+		Output.AllocationsPerOp = -1.0;
+		Output.BytesPerOp = -1.0;
+	}
+
+	return Output;
+}
+
+FAzSpeechMicrobenchmarkResult FAzSpeechMicrobenchmark::RunRecognitionMapCheck(const int32 Iterations, const int32 MapSize)
+{
+	UAzSpeechSettings* const Settings = GetMutableDefault<UAzSpeechSettings>();
+
+	// Each entry has 4 triggers and 1 ignore key; The input matches the entry at 3/4 of the map
+	FAzSpeechRecognitionMap& BenchmarkMap = Settings->RecognitionMap.AddDefaulted_GetRef();
+	BenchmarkMap.GroupName = AzSpeech::Internal::MicrobenchmarkGroupName;
+	BenchmarkMap.GlobalRequirementKeys = { TEXT("please") };
+	BenchmarkMap.GlobalIgnoreKeys = { TEXT("cancel") };
+
+	for (int32 Index = 0; Index < MapSize; ++Index)
+	{
+		FAzSpeechRecognitionData& NewData = BenchmarkMap.Data.Emplace_GetRef(Index, 1 + Index % 3);
+		for (int32 Key = 0; Key < 4; ++Key)
+		{
+			NewData.TriggerKeys.Add(FString::Printf(TEXT("command%d_%d"), Index, Key));
+		}
+		NewData.IgnoreKeys.Add(FString::Printf(TEXT("ignore%d"), Index));
+	}
+
+	const int32 TargetIndex = MapSize * 3 / 4;
+	const FString InputString = FString::Printf(TEXT("Could you please run command%d_1 and command%d_3 right now?"), TargetIndex, TargetIndex);
+
+	URecognitionMapCheckAsync* const CheckTask = URecognitionMapCheckAsync::RecognitionMapCheckAsync(nullptr, InputString, AzSpeech::Internal::MicrobenchmarkGroupName, false);
+
+	FAzSpeechMicrobenchmarkResult Output = RunCase(FString::Printf(TEXT("CheckRecognitionResult_%d"), MapSize), Iterations,
+		[CheckTask]
+		{
+			AzSpeech::Internal::MicrobenchmarkSink = AzSpeech::Internal::MicrobenchmarkSink + AzSpeech::Internal::FMapCheckTaskAccess::CheckResult(CheckTask);
+		}
+	);
+
+	Settings->RecognitionMap.RemoveAll(
+		[](const FAzSpeechRecognitionMap& Iterator)
+		{
+			return Iterator.GroupName == AzSpeech::Internal::MicrobenchmarkGroupName;
+		}
+	);
+
+	CheckTask->SetReadyToDestroy();
+
+	return Output;
+}
+
+FAzSpeechMicrobenchmarkResult FAzSpeechMicrobenchmark::RunExtractAnimationData(const int32 Iterations)
+{
+	const FAzSpeechVisemeData VisemeData(1, 0, AzSpeech::Internal::CreateAnimationFixture(0));
+
+	return RunCase(TEXT("ExtractAnimationDataFromVisemeData"), Iterations,
+		[&VisemeData]
+		{
+			AzSpeech::Internal::MicrobenchmarkSink = AzSpeech::Internal::MicrobenchmarkSink + UAzSpeechHelper::ExtractAnimationDataFromVisemeData(VisemeData).BlendShapes.Num();
+		}
+	);
+}
+
+FAzSpeechMicrobenchmarkResult FAzSpeechMicrobenchmark::RunExtractAnimationDataArray(const int32 Iterations, const int32 VisemeCount)
+{
+	TArray<FAzSpeechVisemeData> VisemeDataArray;
+	for (int32 Index = 0; Index < VisemeCount; ++Index)
+	{
+		VisemeDataArray.Emplace(Index % 22, Index * 500, AzSpeech::Internal::CreateAnimationFixture(Index * 30));
+	}
+
+	return RunCase(FString::Printf(TEXT("ExtractAnimationDataFromVisemeDataArray_%d"), VisemeCount), Iterations,
+		[&VisemeDataArray]
+		{
+			AzSpeech::Internal::MicrobenchmarkSink = AzSpeech::Internal::MicrobenchmarkSink + UAzSpeechHelper::ExtractAnimationDataFromVisemeDataArray(VisemeDataArray).Num();
+		}
+	);
+}
+
+FAzSpeechMicrobenchmarkResult FAzSpeechMicrobenchmark::RunConvertAudioDataToSoundWave(const int32 Iterations)
+{
+	const TArray<uint8> AudioData = AzSpeech::Internal::CreateWaveFixture(5000);
+
+	// The transient sound waves are released by the next garbage collection
+	return RunCase(TEXT("ConvertAudioDataToSoundWave_5s"), Iterations,
+		[&AudioData]
+		{
+			AzSpeech::Internal::MicrobenchmarkSink = AzSpeech::Internal::MicrobenchmarkSink + (UAzSpeechHelper::ConvertAudioDataToSoundWave(AudioData) != nullptr);
+		}
+	);
+}
+
+FAzSpeechMicrobenchmarkResult FAzSpeechMicrobenchmark::RunGetAudioData(const int32 Iterations)
+{
+	const TArray<uint8> AudioData = AzSpeech::Internal::CreateWaveFixture(5000);
+
+	FAzSpeechSynthesisResultData SynthesisResult;
+	SynthesisResult.Reason = Microsoft::CognitiveServices::Speech::ResultReason::SynthesizingAudioCompleted;
+	SynthesisResult.AudioData = std::make_shared<std::vector<uint8_t>>(AudioData.GetData(), AudioData.GetData() + AudioData.Num());
+
+	UTextToAudioDataAsync* const SynthesisTask = NewObject<UTextToAudioDataAsync>();
+	AzSpeech::Internal::FSynthesizerTaskAccess::UpdateSynthesis(SynthesisTask, SynthesisResult);
+
+	FAzSpeechMicrobenchmarkResult Output = RunCase(TEXT("GetAudioData_5s"), Iterations,
+		[SynthesisTask]
+		{
+			AzSpeech::Internal::MicrobenchmarkSink = AzSpeech::Internal::MicrobenchmarkSink + SynthesisTask->GetAudioData().Num();
+		}
+	);
+
+	return Output;
+}
+
+FAzSpeechMicrobenchmarkResult FAzSpeechMicrobenchmark::RunGetRecognizedString(const int32 Iterations)
+{
+	// Mixed ASCII and multi-byte text, as received from the SDK in OnRecognitionUpdated
+	FAzSpeechRecognitionResultData RecognitionResult;
+	RecognitionResult.Reason = Microsoft::CognitiveServices::Speech::ResultReason::RecognizingSpeech;
+	RecognitionResult.Text = TCHAR_TO_UTF8(TEXT("Ol\u00E1, this is a recognized sentence with accents: a\u00E7\u00E3o, caf\u00E9, \u00FCber, na\u00EFve and some more words to convert"));
+
+	USpeechToTextAsync* const RecognitionTask = NewObject<USpeechToTextAsync>();
+	AzSpeech::Internal::FRecognizerTaskAccess::UpdateRecognition(RecognitionTask, RecognitionResult);
+
+	FAzSpeechMicrobenchmarkResult Output = RunCase(TEXT("GetRecognizedString_UTF8"), Iterations,
+		[RecognitionTask]
+		{
+			AzSpeech::Internal::MicrobenchmarkSink = AzSpeech::Internal::MicrobenchmarkSink + RecognitionTask->GetRecognizedString().Len();
+		}
+	);
+
+	return Output;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand AzSpeechMicrobenchmarkCommand(
+	TEXT("AzSpeech.Microbenchmark"),
+	TEXT("Run the AzSpeech microbenchmarks and write JSON/CSV reports. Usage: AzSpeech.Microbenchmark [Iterations=10000] [Output=Directory] - Allocations are only counted if the application was started with -AzSpeechCountAllocations"),
+	FConsoleCommandWithArgsDelegate::CreateLambda(
+		[](const TArray<FString>& Args)
+		{
+			const FString Params = FString::Join(Args, TEXT(" "));
+
+			int32 Iterations = 10000;
+			FParse::Value(*Params, TEXT("Iterations="), Iterations);
+
+			FString OutputDirectory;
+			FParse::Value(*Params, TEXT("Output="), OutputDirectory);
+
+			FAzSpeechMicrobenchmark::WriteReports(FAzSpeechMicrobenchmark::RunAll(Iterations), OutputDirectory);
+		}
+	)
+);
+#endif
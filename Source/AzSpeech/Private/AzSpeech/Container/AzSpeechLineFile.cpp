@@ -0,0 +1,304 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Container/AzSpeechLineFile.h"
+#include "AzSpeech/Animation/AzSpeechVisemeTimeline.h"
+#include "AzSpeechMemory.h"
+#include "AzSpeechTrace.h"
+#include "LogAzSpeech.h"
+#include <Async/MappedFileHandle.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/FileHelper.h>
+#include <Hash/CityHash.h>
+
+// The sections are read in place: The file layout must match the memory layout of the supported platforms
+static_assert(PLATFORM_LITTLE_ENDIAN, "AzSpeech line files are little endian");
+static_assert(sizeof(FAzSpeechLineFile::FHeader) == 24, "Unexpected line file header size");
+static_assert(sizeof(FAzSpeechLineFile::FSectionEntry) == 16, "Unexpected line file section entry size");
+static_assert(sizeof(FAzSpeechLineFile::FWordBoundary) == 24, "Unexpected line file word boundary size");
+static_assert(sizeof(FAzSpeechBlendShapeMatrix::FSegment) == 12, "Unexpected blend shape segment size");
+
+namespace AzSpeech::Internal
+{
+	void AppendLineSection(TArray<uint8>& OutData, TArray<FAzSpeechLineFile::FSectionEntry>& OutSections, const FAzSpeechLineFile::ESection Section, const void* const Data, const int64 Size)
+	{
+		OutData.AddZeroed(Align(OutData.Num(), FAzSpeechLineFile::SectionAlignment) - OutData.Num());
+
+		FAzSpeechLineFile::FSectionEntry& Entry = OutSections[static_cast<int32>(Section)];
+		Entry.Offset = OutData.Num();
+		Entry.Size = Size;
+
+		if (Size > 0)
+		{
+			OutData.Append(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+		}
+	}
+
+	template<typename ContainerType>
+	void AppendLineSection(TArray<uint8>& OutData, TArray<FAzSpeechLineFile::FSectionEntry>& OutSections, const FAzSpeechLineFile::ESection Section, const ContainerType& Elements)
+	{
+		AppendLineSection(OutData, OutSections, Section, Elements.GetData(), static_cast<int64>(Elements.Num()) * sizeof(*Elements.GetData()));
+	}
+}
+
+FAzSpeechLineFile::~FAzSpeechLineFile()
+{
+	Close();
+}
+
+const uint64 FAzSpeechLineFile::ComputeSourceHash(const FString& Text, const FName& VoiceName, const FName& LanguageID, const EAzSpeechSynthesisOutputFormat OutputFormat)
+{
+	const FTCHARToUTF8 TextUTF8(*Text);
+	const FTCHARToUTF8 VoiceUTF8(*VoiceName.ToString());
+	const FTCHARToUTF8 LanguageUTF8(*LanguageID.ToString());
+	const uint8 OutputFormatValue = static_cast<uint8>(OutputFormat);
+
+	uint64 Hash = CityHash64(TextUTF8.Get(), TextUTF8.Length());
+	Hash = CityHash64WithSeed(VoiceUTF8.Get(), VoiceUTF8.Length(), Hash);
+	Hash = CityHash64WithSeed(LanguageUTF8.Get(), LanguageUTF8.Length(), Hash);
+
+	return CityHash64WithSeed(reinterpret_cast<const char*>(&OutputFormatValue), sizeof(OutputFormatValue), Hash);
+}
+
+void FAzSpeechLineFile::Serialize(const FLineData& LineData, TArray<uint8>& OutData)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_LineFile_Serialize);
+	AZSPEECH_LLM_SCOPE(Caches);
+
+	const int32 NumChannels = LineData.BlendShapes ? LineData.BlendShapes->GetNumChannels() : 0;
+
+	// The matrix may contain rows of canceled segments: Only the rows referenced by the segments are written, packed in order
+	TArray<FAzSpeechBlendShapeMatrix::FSegment> Segments;
+	TArray<float> Values;
+	if (NumChannels > 0)
+	{
+		Segments.Reserve(LineData.BlendShapes->GetSegments().Num());
+		Values.Reserve(LineData.BlendShapes->GetNumRows() * NumChannels);
+
+		for (int32 SegmentIndex = 0; SegmentIndex < LineData.BlendShapes->GetSegments().Num(); ++SegmentIndex)
+		{
+			FAzSpeechBlendShapeMatrix::FSegment Segment = LineData.BlendShapes->GetSegments()[SegmentIndex];
+			if (Segment.NumRows <= 0)
+			{
+				continue;
+			}
+
+			const TArrayView<const float> SegmentValues = LineData.BlendShapes->GetSegmentValues(SegmentIndex);
+			Segment.FirstRow = Values.Num() / NumChannels;
+
+			Values.Append(SegmentValues.GetData(), SegmentValues.Num());
+			Segments.Add(Segment);
+		}
+	}
+
+	const int32 NumVisemes = FMath::Min(LineData.VisemeOffsets.Num(), LineData.VisemeIDs.Num());
+	const FTCHARToUTF16 Text(*LineData.Text, LineData.Text.Len());
+
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.MajorVersion = MajorVersion;
+	Header.MinorVersion = MinorVersion;
+	Header.HeaderSize = static_cast<uint16>(sizeof(FHeader));
+	Header.SourceHash = LineData.SourceHash;
+	Header.NumBlendShapeChannels = Segments.Num() > 0 ? NumChannels : 0;
+	Header.NumSections = static_cast<uint32>(ESection::Count);
+
+	TArray<FSectionEntry> SectionTable;
+	SectionTable.SetNum(static_cast<int32>(ESection::Count));
+
+	const int32 TableEnd = static_cast<int32>(sizeof(FHeader) + SectionTable.Num() * sizeof(FSectionEntry));
+	const int64 DataSize = LineData.AudioData.Num() + NumVisemes * (sizeof(int64) + sizeof(int32)) + Segments.Num() * sizeof(FAzSpeechBlendShapeMatrix::FSegment) + Values.Num() * sizeof(float) + LineData.WordBoundaries.Num() * sizeof(FWordBoundary) + Text.Length() * sizeof(UTF16CHAR);
+
+	OutData.Reset(static_cast<int32>(TableEnd + DataSize + SectionTable.Num() * SectionAlignment));
+	OutData.AddZeroed(TableEnd);
+
+	AzSpeech::Internal::AppendLineSection(OutData, SectionTable, ESection::Audio, LineData.AudioData);
+	AzSpeech::Internal::AppendLineSection(OutData, SectionTable, ESection::VisemeOffsets, LineData.VisemeOffsets.Slice(0, NumVisemes));
+	AzSpeech::Internal::AppendLineSection(OutData, SectionTable, ESection::VisemeIDs, LineData.VisemeIDs.Slice(0, NumVisemes));
+	AzSpeech::Internal::AppendLineSection(OutData, SectionTable, ESection::BlendShapeSegments, Segments);
+	AzSpeech::Internal::AppendLineSection(OutData, SectionTable, ESection::BlendShapeValues, Values);
+	AzSpeech::Internal::AppendLineSection(OutData, SectionTable, ESection::WordBoundaries, LineData.WordBoundaries);
+	AzSpeech::Internal::AppendLineSection(OutData, SectionTable, ESection::Text, Text.Get(), Text.Length() * sizeof(UTF16CHAR));
+
+	FMemory::Memcpy(OutData.GetData(), &Header, sizeof(FHeader));
+	FMemory::Memcpy(OutData.GetData() + sizeof(FHeader), SectionTable.GetData(), SectionTable.Num() * sizeof(FSectionEntry));
+}
+
+const bool FAzSpeechLineFile::Write(const FString& Filename, const FLineData& LineData)
+{
+	TArray<uint8> Data;
+	Serialize(LineData, Data);
+
+	if (!FFileHelper::SaveArrayToFile(Data, *Filename))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Failed to write file '%s'"), *FString(__func__), *Filename);
+		return false;
+	}
+
+	return true;
+}
+
+const bool FAzSpeechLineFile::Open(const FString& Filename)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_LineFile_Open);
+	AZSPEECH_LLM_SCOPE(Caches);
+
+	Close();
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (MappedFile.IsValid())
+	{
+		MappedRegion.Reset(MappedFile->MapRegion());
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		FileData = TArrayView<const uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+	}
+	else
+	{
+		MappedFile.Reset();
+
+		if (!FFileHelper::LoadFileToArray(LoadedData, *Filename, FILEREAD_Silent))
+		{
+			UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: Failed to open file '%s'"), *FString(__func__), *Filename);
+			return false;
+		}
+
+		FileData = LoadedData;
+	}
+
+	if (!Validate())
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: File '%s' is not a valid AzSpeech line file"), *FString(__func__), *Filename);
+
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void FAzSpeechLineFile::Close()
+{
+	FileData = TArrayView<const uint8>();
+	Sections.Reset();
+
+	// The region must be released before its file
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	LoadedData.Empty();
+}
+
+const bool FAzSpeechLineFile::IsOpen() const
+{
+	return FileData.Num() > 0;
+}
+
+const uint64 FAzSpeechLineFile::GetSourceHash() const
+{
+	return IsOpen() ? reinterpret_cast<const FHeader*>(FileData.GetData())->SourceHash : 0;
+}
+
+const int32 FAzSpeechLineFile::GetNumBlendShapeChannels() const
+{
+	return IsOpen() ? reinterpret_cast<const FHeader*>(FileData.GetData())->NumBlendShapeChannels : 0;
+}
+
+const TArrayView<const uint8> FAzSpeechLineFile::GetAudioData() const
+{
+	return GetSection<uint8>(ESection::Audio);
+}
+
+const TArrayView<const int64> FAzSpeechLineFile::GetVisemeOffsets() const
+{
+	return GetSection<int64>(ESection::VisemeOffsets);
+}
+
+const TArrayView<const int32> FAzSpeechLineFile::GetVisemeIDs() const
+{
+	return GetSection<int32>(ESection::VisemeIDs);
+}
+
+const TArrayView<const FAzSpeechBlendShapeMatrix::FSegment> FAzSpeechLineFile::GetBlendShapeSegments() const
+{
+	return GetSection<FAzSpeechBlendShapeMatrix::FSegment>(ESection::BlendShapeSegments);
+}
+
+const TArrayView<const float> FAzSpeechLineFile::GetBlendShapeValues() const
+{
+	return GetSection<float>(ESection::BlendShapeValues);
+}
+
+const TArrayView<const FAzSpeechLineFile::FWordBoundary> FAzSpeechLineFile::GetWordBoundaries() const
+{
+	return GetSection<FWordBoundary>(ESection::WordBoundaries);
+}
+
+const FString FAzSpeechLineFile::GetText() const
+{
+	const TArrayView<const UTF16CHAR> Text = GetSection<UTF16CHAR>(ESection::Text);
+	if (Text.Num() == 0)
+	{
+		return FString();
+	}
+
+	const FUTF16ToTCHAR Converter(Text.GetData(), Text.Num());
+	return FString(Converter.Length(), Converter.Get());
+}
+
+void FAzSpeechLineFile::LoadVisemeTimeline(FAzSpeechVisemeTimeline& OutTimeline) const
+{
+	OutTimeline.Load(GetVisemeOffsets(), GetVisemeIDs(), GetNumBlendShapeChannels(), GetBlendShapeSegments(), GetBlendShapeValues());
+}
+
+const bool FAzSpeechLineFile::Validate()
+{
+	if (FileData.Num() < static_cast<int32>(sizeof(FHeader)))
+	{
+		return false;
+	}
+
+	FHeader Header;
+	FMemory::Memcpy(&Header, FileData.GetData(), sizeof(FHeader));
+
+	// Newer minor versions only append sections and header fields, which are skipped using the sizes stored in the file
+	if (Header.Magic != Magic || Header.MajorVersion == 0 || Header.MajorVersion > MajorVersion || Header.HeaderSize < sizeof(FHeader) || Header.NumBlendShapeChannels < 0)
+	{
+		return false;
+	}
+
+	const int64 TableSize = static_cast<int64>(Header.NumSections) * sizeof(FSectionEntry);
+	if (Header.HeaderSize + TableSize > FileData.Num())
+	{
+		return false;
+	}
+
+	Sections.SetNumZeroed(static_cast<int32>(ESection::Count));
+	FMemory::Memcpy(Sections.GetData(), FileData.GetData() + Header.HeaderSize, FMath::Min<int64>(Header.NumSections, Sections.Num()) * sizeof(FSectionEntry));
+
+	for (const FSectionEntry& Iterator : Sections)
+	{
+		if (Iterator.Offset % SectionAlignment != 0 || Iterator.Offset > static_cast<uint64>(FileData.Num()) || Iterator.Size > static_cast<uint64>(FileData.Num()) - Iterator.Offset)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename ElementType>
+const TArrayView<const ElementType> FAzSpeechLineFile::GetSection(const ESection Section) const
+{
+	static_assert(alignof(ElementType) <= SectionAlignment, "The section alignment must satisfy the element alignment");
+
+	if (!IsOpen())
+	{
+		return TArrayView<const ElementType>();
+	}
+
+	const FSectionEntry& Entry = Sections[static_cast<int32>(Section)];
+	return TArrayView<const ElementType>(reinterpret_cast<const ElementType*>(FileData.GetData() + Entry.Offset), static_cast<int32>(Entry.Size / sizeof(ElementType)));
+}
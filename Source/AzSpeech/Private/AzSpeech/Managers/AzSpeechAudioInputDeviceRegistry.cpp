@@ -0,0 +1,186 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Managers/AzSpeechAudioInputDeviceRegistry.h"
+#include "LogAzSpeech.h"
+#include <AudioCaptureCore.h>
+#include <Runtime/Launch/Resources/Version.h>
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+#include <AudioDeviceNotificationSubsystem.h>
+#endif
+
+FAzSpeechAudioInputDeviceRegistry& FAzSpeechAudioInputDeviceRegistry::Get()
+{
+	static FAzSpeechAudioInputDeviceRegistry Instance;
+	return Instance;
+}
+
+const TArray<FAzSpeechAudioInputDeviceInfo> FAzSpeechAudioInputDeviceRegistry::GetDevices()
+{
+	FScopeLock Lock(&Mutex);
+	EnumerateDevicesIfDirty();
+
+	return Devices;
+}
+
+const bool FAzSpeechAudioInputDeviceRegistry::FindDevice(const FString& DeviceID, FAzSpeechAudioInputDeviceInfo& OutDeviceInfo)
+{
+	FScopeLock Lock(&Mutex);
+	EnumerateDevicesIfDirty();
+
+	if (const int32 DeviceIndex = FindDeviceIndex_Internal(DeviceID); Devices.IsValidIndex(DeviceIndex))
+	{
+		OutDeviceInfo = Devices[DeviceIndex];
+		return true;
+	}
+
+	return false;
+}
+
+const int32 FAzSpeechAudioInputDeviceRegistry::FindDeviceIndex(const FString& DeviceID)
+{
+	FScopeLock Lock(&Mutex);
+	EnumerateDevicesIfDirty();
+
+	return FindDeviceIndex_Internal(DeviceID);
+}
+
+void FAzSpeechAudioInputDeviceRegistry::Refresh()
+{
+	FScopeLock Lock(&Mutex);
+
+	bIsDirty = true;
+	EnumerateDevicesIfDirty();
+}
+
+void FAzSpeechAudioInputDeviceRegistry::Invalidate()
+{
+	FScopeLock Lock(&Mutex);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Audio input devices registry invalidated"), *FString(__func__));
+	bIsDirty = true;
+}
+
+void FAzSpeechAudioInputDeviceRegistry::Deinitialize()
+{
+	FScopeLock Lock(&Mutex);
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	if (!bBoundNotifications)
+	{
+		return;
+	}
+
+	if (UAudioDeviceNotificationSubsystem* const NotificationSubsystem = UAudioDeviceNotificationSubsystem::Get(); IsValid(NotificationSubsystem))
+	{
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Unbinding audio device change notifications"), *FString(__func__));
+
+		NotificationSubsystem->DeviceAddedNative.Remove(DeviceAddedHandle);
+		NotificationSubsystem->DeviceRemovedNative.Remove(DeviceRemovedHandle);
+		NotificationSubsystem->DeviceStateChangedNative.Remove(DeviceStateChangedHandle);
+		NotificationSubsystem->DefaultCaptureDeviceChangedNative.Remove(DefaultCaptureDeviceChangedHandle);
+	}
+
+	DeviceAddedHandle.Reset();
+	DeviceRemovedHandle.Reset();
+	DeviceStateChangedHandle.Reset();
+	DefaultCaptureDeviceChangedHandle.Reset();
+
+	bBoundNotifications = false;
+#endif
+
+	bIsDirty = true;
+}
+
+void FAzSpeechAudioInputDeviceRegistry::EnumerateDevicesIfDirty()
+{
+	BindDeviceNotifications();
+
+#if !(ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1))
+	// There's no device change notifications in this engine version: Enumerate again periodically to pick up connected/removed devices
+	if (FPlatformTime::Seconds() - LastEnumerationTime >= RefreshIntervalSeconds)
+	{
+		bIsDirty = true;
+	}
+#endif
+
+	if (!bIsDirty)
+	{
+		return;
+	}
+
+	LastEnumerationTime = FPlatformTime::Seconds();
+
+	Devices.Empty();
+	DeviceIndexMap.Empty();
+
+	TArray<Audio::FCaptureDeviceInfo> Internal_Devices;
+	if (Audio::FAudioCapture AudioCapture; AudioCapture.GetCaptureDevicesAvailable(Internal_Devices) <= 0)
+	{
+		// Keep the registry dirty: The devices will be enumerated again in the next request
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: There's no available audio input devices"), *FString(__func__));
+		return;
+	}
+
+	bIsDirty = false;
+
+	Devices.Reserve(Internal_Devices.Num());
+	DeviceIndexMap.Reserve(Internal_Devices.Num());
+
+	for (const Audio::FCaptureDeviceInfo& DeviceInfo : Internal_Devices)
+	{
+		const int32 DeviceIndex = Devices.Add(FAzSpeechAudioInputDeviceInfo(DeviceInfo.DeviceName, DeviceInfo.DeviceId));
+		DeviceIndexMap.Add(Devices[DeviceIndex].GetDeviceID(), DeviceIndex);
+
+		UE_LOG(LogAzSpeech_Debugging, Display, TEXT("%s: Found available audio input device: %s - %s"), *FString(__func__), *Devices[DeviceIndex].DeviceName, *Devices[DeviceIndex].GetAudioInputDeviceEndpointID());
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Registered %d audio input devices"), *FString(__func__), Devices.Num());
+}
+
+void FAzSpeechAudioInputDeviceRegistry::BindDeviceNotifications()
+{
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	if (bBoundNotifications)
+	{
+		return;
+	}
+
+	UAudioDeviceNotificationSubsystem* const NotificationSubsystem = UAudioDeviceNotificationSubsystem::Get();
+	if (!IsValid(NotificationSubsystem))
+	{
+		// Engine subsystems aren't available yet: Try again in the next request
+		return;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Binding audio device change notifications"), *FString(__func__));
+
+	DeviceAddedHandle = NotificationSubsystem->DeviceAddedNative.AddLambda([this]([[maybe_unused]] FString DeviceID) { Invalidate(); });
+	DeviceRemovedHandle = NotificationSubsystem->DeviceRemovedNative.AddLambda([this]([[maybe_unused]] FString DeviceID) { Invalidate(); });
+	DeviceStateChangedHandle = NotificationSubsystem->DeviceStateChangedNative.AddLambda([this]([[maybe_unused]] FString DeviceID, [[maybe_unused]] EAudioDeviceChangedState NewState) { Invalidate(); });
+	DefaultCaptureDeviceChangedHandle = NotificationSubsystem->DefaultCaptureDeviceChangedNative.AddLambda([this]([[maybe_unused]] EAudioDeviceChangedRole Role, [[maybe_unused]] FString DeviceID) { Invalidate(); });
+
+	bBoundNotifications = true;
+#endif
+}
+
+const int32 FAzSpeechAudioInputDeviceRegistry::FindDeviceIndex_Internal(const FString& DeviceID) const
+{
+	if (const int32* const DeviceIndex = DeviceIndexMap.Find(FAzSpeechAudioInputDeviceInfo(FString(), DeviceID).GetDeviceID()))
+	{
+		return *DeviceIndex;
+	}
+
+	// Fallback to partial matches to keep supporting IDs in other formats, like the endpoint ID
+	for (int32 Iterator = 0; Iterator < Devices.Num(); ++Iterator)
+	{
+		if (Devices[Iterator].GetDeviceID().Contains(DeviceID))
+		{
+			return Iterator;
+		}
+	}
+
+	return INDEX_NONE;
+}
@@ -0,0 +1,149 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Managers/AzSpeechCircuitBreaker.h"
+#include "LogAzSpeech.h"
+
+FCriticalSection FAzSpeechCircuitBreaker::Mutex;
+TMap<FString, FAzSpeechCircuitBreaker::FCircuit> FAzSpeechCircuitBreaker::Entries;
+
+const bool FAzSpeechCircuitBreaker::CanRequest(const FAzSpeechEndpoint& InEndpoint)
+{
+	FScopeLock Lock(&Mutex);
+
+	const FCircuit* const Circuit = Entries.Find(InEndpoint.GetEndpointID());
+	return !Circuit || CanRequest_Internal(*Circuit, FPlatformTime::Seconds());
+}
+
+const bool FAzSpeechCircuitBreaker::TryAcquire(const FAzSpeechEndpoint& InEndpoint, bool& bOutIsProbe)
+{
+	FScopeLock Lock(&Mutex);
+
+	bOutIsProbe = false;
+
+	FCircuit* const Circuit = Entries.Find(InEndpoint.GetEndpointID());
+	if (!Circuit || Circuit->State == EAzSpeechCircuitState::Closed)
+	{
+		return true;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (!CanRequest_Internal(*Circuit, CurrentTime))
+	{
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Probing endpoint %s"), *FString(__func__), *InEndpoint.GetEndpointID());
+
+	Circuit->State = EAzSpeechCircuitState::HalfOpen;
+	Circuit->StateTime = CurrentTime;
+	bOutIsProbe = true;
+
+	return true;
+}
+
+const bool FAzSpeechCircuitBreaker::CanRequestAny(const TArray<FAzSpeechEndpoint>& InEndpoints)
+{
+	FScopeLock Lock(&Mutex);
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (const FAzSpeechEndpoint& Iterator : InEndpoints)
+	{
+		if (!Iterator.IsValid())
+		{
+			continue;
+		}
+
+		if (const FCircuit* const Circuit = Entries.Find(Iterator.GetEndpointID()); !Circuit || CanRequest_Internal(*Circuit, CurrentTime))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FAzSpeechCircuitBreaker::ReportSuccess(const FAzSpeechEndpoint& InEndpoint)
+{
+	FScopeLock Lock(&Mutex);
+
+	FCircuit* const Circuit = Entries.Find(InEndpoint.GetEndpointID());
+	if (!Circuit)
+	{
+		return;
+	}
+
+	if (Circuit->State != EAzSpeechCircuitState::Closed)
+	{
+		UE_LOG(LogAzSpeech, Display, TEXT("%s: Endpoint %s recovered, closing circuit"), *FString(__func__), *InEndpoint.GetEndpointID());
+	}
+
+	Circuit->State = EAzSpeechCircuitState::Closed;
+	Circuit->ConsecutiveOutages = 0;
+}
+
+void FAzSpeechCircuitBreaker::ReportOutage(const FAzSpeechEndpoint& InEndpoint)
+{
+	FScopeLock Lock(&Mutex);
+
+	FCircuit& Circuit = Entries.FindOrAdd(InEndpoint.GetEndpointID());
+	++Circuit.ConsecutiveOutages;
+
+	// A failed probe opens the circuit again without waiting for the outage count
+	if (Circuit.State == EAzSpeechCircuitState::HalfOpen || (Circuit.State == EAzSpeechCircuitState::Closed && Circuit.ConsecutiveOutages >= OutagesToOpen))
+	{
+		UE_LOG(LogAzSpeech, Warning, TEXT("%s: Endpoint %s is unavailable after %d consecutive outage errors, opening circuit for %.0f seconds"), *FString(__func__), *InEndpoint.GetEndpointID(), Circuit.ConsecutiveOutages, OpenDurationSeconds);
+
+		Circuit.State = EAzSpeechCircuitState::Open;
+		Circuit.StateTime = FPlatformTime::Seconds();
+	}
+}
+
+void FAzSpeechCircuitBreaker::ReleaseProbe(const FAzSpeechEndpoint& InEndpoint)
+{
+	FScopeLock Lock(&Mutex);
+
+	FCircuit* const Circuit = Entries.Find(InEndpoint.GetEndpointID());
+	if (!Circuit || Circuit->State != EAzSpeechCircuitState::HalfOpen)
+	{
+		return;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Probe of endpoint %s stopped without result, releasing the probe"), *FString(__func__), *InEndpoint.GetEndpointID());
+
+	// Back to an open circuit whose open period already ended: The next task starts a new probe
+	Circuit->State = EAzSpeechCircuitState::Open;
+	Circuit->StateTime = FPlatformTime::Seconds() - OpenDurationSeconds;
+}
+
+const EAzSpeechCircuitState FAzSpeechCircuitBreaker::GetState(const FAzSpeechEndpoint& InEndpoint)
+{
+	FScopeLock Lock(&Mutex);
+
+	const FCircuit* const Circuit = Entries.Find(InEndpoint.GetEndpointID());
+	return Circuit ? Circuit->State : EAzSpeechCircuitState::Closed;
+}
+
+void FAzSpeechCircuitBreaker::Reset()
+{
+	FScopeLock Lock(&Mutex);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Closing circuit of %d endpoints"), *FString(__func__), Entries.Num());
+	Entries.Empty();
+}
+
+const bool FAzSpeechCircuitBreaker::CanRequest_Internal(const FCircuit& InCircuit, const double CurrentTime)
+{
+	switch (InCircuit.State)
+	{
+		case EAzSpeechCircuitState::Open:
+			return CurrentTime - InCircuit.StateTime >= OpenDurationSeconds;
+
+		case EAzSpeechCircuitState::HalfOpen:
+			return CurrentTime - InCircuit.StateTime >= ProbeTimeoutSeconds;
+
+		default:
+			return true;
+	}
+}
@@ -0,0 +1,84 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Managers/AzSpeechConfigCache.h"
+#include "AzSpeechMemory.h"
+#include "LogAzSpeech.h"
+
+FCriticalSection FAzSpeechConfigCache::Mutex;
+TMap<uint32, FAzSpeechConfigCache::FEntry> FAzSpeechConfigCache::Entries;
+
+const bool FAzSpeechBackendConfig::IsValid() const
+{
+	return Visit([](const auto& Config) { return Config != nullptr; });
+}
+
+const bool FAzSpeechBackendConfig::HasEmbeddedFallback() const
+{
+	return Backend == EAzSpeechBackend::Cloud && EmbeddedConfig != nullptr;
+}
+
+FAzSpeechBackendConfig FAzSpeechBackendConfig::GetEmbeddedFallback() const
+{
+	FAzSpeechBackendConfig Output;
+	Output.Backend = EAzSpeechBackend::Embedded;
+	Output.EmbeddedConfig = EmbeddedConfig;
+
+	return Output;
+}
+
+FAzSpeechBackendConfig FAzSpeechConfigCache::FindOrAdd(const FString& InKey, const TFunctionRef<FAzSpeechBackendConfig(bool&)>& InFactory)
+{
+	AZSPEECH_LLM_SCOPE(Caches);
+	FScopeLock Lock(&Mutex);
+
+	// The key contains the credentials: Only its hash is logged
+	const uint32 KeyHash = FCrc::StrCrc32(*InKey);
+
+	if (const FEntry* const CachedEntry = Entries.Find(KeyHash))
+	{
+		if (CachedEntry->Key.Equals(InKey, ESearchCase::CaseSensitive))
+		{
+			UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Using cached speech config with key hash %u"), *FString(__func__), KeyHash);
+			return CachedEntry->Config;
+		}
+
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Speech config key hash %u collides with a cached config of different options, replacing it"), *FString(__func__), KeyHash);
+	}
+
+	bool bCanCache = false;
+	FAzSpeechBackendConfig NewConfig = InFactory(bCanCache);
+
+	if (!NewConfig.IsValid() || !bCanCache)
+	{
+		return NewConfig;
+	}
+
+	if (Entries.Num() >= MaxEntries && !Entries.Contains(KeyHash))
+	{
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Speech config cache reached its limit of %d entries, clearing old entries"), *FString(__func__), MaxEntries);
+		Entries.Empty();
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Caching speech config with key hash %u"), *FString(__func__), KeyHash);
+	Entries.Add(KeyHash, FEntry{ InKey, NewConfig });
+	SET_DWORD_STAT(STAT_AzSpeech_CachedConfigs, Entries.Num());
+
+	return NewConfig;
+}
+
+void FAzSpeechConfigCache::Reset()
+{
+	FScopeLock Lock(&Mutex);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Clearing %d cached speech configs"), *FString(__func__), Entries.Num());
+	Entries.Empty();
+	SET_DWORD_STAT(STAT_AzSpeech_CachedConfigs, 0);
+}
+
+const int32 FAzSpeechConfigCache::Num()
+{
+	FScopeLock Lock(&Mutex);
+	return Entries.Num();
+}
@@ -0,0 +1,134 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Managers/AzSpeechEndpointManager.h"
+#include "AzSpeech/Managers/AzSpeechCircuitBreaker.h"
+#include "LogAzSpeech.h"
+
+FCriticalSection FAzSpeechEndpointManager::Mutex;
+TMap<FString, FAzSpeechEndpointHealth> FAzSpeechEndpointManager::Entries;
+
+const int32 FAzSpeechEndpointManager::SelectEndpoint(const TArray<FAzSpeechEndpoint>& InPool, const FString& InExcludedEndpointID)
+{
+	FScopeLock Lock(&Mutex);
+
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	int32 BestHealthy = INDEX_NONE;
+	float BestScore = TNumericLimits<float>::Max();
+
+	int32 OldestFailure = INDEX_NONE;
+	double OldestFailureTime = TNumericLimits<double>::Max();
+
+	for (int32 Iterator = 0; Iterator < InPool.Num(); ++Iterator)
+	{
+		if (!InPool[Iterator].IsValid())
+		{
+			continue;
+		}
+
+		const FString EndpointID = InPool[Iterator].GetEndpointID();
+		if (EndpointID == InExcludedEndpointID || !FAzSpeechCircuitBreaker::CanRequest(InPool[Iterator]))
+		{
+			continue;
+		}
+
+		const FAzSpeechEndpointHealth* const Health = Entries.Find(EndpointID);
+		if (!Health)
+		{
+			// Unknown endpoints are tried first so all endpoints get latency samples
+			BestHealthy = Iterator;
+			break;
+		}
+
+		if (IsHealthy(*Health, CurrentTime))
+		{
+			if (const float Score = GetScore(*Health); Score < BestScore)
+			{
+				BestScore = Score;
+				BestHealthy = Iterator;
+			}
+		}
+		else if (Health->LastFailureTime < OldestFailureTime)
+		{
+			OldestFailureTime = Health->LastFailureTime;
+			OldestFailure = Iterator;
+		}
+	}
+
+	if (BestHealthy != INDEX_NONE)
+	{
+		return BestHealthy;
+	}
+
+	if (OldestFailure != INDEX_NONE)
+	{
+		UE_LOG(LogAzSpeech_Internal, Warning, TEXT("%s: No healthy endpoint available, using %s"), *FString(__func__), *InPool[OldestFailure].GetEndpointID());
+	}
+
+	return OldestFailure;
+}
+
+void FAzSpeechEndpointManager::ReportSuccess(const FAzSpeechEndpoint& InEndpoint, const int32 LatencyMs)
+{
+	FScopeLock Lock(&Mutex);
+
+	FAzSpeechEndpointHealth& Health = Entries.FindOrAdd(InEndpoint.GetEndpointID());
+
+	const float Sample = static_cast<float>(FMath::Max(LatencyMs, 0));
+	Health.LatencyMs = Health.NumSuccesses == 0 ? Sample : FMath::Lerp(Health.LatencyMs, Sample, SmoothingFactor);
+	Health.ErrorRate = FMath::Lerp(Health.ErrorRate, 0.f, SmoothingFactor);
+	++Health.NumSuccesses;
+}
+
+void FAzSpeechEndpointManager::ReportFailure(const FAzSpeechEndpoint& InEndpoint)
+{
+	FScopeLock Lock(&Mutex);
+
+	FAzSpeechEndpointHealth& Health = Entries.FindOrAdd(InEndpoint.GetEndpointID());
+
+	Health.ErrorRate = FMath::Lerp(Health.ErrorRate, 1.f, SmoothingFactor);
+	Health.LastFailureTime = FPlatformTime::Seconds();
+	++Health.NumFailures;
+
+	if (Health.ErrorRate >= UnhealthyErrorRate)
+	{
+		UE_LOG(LogAzSpeech_Internal, Warning, TEXT("%s: Endpoint %s is unhealthy. Error rate: %.2f"), *FString(__func__), *InEndpoint.GetEndpointID(), Health.ErrorRate);
+	}
+}
+
+const FAzSpeechEndpointHealth FAzSpeechEndpointManager::GetHealth(const FAzSpeechEndpoint& InEndpoint)
+{
+	FScopeLock Lock(&Mutex);
+
+	FAzSpeechEndpointHealth Output;
+	if (const FAzSpeechEndpointHealth* const Health = Entries.Find(InEndpoint.GetEndpointID()))
+	{
+		Output = *Health;
+	}
+
+	Output.bIsHealthy = IsHealthy(Output, FPlatformTime::Seconds());
+	Output.CircuitState = FAzSpeechCircuitBreaker::GetState(InEndpoint);
+
+	return Output;
+}
+
+void FAzSpeechEndpointManager::Reset()
+{
+	FScopeLock Lock(&Mutex);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Clearing health of %d endpoints"), *FString(__func__), Entries.Num());
+	Entries.Empty();
+}
+
+const bool FAzSpeechEndpointManager::IsHealthy(const FAzSpeechEndpointHealth& InHealth, const double CurrentTime)
+{
+	// Unhealthy endpoints get a new chance after the cooldown
+	return InHealth.ErrorRate < UnhealthyErrorRate || CurrentTime - InHealth.LastFailureTime >= UnhealthyCooldownSeconds;
+}
+
+const float FAzSpeechEndpointManager::GetScore(const FAzSpeechEndpointHealth& InHealth)
+{
+	return InHealth.LatencyMs + InHealth.ErrorRate * ErrorRatePenaltyMs;
+}
@@ -0,0 +1,82 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Managers/AzSpeechHedgingManager.h"
+#include "AzSpeech/AzSpeechSettings.h"
+#include "LogAzSpeech.h"
+
+FCriticalSection FAzSpeechHedgingManager::Mutex;
+TMap<FString, FAzSpeechHedgingManager::FLatencyWindow> FAzSpeechHedgingManager::Entries;
+float FAzSpeechHedgingManager::Budget = 0.f;
+
+void FAzSpeechHedgingManager::AddLatencySample(const FAzSpeechEndpoint& InEndpoint, const int32 LatencyMs)
+{
+	if (LatencyMs <= 0)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&Mutex);
+
+	FLatencyWindow& Window = Entries.FindOrAdd(InEndpoint.GetEndpointID());
+	if (Window.Samples.Num() < MaxSamples)
+	{
+		Window.Samples.Add(LatencyMs);
+		return;
+	}
+
+	Window.Samples[Window.NextIndex] = LatencyMs;
+	Window.NextIndex = (Window.NextIndex + 1) % MaxSamples;
+}
+
+const int32 FAzSpeechHedgingManager::GetHedgeDelayMs(const FAzSpeechEndpoint& InEndpoint)
+{
+	TArray<int32> SortedSamples;
+	{
+		FScopeLock Lock(&Mutex);
+
+		const FLatencyWindow* const Window = Entries.Find(InEndpoint.GetEndpointID());
+		if (!Window || Window->Samples.Num() < MinSamples)
+		{
+			return INDEX_NONE;
+		}
+
+		SortedSamples = Window->Samples;
+	}
+
+	SortedSamples.Sort();
+
+	const int32 PercentileIndex = FMath::CeilToInt(LatencyPercentile * SortedSamples.Num()) - 1;
+	return SortedSamples[FMath::Clamp(PercentileIndex, 0, SortedSamples.Num() - 1)];
+}
+
+void FAzSpeechHedgingManager::AddRequest()
+{
+	FScopeLock Lock(&Mutex);
+
+	Budget = FMath::Min(Budget + FMath::Max(UAzSpeechSettings::Get()->MaxHedgeRatio, 0.f), MaxBudget);
+}
+
+const bool FAzSpeechHedgingManager::TryConsumeHedge()
+{
+	FScopeLock Lock(&Mutex);
+
+	if (Budget < 1.f)
+	{
+		return false;
+	}
+
+	Budget -= 1.f;
+	return true;
+}
+
+void FAzSpeechHedgingManager::Reset()
+{
+	FScopeLock Lock(&Mutex);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Clearing latency samples of %d endpoints"), *FString(__func__), Entries.Num());
+
+	Entries.Empty();
+	Budget = 0.f;
+}
@@ -0,0 +1,390 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Managers/AzSpeechMetricsRegistry.h"
+#include "AzSpeech/AzSpeechHelper.h"
+#include "AzSpeechMemory.h"
+#include "LogAzSpeech.h"
+#include <ProfilingDebugging/CsvProfiler.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+
+CSV_DEFINE_CATEGORY(AzSpeech, true);
+
+FAzSpeechLatencyHistogram::FAzSpeechLatencyHistogram() : Count(0u), SumMs(0u), MinMs(MAX_int32), MaxMs(0)
+{
+	for (std::atomic<uint64>& Iterator : Buckets)
+	{
+		Iterator.store(0u, std::memory_order_relaxed);
+	}
+}
+
+void FAzSpeechLatencyHistogram::RecordValue(const int32 ValueMs)
+{
+	const int32 ClampedValue = FMath::Clamp(ValueMs, 0, MaxValueMs);
+
+	Buckets[GetBucketIndex(ClampedValue)].fetch_add(1u, std::memory_order_relaxed);
+	Count.fetch_add(1u, std::memory_order_relaxed);
+	SumMs.fetch_add(static_cast<uint64>(ClampedValue), std::memory_order_relaxed);
+
+	int32 CurrentMin = MinMs.load(std::memory_order_relaxed);
+	while (ClampedValue < CurrentMin && !MinMs.compare_exchange_weak(CurrentMin, ClampedValue, std::memory_order_relaxed))
+	{
+	}
+
+	int32 CurrentMax = MaxMs.load(std::memory_order_relaxed);
+	while (ClampedValue > CurrentMax && !MaxMs.compare_exchange_weak(CurrentMax, ClampedValue, std::memory_order_relaxed))
+	{
+	}
+}
+
+const FAzSpeechLatencyHistogram::FSnapshot FAzSpeechLatencyHistogram::GetSnapshot() const
+{
+	FSnapshot Output;
+	Output.Buckets.SetNumUninitialized(BucketCount);
+
+	// Count is taken from the buckets to keep the percentiles consistent with a sample being recorded
+	for (int32 Index = 0; Index < BucketCount; ++Index)
+	{
+		Output.Buckets[Index] = Buckets[Index].load(std::memory_order_relaxed);
+		Output.Count += Output.Buckets[Index];
+	}
+
+	Output.SumMs = SumMs.load(std::memory_order_relaxed);
+	Output.MinMs = MinMs.load(std::memory_order_relaxed);
+	Output.MaxMs = MaxMs.load(std::memory_order_relaxed);
+
+	return Output;
+}
+
+const int32 FAzSpeechLatencyHistogram::GetBucketIndex(const int32 ValueMs)
+{
+	if (ValueMs < SubBucketCount)
+	{
+		return ValueMs;
+	}
+
+	// Keep the SubBucketBits - 1 bits below the most significant bit
+	const int32 Shift = static_cast<int32>(FMath::FloorLog2(static_cast<uint32>(ValueMs))) - (SubBucketBits - 1);
+	return SubBucketCount + (Shift - 1) * SubBucketHalfCount + ((ValueMs >> Shift) - SubBucketHalfCount);
+}
+
+const int32 FAzSpeechLatencyHistogram::GetBucketHighestValue(const int32 BucketIndex)
+{
+	if (BucketIndex < SubBucketCount)
+	{
+		return BucketIndex;
+	}
+
+	const int32 Shift = (BucketIndex - SubBucketCount) / SubBucketHalfCount + 1;
+	const int32 SubBucket = (BucketIndex - SubBucketCount) % SubBucketHalfCount + SubBucketHalfCount;
+
+	return ((SubBucket + 1) << Shift) - 1;
+}
+
+void FAzSpeechLatencyHistogram::FSnapshot::Merge(const FSnapshot& Other)
+{
+	if (Other.Count == 0u)
+	{
+		return;
+	}
+
+	if (Buckets.Num() != Other.Buckets.Num())
+	{
+		Buckets.SetNumZeroed(Other.Buckets.Num());
+	}
+
+	for (int32 Index = 0; Index < Other.Buckets.Num(); ++Index)
+	{
+		Buckets[Index] += Other.Buckets[Index];
+	}
+
+	Count += Other.Count;
+	SumMs += Other.SumMs;
+	MinMs = FMath::Min(MinMs, Other.MinMs);
+	MaxMs = FMath::Max(MaxMs, Other.MaxMs);
+}
+
+const int32 FAzSpeechLatencyHistogram::FSnapshot::GetValueAtPercentile(const float Percentile) const
+{
+	if (Count == 0u)
+	{
+		return 0;
+	}
+
+	const uint64 TargetCount = FMath::Max<uint64>(1u, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.f, 1.f) * static_cast<double>(Count))));
+
+	uint64 AccumulatedCount = 0u;
+	for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+	{
+		AccumulatedCount += Buckets[Index];
+		if (AccumulatedCount >= TargetCount)
+		{
+			return FMath::Min(GetBucketHighestValue(Index), MaxMs);
+		}
+	}
+
+	return MaxMs;
+}
+
+const FAzSpeechLatencyPercentiles FAzSpeechLatencyHistogram::FSnapshot::ToPercentiles() const
+{
+	FAzSpeechLatencyPercentiles Output;
+	if (Count == 0u)
+	{
+		return Output;
+	}
+
+	Output.Count = static_cast<int64>(Count);
+	Output.MinMs = MinMs;
+	Output.MaxMs = MaxMs;
+	Output.MeanMs = static_cast<float>(static_cast<double>(SumMs) / static_cast<double>(Count));
+	Output.P50Ms = GetValueAtPercentile(0.5f);
+	Output.P90Ms = GetValueAtPercentile(0.9f);
+	Output.P95Ms = GetValueAtPercentile(0.95f);
+	Output.P99Ms = GetValueAtPercentile(0.99f);
+
+	return Output;
+}
+
+FRWLock FAzSpeechMetricsRegistry::Lock;
+TMap<FAzSpeechMetricsRegistry::FKey, TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe>> FAzSpeechMetricsRegistry::Entries;
+
+void FAzSpeechMetricsRegistry::RecordSample(const EAzSpeechLatencyMetric Metric, const FName& Voice, const FString& EndpointID, const int32 ValueMs)
+{
+	// The SDK reports 0 when the property isn't available in the result
+	if (ValueMs <= 0)
+	{
+		return;
+	}
+
+	const FKey Key{ Metric, Voice, EndpointID.IsEmpty() ? FString(EmbeddedEndpointID) : EndpointID };
+
+	TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe> Histogram;
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe>* const Entry = Entries.Find(Key))
+		{
+			Histogram = *Entry;
+		}
+	}
+
+	if (!Histogram.IsValid())
+	{
+		AZSPEECH_LLM_SCOPE(Caches);
+		FWriteScopeLock WriteLock(Lock);
+
+		TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe>& Entry = Entries.FindOrAdd(Key);
+		if (!Entry.IsValid())
+		{
+			Entry = MakeShared<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe>();
+			INC_MEMORY_STAT_BY(STAT_AzSpeech_MetricsMemory, sizeof(FAzSpeechLatencyHistogram));
+		}
+
+		Histogram = Entry;
+	}
+
+	Histogram->RecordValue(ValueMs);
+
+	switch (Metric)
+	{
+		case EAzSpeechLatencyMetric::Connection:
+			CSV_CUSTOM_STAT(AzSpeech, ConnectionLatencyMs, ValueMs, ECsvCustomStatOp::Max);
+			break;
+
+		case EAzSpeechLatencyMetric::FirstByte:
+			CSV_CUSTOM_STAT(AzSpeech, FirstByteLatencyMs, ValueMs, ECsvCustomStatOp::Max);
+			break;
+
+		case EAzSpeechLatencyMetric::Finish:
+			CSV_CUSTOM_STAT(AzSpeech, FinishLatencyMs, ValueMs, ECsvCustomStatOp::Max);
+			break;
+
+		case EAzSpeechLatencyMetric::Network:
+			CSV_CUSTOM_STAT(AzSpeech, NetworkLatencyMs, ValueMs, ECsvCustomStatOp::Max);
+			break;
+
+		case EAzSpeechLatencyMetric::Service:
+			CSV_CUSTOM_STAT(AzSpeech, ServiceLatencyMs, ValueMs, ECsvCustomStatOp::Max);
+			break;
+
+		case EAzSpeechLatencyMetric::Recognition:
+			CSV_CUSTOM_STAT(AzSpeech, RecognitionLatencyMs, ValueMs, ECsvCustomStatOp::Max);
+			break;
+
+		default:
+			break;
+	}
+}
+
+const FAzSpeechLatencyHistogram::FSnapshot FAzSpeechMetricsRegistry::GetSnapshot(const EAzSpeechLatencyMetric Metric, const FName& Voice, const FString& EndpointID)
+{
+	TArray<TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe>> Histograms;
+	{
+		FReadScopeLock ReadLock(Lock);
+		for (const auto& Iterator : Entries)
+		{
+			if (Iterator.Key.Metric == Metric && (Voice.IsNone() || Iterator.Key.Voice == Voice) && (EndpointID.IsEmpty() || Iterator.Key.EndpointID == EndpointID))
+			{
+				Histograms.Add(Iterator.Value);
+			}
+		}
+	}
+
+	FAzSpeechLatencyHistogram::FSnapshot Output;
+	for (const TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe>& Iterator : Histograms)
+	{
+		Output.Merge(Iterator->GetSnapshot());
+	}
+
+	return Output;
+}
+
+const FAzSpeechLatencyPercentiles FAzSpeechMetricsRegistry::GetPercentiles(const EAzSpeechLatencyMetric Metric, const FName& Voice, const FString& EndpointID)
+{
+	return GetSnapshot(Metric, Voice, EndpointID).ToPercentiles();
+}
+
+const TArray<FAzSpeechMetricsRegistry::FKey> FAzSpeechMetricsRegistry::GetKeys()
+{
+	FReadScopeLock ReadLock(Lock);
+
+	TArray<FKey> Output;
+	Entries.GetKeys(Output);
+
+	return Output;
+}
+
+const FAzSpeechLatencyHistogram::FSnapshot FAzSpeechMetricsRegistry::GetKeySnapshot(const FKey& Key)
+{
+	TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe> Histogram;
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe>* const Entry = Entries.Find(Key))
+		{
+			Histogram = *Entry;
+		}
+	}
+
+	return Histogram.IsValid() ? Histogram->GetSnapshot() : FAzSpeechLatencyHistogram::FSnapshot();
+}
+
+void FAzSpeechMetricsRegistry::Dump(const FString& OutputDirectory)
+{
+	TArray<FKey> Keys = GetKeys();
+	Keys.Sort(
+		[](const FKey& Lhs, const FKey& Rhs)
+		{
+			if (Lhs.Metric != Rhs.Metric)
+			{
+				return Lhs.Metric < Rhs.Metric;
+			}
+
+			if (Lhs.Voice != Rhs.Voice)
+			{
+				return Lhs.Voice.LexicalLess(Rhs.Voice);
+			}
+
+			return Lhs.EndpointID < Rhs.EndpointID;
+		}
+	);
+
+	FString ReportCSV = TEXT("metric,voice,endpoint,count,min_ms,max_ms,mean_ms,p50_ms,p90_ms,p95_ms,p99_ms\n");
+
+	const auto AddRow = [&ReportCSV, FunctionName = FString(__func__)](const EAzSpeechLatencyMetric Metric, const FString& Voice, const FString& EndpointID, const FAzSpeechLatencyPercentiles& Percentiles)
+	{
+		UE_LOG(LogAzSpeech, Display, TEXT("%s: %s latency; Voice: %s; Endpoint: %s; Count: %lld; Min: %dms; Max: %dms; Mean: %.1fms; P50: %dms; P90: %dms; P95: %dms; P99: %dms"), *FunctionName, *GetMetricName(Metric), *Voice, *EndpointID, Percentiles.Count, Percentiles.MinMs, Percentiles.MaxMs, Percentiles.MeanMs, Percentiles.P50Ms, Percentiles.P90Ms, Percentiles.P95Ms, Percentiles.P99Ms);
+
+		ReportCSV += FString::Printf(TEXT("%s,%s,%s,%lld,%d,%d,%.3f,%d,%d,%d,%d\n"), *GetMetricName(Metric), *Voice, *EndpointID, Percentiles.Count, Percentiles.MinMs, Percentiles.MaxMs, Percentiles.MeanMs, Percentiles.P50Ms, Percentiles.P90Ms, Percentiles.P95Ms, Percentiles.P99Ms);
+	};
+
+	// Fleet-wide rows first, then the breakdown per voice and endpoint
+	const UEnum* const MetricEnum = StaticEnum<EAzSpeechLatencyMetric>();
+	for (int32 Index = 0; Index < MetricEnum->NumEnums() - 1; ++Index)
+	{
+		const EAzSpeechLatencyMetric Metric = static_cast<EAzSpeechLatencyMetric>(MetricEnum->GetValueByIndex(Index));
+		if (const FAzSpeechLatencyPercentiles Percentiles = GetPercentiles(Metric); Percentiles.Count > 0)
+		{
+			AddRow(Metric, TEXT("*"), TEXT("*"), Percentiles);
+		}
+	}
+
+	for (const FKey& Iterator : Keys)
+	{
+		AddRow(Iterator.Metric, Iterator.Voice.ToString(), Iterator.EndpointID, GetKeySnapshot(Iterator).ToPercentiles());
+	}
+
+	const FString ValidOutputDirectory = OutputDirectory.IsEmpty() ? FPaths::Combine(UAzSpeechHelper::GetAzSpeechLogsBaseDir(), TEXT("Metrics")) : OutputDirectory;
+	if (!UAzSpeechHelper::CreateNewDirectory(ValidOutputDirectory))
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: Failed to create directory '%s'"), *FString(__func__), *ValidOutputDirectory);
+		return;
+	}
+
+	const FString FilePath = FPaths::Combine(ValidOutputDirectory, FString::Printf(TEXT("AzSpeechLatency_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+	if (!FFileHelper::SaveStringToFile(ReportCSV, *FilePath))
+	{
+		UE_LOG(LogAzSpeech, Error, TEXT("%s: Failed to write the report to '%s'"), *FString(__func__), *FilePath);
+		return;
+	}
+
+	UE_LOG(LogAzSpeech, Display, TEXT("%s: Report written to '%s'"), *FString(__func__), *FilePath);
+}
+
+void FAzSpeechMetricsRegistry::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("%s: Clearing %d latency histograms"), *FString(__func__), Entries.Num());
+	DEC_MEMORY_STAT_BY(STAT_AzSpeech_MetricsMemory, Entries.Num() * sizeof(FAzSpeechLatencyHistogram));
+	Entries.Empty();
+}
+
+const FString FAzSpeechMetricsRegistry::GetMetricName(const EAzSpeechLatencyMetric Metric)
+{
+	switch (Metric)
+	{
+		case EAzSpeechLatencyMetric::Connection:
+			return TEXT("Connection");
+
+		case EAzSpeechLatencyMetric::FirstByte:
+			return TEXT("FirstByte");
+
+		case EAzSpeechLatencyMetric::Finish:
+			return TEXT("Finish");
+
+		case EAzSpeechLatencyMetric::Network:
+			return TEXT("Network");
+
+		case EAzSpeechLatencyMetric::Service:
+			return TEXT("Service");
+
+		case EAzSpeechLatencyMetric::Recognition:
+			return TEXT("Recognition");
+
+		default:
+			return TEXT("Unknown");
+	}
+}
+
+static FAutoConsoleCommand AzSpeechMetricsDumpCommand(
+	TEXT("AzSpeech.Metrics.Dump"),
+	TEXT("Log the latency percentiles of every metric, voice and endpoint and write them to a CSV file. Usage: AzSpeech.Metrics.Dump [Output=Directory]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda(
+		[](const TArray<FString>& Args)
+		{
+			FString OutputDirectory;
+			FParse::Value(*FString::Join(Args, TEXT(" ")), TEXT("Output="), OutputDirectory);
+
+			FAzSpeechMetricsRegistry::Dump(OutputDirectory);
+		}
+	)
+);
+
+static FAutoConsoleCommand AzSpeechMetricsResetCommand(
+	TEXT("AzSpeech.Metrics.Reset"),
+	TEXT("Clear the AzSpeech latency histograms"),
+	FConsoleCommandDelegate::CreateStatic(&FAzSpeechMetricsRegistry::Reset)
+);
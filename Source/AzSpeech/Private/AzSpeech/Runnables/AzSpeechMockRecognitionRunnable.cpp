@@ -0,0 +1,120 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Runnables/AzSpeechMockRecognitionRunnable.h"
+#include "AzSpeech/Tasks/Bases/AzSpeechRecognizerTaskBase.h"
+#include "LogAzSpeech.h"
+#include <Async/Async.h>
+
+FAzSpeechMockRecognitionRunnable::FAzSpeechMockRecognitionRunnable(UAzSpeechTaskBase* InOwningTask, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig) : Super(InOwningTask, InAudioConfig)
+{
+}
+
+uint32 FAzSpeechMockRecognitionRunnable::Run()
+{
+	AZSPEECH_LLM_SCOPE(Tasks);
+
+	if (Super::Run() == 0u)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Run returned 0"), *GetThreadName(), *FString(__func__));
+		return 0u;
+	}
+
+	UAzSpeechRecognizerTaskBase* const RecognizerTask = GetOwningRecognizerTask();
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
+	{
+		return 0u;
+	}
+
+	AZSPEECH_TRACE_TASK_EVENT(SDKStarted, RecognizerTask->GetUniqueID(), RecognizerTask->GetLastResultID().c_str());
+	RecognizerTask->RecordEvent(EAzSpeechLogEvent::SDKStarted);
+
+	const FAzSpeechMockBackendOptions& Options = GetMockOptions();
+
+	if (!WaitFor(GetJitteredLatency(Options.ConnectionLatencyMs)))
+	{
+		return 1u;
+	}
+
+	AzSpeech::Internal::AsyncGameThreadTask(
+		[RecognizerTask]
+		{
+			RecognizerTask->RecognitionStarted.Broadcast();
+		}
+	);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Recognition started."), *GetThreadName(), *FString(__func__));
+
+	FAzSpeechRecognitionResultData Result;
+	Result.ResultID = GenerateResultID();
+	Result.RecognitionLatencyMs = GetJitteredLatency(Options.RecognitionLatencyMs);
+
+	const Microsoft::CognitiveServices::Speech::CancellationErrorCode ErrorCode = RollError();
+	if (!WaitFor(Result.RecognitionLatencyMs))
+	{
+		return 1u;
+	}
+
+	if (ErrorCode != Microsoft::CognitiveServices::Speech::CancellationErrorCode::NoError)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Task failed. Reason: Canceled"), *GetThreadName(), *FString(__func__));
+		ProcessCancellationError(ErrorCode, "Error replayed by the mock backend");
+
+		AzSpeech::Internal::AsyncGameThreadTask(
+			[RecognizerTask]
+			{
+				RecognizerTask->RecognitionFailed.Broadcast();
+			}
+		);
+
+		StopAzSpeechRunnableTask();
+		return 1u;
+	}
+
+	TArray<FString> Words;
+	Options.RecognizedText.ParseIntoArrayWS(Words);
+
+	// Partial results grow word by word, like the Recognizing events of the Azure service
+	FString PartialText;
+	for (int32 Index = 0; Index < Words.Num(); ++Index)
+	{
+		if (Index > 0 && !WaitFor(GetJitteredLatency(Options.ChunkIntervalMs)))
+		{
+			return 1u;
+		}
+
+		PartialText += Index > 0 ? TEXT(" ") + Words[Index] : Words[Index];
+
+		FAzSpeechRecognitionResultData PartialResult = Result;
+		PartialResult.Reason = Microsoft::CognitiveServices::Speech::ResultReason::RecognizingSpeech;
+		PartialResult.Text = TCHAR_TO_UTF8(*PartialText);
+		PartialResult.DurationTicks = static_cast<uint64>(Index + 1) * static_cast<uint64>(FMath::Max(0, Options.ChunkIntervalMs)) * 10000u;
+
+		RecognizerTask->OnRecognitionUpdated(PartialResult);
+	}
+
+	Result.Reason = Microsoft::CognitiveServices::Speech::ResultReason::RecognizedSpeech;
+	Result.Text = TCHAR_TO_UTF8(*Options.RecognizedText);
+	Result.DurationTicks = static_cast<uint64>(Words.Num()) * static_cast<uint64>(FMath::Max(0, Options.ChunkIntervalMs)) * 10000u;
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Task completed. Reason: RecognizedSpeech"), *GetThreadName(), *FString(__func__));
+
+	// Replayed latencies aren't reported: They'd change the health and the metrics used by the cloud tasks
+	RecognizerTask->OnRecognitionUpdated(Result);
+	RecognizerTask->BroadcastFinalResult();
+
+	StopAzSpeechRunnableTask();
+
+	return 1u;
+}
+
+UAzSpeechRecognizerTaskBase* FAzSpeechMockRecognitionRunnable::GetOwningRecognizerTask() const
+{
+	if (!GetOwningTask())
+	{
+		return nullptr;
+	}
+
+	return Cast<UAzSpeechRecognizerTaskBase>(GetOwningTask());
+}
@@ -0,0 +1,242 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Runnables/AzSpeechMockSynthesisRunnable.h"
+#include "AzSpeech/Tasks/Bases/AzSpeechSynthesizerTaskBase.h"
+#include "AzSpeech/Audio/AzSpeechWaveHeader.h"
+#include "LogAzSpeech.h"
+#include <Async/Async.h>
+
+namespace AzSpeech::Internal
+{
+	constexpr int32 MockVisemeCount = 22;
+}
+
+FAzSpeechMockSynthesisRunnable::FAzSpeechMockSynthesisRunnable(UAzSpeechTaskBase* InOwningTask, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig) : Super(InOwningTask, InAudioConfig)
+{
+}
+
+uint32 FAzSpeechMockSynthesisRunnable::Run()
+{
+	AZSPEECH_LLM_SCOPE(Tasks);
+
+	if (Super::Run() == 0u)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Run returned 0"), *GetThreadName(), *FString(__func__));
+		return 0u;
+	}
+
+	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	{
+		return 0u;
+	}
+
+	AZSPEECH_TRACE_TASK_EVENT(SDKStarted, SynthesizerTask->GetUniqueID(), SynthesizerTask->GetLastResultID().c_str());
+	SynthesizerTask->RecordEvent(EAzSpeechLogEvent::SDKStarted);
+
+	UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Thread: %s; Function: %s; Message: Using text: %s"), *GetThreadName(), *FString(__func__), *SynthesizerTask->GetSynthesisText());
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FAzSpeechMockBackendOptions& Options = GetMockOptions();
+
+	FAzSpeechSynthesisResultData Result;
+	Result.ResultID = GenerateResultID();
+	Result.ConnectionLatencyMs = GetJitteredLatency(Options.ConnectionLatencyMs);
+	Result.ServiceLatencyMs = GetJitteredLatency(Options.FirstByteLatencyMs);
+	Result.FirstByteLatencyMs = Result.ConnectionLatencyMs + Result.ServiceLatencyMs;
+	Result.NetworkLatencyMs = Result.ConnectionLatencyMs;
+
+	if (!WaitFor(Result.ConnectionLatencyMs))
+	{
+		return 1u;
+	}
+
+	AzSpeech::Internal::AsyncGameThreadTask(
+		[SynthesizerTask]
+		{
+			SynthesizerTask->SynthesisStarted.Broadcast();
+		}
+	);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Synthesis started."), *GetThreadName(), *FString(__func__));
+
+	const Microsoft::CognitiveServices::Speech::CancellationErrorCode ErrorCode = RollError();
+	if (!WaitFor(Result.ServiceLatencyMs))
+	{
+		return 1u;
+	}
+
+	if (ErrorCode != Microsoft::CognitiveServices::Speech::CancellationErrorCode::NoError)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Task failed. Reason: Canceled"), *GetThreadName(), *FString(__func__));
+		ProcessCancellationError(ErrorCode, "Error replayed by the mock backend");
+
+		AzSpeech::Internal::AsyncGameThreadTask(
+			[SynthesizerTask]
+			{
+				SynthesizerTask->SynthesisFailed.Broadcast();
+			}
+		);
+
+		StopAzSpeechRunnableTask();
+		return 1u;
+	}
+
+	const std::shared_ptr<std::vector<uint8_t>> AudioData = GenerateAudioData();
+	const int32 BytesPerMs = GetSampleRate() * 2 / 1000;
+	const int32 ChunkSize = FMath::Max(1, Options.ChunkSizeBytes);
+
+	int32 NextVisemeOffsetMs = 0;
+
+	// Each chunk is sent after the visemes of its audio, like the Azure service does
+	for (int32 ChunkOffset = 0; ChunkOffset < static_cast<int32>(AudioData->size()); ChunkOffset += ChunkSize)
+	{
+		if (ChunkOffset > 0 && !WaitFor(GetJitteredLatency(Options.ChunkIntervalMs)))
+		{
+			return 1u;
+		}
+
+		const int32 ChunkEnd = FMath::Min(ChunkOffset + ChunkSize, static_cast<int32>(AudioData->size()));
+		NextVisemeOffsetMs = SendVisemes(NextVisemeOffsetMs, FMath::Max(0, ChunkEnd - AzSpeech::Wave::HeaderSize) / FMath::Max(1, BytesPerMs));
+
+		FAzSpeechSynthesisResultData ChunkResult = Result;
+		ChunkResult.Reason = Microsoft::CognitiveServices::Speech::ResultReason::SynthesizingAudio;
+		ChunkResult.AudioData = std::make_shared<std::vector<uint8_t>>(AudioData->begin() + ChunkOffset, AudioData->begin() + ChunkEnd);
+
+		SynthesizerTask->OnSynthesisUpdate(ChunkResult);
+	}
+
+	SendVisemes(NextVisemeOffsetMs, Options.AudioDurationMs + 1);
+	SendWordBoundaries();
+
+	Result.Reason = Microsoft::CognitiveServices::Speech::ResultReason::SynthesizingAudioCompleted;
+	Result.AudioData = AudioData;
+	Result.AudioDurationTicks = static_cast<int64>(Options.AudioDurationMs) * 10000;
+	Result.FinishLatencyMs = static_cast<int32>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Task completed. Reason: SynthesizingAudioCompleted"), *GetThreadName(), *FString(__func__));
+
+	// Replayed latencies aren't reported: They'd change the health and the metrics used by the cloud tasks
+	SynthesizerTask->OnSynthesisUpdate(Result);
+	SynthesizerTask->BroadcastFinalResult();
+
+	StopAzSpeechRunnableTask();
+
+	return 1u;
+}
+
+UAzSpeechSynthesizerTaskBase* FAzSpeechMockSynthesisRunnable::GetOwningSynthesizerTask() const
+{
+	if (!GetOwningTask())
+	{
+		return nullptr;
+	}
+
+	return Cast<UAzSpeechSynthesizerTaskBase>(GetOwningTask());
+}
+
+std::shared_ptr<std::vector<uint8_t>> FAzSpeechMockSynthesisRunnable::GenerateAudioData() const
+{
+	const uint32 SampleRate = static_cast<uint32>(GetSampleRate());
+	const uint32 DataSize = SampleRate * 2u * static_cast<uint32>(FMath::Max(0, GetMockOptions().AudioDurationMs)) / 1000u;
+
+	auto Output = std::make_shared<std::vector<uint8_t>>(AzSpeech::Wave::HeaderSize + DataSize, 0u);
+	std::vector<uint8_t>& Data = *Output;
+
+	// 16 bits mono PCM, the same layout of the Riff*16BitMonoPcm output formats
+	AzSpeech::Wave::WriteHeader(Data.data(), SampleRate, DataSize);
+
+	return Output;
+}
+
+const int32 FAzSpeechMockSynthesisRunnable::GetSampleRate() const
+{
+	if (UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask(); UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	{
+		switch (SynthesizerTask->GetTaskOptions().SpeechSynthesisOutputFormat)
+		{
+			case EAzSpeechSynthesisOutputFormat::Riff16Khz16BitMonoPcm:
+				return 16000;
+
+			case EAzSpeechSynthesisOutputFormat::Riff24Khz16BitMonoPcm:
+				return 24000;
+
+			case EAzSpeechSynthesisOutputFormat::Riff48Khz16BitMonoPcm:
+				return 48000;
+
+			case EAzSpeechSynthesisOutputFormat::Riff22050Hz16BitMonoPcm:
+				return 22050;
+
+			case EAzSpeechSynthesisOutputFormat::Riff44100Hz16BitMonoPcm:
+				return 44100;
+
+			default:
+				break;
+		}
+	}
+
+	return 16000;
+}
+
+const int32 FAzSpeechMockSynthesisRunnable::SendVisemes(const int32 InNextOffsetMs, const int32 InAudioOffsetMs)
+{
+	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
+	const int32 VisemeInterval = GetMockOptions().VisemeIntervalMs;
+
+	if (VisemeInterval <= 0 || !UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask) || !SynthesizerTask->GetTaskOptions().bEnableViseme)
+	{
+		return InNextOffsetMs;
+	}
+
+	int32 NextOffsetMs = InNextOffsetMs;
+	for (; NextOffsetMs < InAudioOffsetMs && NextOffsetMs <= GetMockOptions().AudioDurationMs; NextOffsetMs += VisemeInterval)
+	{
+		FAzSpeechVisemeData VisemeData;
+		VisemeData.VisemeID = RandomStream.RandHelper(AzSpeech::Internal::MockVisemeCount);
+		VisemeData.AudioOffsetMilliseconds = NextOffsetMs;
+
+		SynthesizerTask->OnVisemeReceived(VisemeData);
+	}
+
+	return NextOffsetMs;
+}
+
+void FAzSpeechMockSynthesisRunnable::SendWordBoundaries()
+{
+	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
+
+	// The words of SSML would include the markup: Only plain text is split
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask) || !SynthesizerTask->GetTaskOptions().bEnableWordBoundary || SynthesizerTask->IsSSMLBased())
+	{
+		return;
+	}
+
+	const FString& Text = SynthesizerTask->GetSynthesisText();
+	const int64 DurationMs = GetMockOptions().AudioDurationMs;
+
+	for (int32 Index = 0; Index < Text.Len();)
+	{
+		if (FChar::IsWhitespace(Text[Index]))
+		{
+			++Index;
+			continue;
+		}
+
+		const int32 WordStart = Index;
+		while (Index < Text.Len() && !FChar::IsWhitespace(Text[Index]))
+		{
+			++Index;
+		}
+
+		FAzSpeechWordBoundary WordBoundary;
+		WordBoundary.AudioOffsetMilliseconds = DurationMs * WordStart / Text.Len();
+		WordBoundary.DurationMilliseconds = static_cast<int32>(DurationMs * (Index - WordStart) / Text.Len());
+		WordBoundary.TextOffset = WordStart;
+		WordBoundary.TextLength = Index - WordStart;
+		WordBoundary.BoundaryType = static_cast<int32>(EAzSpeechBoundaryType::Word);
+
+		SynthesizerTask->OnWordBoundaryReceived(WordBoundary);
+	}
+}
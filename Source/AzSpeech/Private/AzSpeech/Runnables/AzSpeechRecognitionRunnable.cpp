@@ -19,6 +19,8 @@ FAzSpeechRecognitionRunnable::FAzSpeechRecognitionRunnable(UAzSpeechTaskBase* In
 
 uint32 FAzSpeechRecognitionRunnable::Run()
 {
+	AZSPEECH_LLM_SCOPE(Tasks);
+
 	if (Super::Run() == 0u)
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Run returned 0"), *GetThreadName(), *FString(__func__));
@@ -40,14 +42,24 @@ uint32 FAzSpeechRecognitionRunnable::Run()
 	const std::future<void> Future = SpeechRecognizer->StartContinuousRecognitionAsync();
 
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Starting recognition"), *GetThreadName(), *FString(__func__));
-	if (Future.wait_for(GetTaskTimeout()); Future.valid())
+	AZSPEECH_TRACE_TASK_EVENT(SDKStarted, RecognizerTask->GetUniqueID(), RecognizerTask->GetLastResultID().c_str());
+	RecognizerTask->RecordEvent(EAzSpeechLogEvent::SDKStarted);
+
+	if (IsFallbackPolicyEnabled())
+	{
+		// Don't block the run loop while the cloud is starting: the fallback policy is updated there
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Recognition started with embedded fallback."), *GetThreadName(), *FString(__func__));
+	}
+	else if (Future.wait_for(GetTaskTimeout()); Future.valid())
 	{
 		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Recognition started."), *GetThreadName(), *FString(__func__));
 	}
 	else
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Recognition failed to start."), *GetThreadName(), *FString(__func__));
-		AsyncTask(ENamedThreads::GameThread,
+		RecognizerTask->FlushEventLog(TEXT("Recognition failed to start"));
+
+		AzSpeech::Internal::AsyncGameThreadTask(
 			[RecognizerTask]
 			{
 				RecognizerTask->RecognitionFailed.Broadcast();
@@ -57,7 +69,7 @@ uint32 FAzSpeechRecognitionRunnable::Run()
 		return 0u;
 	}
 
-	AsyncTask(ENamedThreads::GameThread,
+	AzSpeech::Internal::AsyncGameThreadTask(
 		[RecognizerTask]
 		{
 			RecognizerTask->RecognitionStarted.Broadcast();
@@ -68,6 +80,7 @@ uint32 FAzSpeechRecognitionRunnable::Run()
 
 	while (!IsPendingStop())
 	{
+		UpdateFallbackPolicy();
 		FPlatformProcess::Sleep(SleepTime);
 	}
 
@@ -80,12 +93,16 @@ void FAzSpeechRecognitionRunnable::Exit()
 
 	Super::Stop();
 
-	if (Lock.IsLocked() && SpeechRecognizer)
+	if (Lock.IsLocked())
 	{
-		SpeechRecognizer->StopContinuousRecognitionAsync().wait_for(GetTaskTimeout());
+		StopAttempt(EAzSpeechAttempt::Primary);
+		StopAttempt(EAzSpeechAttempt::Fallback);
 	}
 
+	ReleaseEndpointProbe();
+
 	SpeechRecognizer = nullptr;
+	FallbackRecognizer = nullptr;
 }
 
 const bool FAzSpeechRecognitionRunnable::IsSpeechRecognizerValid() const
@@ -139,6 +156,38 @@ const bool FAzSpeechRecognitionRunnable::ApplySDKSettings(const std::shared_ptr<
 	return !AzSpeech::Internal::HasEmptyParam(UsedLang);
 }
 
+const bool FAzSpeechRecognitionRunnable::ApplyEmbeddedSDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig>& InEmbeddedConfig) const
+{
+	if (!Super::ApplyEmbeddedSDKSettings(InEmbeddedConfig))
+	{
+		return false;
+	}
+
+	UAzSpeechRecognizerTaskBase* const RecognizerTask = GetOwningRecognizerTask();
+	if (!IsValid(RecognizerTask))
+	{
+		return false;
+	}
+
+	InEmbeddedConfig->SetProperty(Microsoft::CognitiveServices::Speech::PropertyId::Speech_SegmentationSilenceTimeoutMs, TCHAR_TO_UTF8(*FString::FromInt(UAzSpeechSettings::Get()->SegmentationSilenceTimeoutMs)));
+	InEmbeddedConfig->SetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceConnection_InitialSilenceTimeoutMs, TCHAR_TO_UTF8(*FString::FromInt(UAzSpeechSettings::Get()->InitialSilenceTimeoutMs)));
+
+	InEmbeddedConfig->SetSpeechRecognitionOutputFormat(GetOutputFormat());
+
+	// The language of embedded recognition is defined by the model
+	const FName& ModelName = RecognizerTask->GetTaskOptions().EmbeddedRecognitionModel;
+	if (AzSpeech::Internal::HasEmptyParam(ModelName))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Invalid embedded recognition model"), *GetThreadName(), *FString(__func__));
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using embedded recognition model: %s"), *GetThreadName(), *FString(__func__), *ModelName.ToString());
+	InEmbeddedConfig->SetSpeechRecognitionModel(TCHAR_TO_UTF8(*ModelName.ToString()), TCHAR_TO_UTF8(*RecognizerTask->GetTaskOptions().EmbeddedModelKey.ToString()));
+
+	return true;
+}
+
 bool FAzSpeechRecognitionRunnable::InitializeAzureObject()
 {
 	if (!Super::InitializeAzureObject())
@@ -155,15 +204,91 @@ bool FAzSpeechRecognitionRunnable::InitializeAzureObject()
 
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating recognizer object"), *GetThreadName(), *FString(__func__));
 
-	const auto SpeechConfig = CreateSpeechConfig();
+	const FAzSpeechBackendConfig BackendConfig = GetCachedBackendConfig();
 
-	if (!SpeechConfig)
+	if (!BackendConfig.IsValid())
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Invalid speech config"), *GetThreadName(), *FString(__func__));
 		return false;
 	}
 
-	ApplySDKSettings(SpeechConfig);
+	SpeechRecognizer = CreateSpeechRecognizer(BackendConfig, GetAudioConfig());
+	if (!InsertPhraseList() || !ConnectRecognitionSignals(SpeechRecognizer, EAzSpeechAttempt::Primary))
+	{
+		return false;
+	}
+
+	InitializeFallbackPolicy(BackendConfig);
+
+	return true;
+}
+
+const FString FAzSpeechRecognitionRunnable::GetSpeechConfigKey() const
+{
+	return FString::Printf(TEXT("%s|Recognition|%d|%d"), *Super::GetSpeechConfigKey(), UAzSpeechSettings::Get()->SegmentationSilenceTimeoutMs, UAzSpeechSettings::Get()->InitialSilenceTimeoutMs);
+}
+
+bool FAzSpeechRecognitionRunnable::StartFallbackAttempt()
+{
+	UAzSpeechRecognizerTaskBase* const RecognizerTask = GetOwningRecognizerTask();
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
+	{
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating embedded fallback recognizer"), *GetThreadName(), *FString(__func__));
+
+	// The fallback needs its own audio input, replaying what the primary recognizer already received when possible
+	const auto FallbackAudioConfig = RecognizerTask->CreateFallbackAudioConfig();
+	if (!FallbackAudioConfig)
+	{
+		return false;
+	}
+
+	FallbackRecognizer = CreateSpeechRecognizer(GetFallbackConfig(), FallbackAudioConfig);
+	if (!FallbackRecognizer || !ConnectRecognitionSignals(FallbackRecognizer, EAzSpeechAttempt::Fallback))
+	{
+		return false;
+	}
+
+	FallbackFuture = FallbackRecognizer->StartContinuousRecognitionAsync();
+
+	return true;
+}
+
+void FAzSpeechRecognitionRunnable::StopAttempt(const EAzSpeechAttempt InAttempt)
+{
+	const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognizer>& Recognizer = InAttempt == EAzSpeechAttempt::Fallback ? FallbackRecognizer : SpeechRecognizer;
+	if (!Recognizer)
+	{
+		return;
+	}
+
+	Recognizer->StopContinuousRecognitionAsync().wait_for(GetTaskTimeout());
+}
+
+void FAzSpeechRecognitionRunnable::OnAllAttemptsFailed()
+{
+	if (UAzSpeechRecognizerTaskBase* const RecognizerTask = GetOwningRecognizerTask(); UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
+	{
+		AzSpeech::Internal::AsyncGameThreadTask(
+			[RecognizerTask]
+			{
+				RecognizerTask->RecognitionFailed.Broadcast();
+			}
+		);
+	}
+
+	Super::OnAllAttemptsFailed();
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognizer> FAzSpeechRecognitionRunnable::CreateSpeechRecognizer(const FAzSpeechBackendConfig& InBackendConfig, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig) const
+{
+	UAzSpeechRecognizerTaskBase* const RecognizerTask = GetOwningRecognizerTask();
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
+	{
+		return nullptr;
+	}
 
 	if (RecognizerTask->IsUsingAutoLanguage())
 	{
@@ -172,43 +297,49 @@ bool FAzSpeechRecognitionRunnable::InitializeAzureObject()
 		{
 			UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Task failed. Result: Invalid candidate languages"), *GetThreadName(), *FString(__func__));
 			
-			return false;
+			return nullptr;
 		}
 
-		SpeechRecognizer = Microsoft::CognitiveServices::Speech::SpeechRecognizer::FromConfig(SpeechConfig, Microsoft::CognitiveServices::Speech::AutoDetectSourceLanguageConfig::FromLanguages(Candidates), GetAudioConfig());
-	}
-	else
-	{
-		SpeechRecognizer = Microsoft::CognitiveServices::Speech::SpeechRecognizer::FromConfig(SpeechConfig, GetAudioConfig());
+		return InBackendConfig.Visit(
+			[&Candidates, &InAudioConfig](const auto& SpeechConfig)
+			{
+				return Microsoft::CognitiveServices::Speech::SpeechRecognizer::FromConfig(SpeechConfig, Microsoft::CognitiveServices::Speech::AutoDetectSourceLanguageConfig::FromLanguages(Candidates), InAudioConfig);
+			}
+		);
 	}
 
-	return InsertPhraseList() && ConnectRecognitionSignals();
+	return InBackendConfig.Visit(
+		[&InAudioConfig](const auto& SpeechConfig)
+		{
+			return Microsoft::CognitiveServices::Speech::SpeechRecognizer::FromConfig(SpeechConfig, InAudioConfig);
+		}
+	);
 }
 
-bool FAzSpeechRecognitionRunnable::ConnectRecognitionSignals()
+bool FAzSpeechRecognitionRunnable::ConnectRecognitionSignals(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognizer>& InRecognizer, const EAzSpeechAttempt InAttempt)
 {
 	UAzSpeechRecognizerTaskBase* const RecognizerTask = GetOwningRecognizerTask();
-	if (!IsSpeechRecognizerValid() || !UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
+	if (!InRecognizer || !UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
 	{
 		return false;
 	}
 
-	SpeechRecognizer->Recognizing.Connect(
-		[this, RecognizerTask](const Microsoft::CognitiveServices::Speech::SpeechRecognitionEventArgs& RecognitionEventArgs)
+	InRecognizer->Recognizing.Connect(
+		[this, RecognizerTask, InAttempt](const Microsoft::CognitiveServices::Speech::SpeechRecognitionEventArgs& RecognitionEventArgs)
 		{
 			if (!UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
 			{
 				StopAzSpeechRunnableTask();
 			}
-			else
+			else if (ClaimAttempt(InAttempt))
 			{
-				RecognizerTask->OnRecognitionUpdated(RecognitionEventArgs.Result);
+				RecognizerTask->OnRecognitionUpdated(FAzSpeechRecognitionResultData::FromResult(RecognitionEventArgs.Result));
 			}
 		}
 	);
 
-	SpeechRecognizer->Recognized.Connect(
-		[this, RecognizerTask](const Microsoft::CognitiveServices::Speech::SpeechRecognitionEventArgs& RecognitionEventArgs)
+	InRecognizer->Recognized.Connect(
+		[this, RecognizerTask, InAttempt](const Microsoft::CognitiveServices::Speech::SpeechRecognitionEventArgs& RecognitionEventArgs)
 		{
 			if (!UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
 			{
@@ -216,10 +347,15 @@ bool FAzSpeechRecognitionRunnable::ConnectRecognitionSignals()
 				return;
 			}
 
-			const bool bValidResult = ProcessRecognitionResult(RecognitionEventArgs.Result);
+			const bool bValidResult = ProcessRecognitionResult(RecognitionEventArgs.Result, InAttempt);
+			if ((!bValidResult && DeferAttemptFailure(InAttempt)) || !ClaimAttempt(InAttempt, bValidResult))
+			{
+				return;
+			}
+
 			if (!bValidResult)
 			{
-				AsyncTask(ENamedThreads::GameThread, 
+				AzSpeech::Internal::AsyncGameThreadTask(
 					[RecognizerTask] 
 					{
 						RecognizerTask->RecognitionFailed.Broadcast(); 
@@ -228,13 +364,42 @@ bool FAzSpeechRecognitionRunnable::ConnectRecognitionSignals()
 			}
 			else
 			{
-				RecognizerTask->OnRecognitionUpdated(RecognitionEventArgs.Result);
+				RecognizerTask->OnRecognitionUpdated(FAzSpeechRecognitionResultData::FromResult(RecognitionEventArgs.Result));
+
+				ReportEndpointSuccess(InAttempt, RecognizerTask->GetRecognitionLatency());
+
 				RecognizerTask->BroadcastFinalResult();
 			}
 
 			StopAzSpeechRunnableTask();
 		}
 	);
+
+	InRecognizer->Canceled.Connect(
+		[this, RecognizerTask, InAttempt](const Microsoft::CognitiveServices::Speech::SpeechRecognitionCanceledEventArgs& CanceledEventArgs)
+		{
+			if (!UAzSpeechTaskStatus::IsTaskStillValid(RecognizerTask))
+			{
+				StopAzSpeechRunnableTask();
+				return;
+			}
+
+			if (IsPendingStop() || CanceledEventArgs.Reason != Microsoft::CognitiveServices::Speech::CancellationReason::Error)
+			{
+				return;
+			}
+
+			ProcessCancellationError(CanceledEventArgs.ErrorCode, CanceledEventArgs.ErrorDetails, InAttempt);
+
+			// Cancellations only finish the task when the embedded fallback is used: it may still be able to answer
+			if (!IsFallbackPolicyEnabled() || DeferAttemptFailure(InAttempt) || !ClaimAttempt(InAttempt, false))
+			{
+				return;
+			}
+
+			OnAllAttemptsFailed();
+		}
+	);
 	
 	return true;
 }
@@ -272,8 +437,10 @@ bool FAzSpeechRecognitionRunnable::InsertPhraseList() const
 }
 
 
-bool FAzSpeechRecognitionRunnable::ProcessRecognitionResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognitionResult>& LastResult)
+bool FAzSpeechRecognitionRunnable::ProcessRecognitionResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognitionResult>& LastResult, const EAzSpeechAttempt InAttempt)
 {
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Runnable_ProcessRecognitionResult);
+
 	bool bOutput = true;
 
 	switch (LastResult->Reason)
@@ -307,7 +474,7 @@ bool FAzSpeechRecognitionRunnable::ProcessRecognitionResult(const std::shared_pt
 
 		if (CancellationDetails->Reason == Microsoft::CognitiveServices::Speech::CancellationReason::Error)
 		{
-			ProcessCancellationError(CancellationDetails->ErrorCode, CancellationDetails->ErrorDetails);
+			ProcessCancellationError(CancellationDetails->ErrorCode, CancellationDetails->ErrorDetails, InAttempt);
 		}
 	}
 
@@ -4,6 +4,7 @@
 
 #include "AzSpeech/Runnables/AzSpeechSynthesisRunnable.h"
 #include "AzSpeech/Tasks/Bases/AzSpeechSynthesizerTaskBase.h"
+#include "AzSpeech/Managers/AzSpeechHedgingManager.h"
 #include "LogAzSpeech.h"
 #include <Async/Async.h>
 #include <Misc/ScopeTryLock.h>
@@ -13,7 +14,9 @@ FAzSpeechSynthesisRunnable::FAzSpeechSynthesisRunnable(UAzSpeechTaskBase* InOwni
 }
 
 uint32 FAzSpeechSynthesisRunnable::Run()
-{	
+{
+	AZSPEECH_LLM_SCOPE(Tasks);
+
 	if (Super::Run() == 0u)
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Run returned 0"), *GetThreadName(), *FString(__func__));
@@ -34,26 +37,27 @@ uint32 FAzSpeechSynthesisRunnable::Run()
 
 	UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Thread: %s; Function: %s; Message: Using text: %s"), *GetThreadName(), *FString(__func__), *SynthesizerTask->GetSynthesisText());
 
-	const std::string SynthesisStr = TCHAR_TO_UTF8(*SynthesizerTask->GetSynthesisText());
-	std::future<std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>> Future;
-	if (SynthesizerTask->IsSSMLBased())
-	{
-		Future = SpeechSynthesizer->StartSpeakingSsmlAsync(SynthesisStr);
-	}
-	else
-	{
-		Future = SpeechSynthesizer->StartSpeakingTextAsync(SynthesisStr);
-	}
+	std::future<std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>> Future = StartSpeaking(SpeechSynthesizer);
 
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Starting synthesis."), *GetThreadName(), *FString(__func__));
-	if (Future.wait_for(GetTaskTimeout()); Future.valid())
+	AZSPEECH_TRACE_TASK_EVENT(SDKStarted, SynthesizerTask->GetUniqueID(), SynthesizerTask->GetLastResultID().c_str());
+	SynthesizerTask->RecordEvent(EAzSpeechLogEvent::SDKStarted);
+
+	if (IsFallbackPolicyEnabled())
+	{
+		// Don't block the run loop while the cloud is starting: the fallback policy is updated there
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Synthesis started with %s."), *GetThreadName(), *FString(__func__), IsHedgingEnabled() ? TEXT("request hedging") : TEXT("embedded fallback"));
+	}
+	else if (Future.wait_for(GetTaskTimeout()); Future.valid())
 	{
 		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Synthesis started."), *GetThreadName(), *FString(__func__));
 	}
 	else
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Synthesis failed to start."), *GetThreadName(), *FString(__func__));
-		AsyncTask(ENamedThreads::GameThread, 
+		SynthesizerTask->FlushEventLog(TEXT("Synthesis failed to start"));
+
+		AzSpeech::Internal::AsyncGameThreadTask(
 			[SynthesizerTask] 
 			{
 				SynthesizerTask->SynthesisFailed.Broadcast();
@@ -67,6 +71,7 @@ uint32 FAzSpeechSynthesisRunnable::Run()
 
 	while (!IsPendingStop())
 	{
+		UpdateFallbackPolicy();
 		FPlatformProcess::Sleep(SleepTime);
 	}
 
@@ -79,12 +84,14 @@ void FAzSpeechSynthesisRunnable::Exit()
 
 	Super::Exit();
 	
-	if (Lock.IsLocked() && SpeechSynthesizer)
+	if (Lock.IsLocked())
 	{
-		SpeechSynthesizer->StopSpeakingAsync().wait_for(GetTaskTimeout());
+		StopAttempt(EAzSpeechAttempt::Primary);
+		StopAttempt(EAzSpeechAttempt::Fallback);
 	}
 
 	SpeechSynthesizer = nullptr;
+	FallbackSynthesizer = nullptr;
 }
 
 const bool FAzSpeechSynthesisRunnable::IsSpeechSynthesizerValid() const
@@ -141,6 +148,36 @@ const bool FAzSpeechSynthesisRunnable::ApplySDKSettings(const std::shared_ptr<Mi
 	return true;
 }
 
+const bool FAzSpeechSynthesisRunnable::ApplyEmbeddedSDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig>& InEmbeddedConfig) const
+{
+	if (!Super::ApplyEmbeddedSDKSettings(InEmbeddedConfig))
+	{
+		return false;
+	}
+
+	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
+
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	{
+		return false;
+	}
+
+	InEmbeddedConfig->SetSpeechSynthesisOutputFormat(GetOutputFormat());
+
+	// The language of embedded synthesis is defined by the voice
+	const FName& VoiceName = SynthesizerTask->GetTaskOptions().EmbeddedSynthesisVoice;
+	if (AzSpeech::Internal::HasEmptyParam(VoiceName))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Invalid embedded synthesis voice"), *GetThreadName(), *FString(__func__));
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using embedded voice: %s"), *GetThreadName(), *FString(__func__), *VoiceName.ToString());
+	InEmbeddedConfig->SetSpeechSynthesisVoice(TCHAR_TO_UTF8(*VoiceName.ToString()), TCHAR_TO_UTF8(*SynthesizerTask->GetTaskOptions().EmbeddedModelKey.ToString()));
+
+	return true;
+}
+
 bool FAzSpeechSynthesisRunnable::InitializeAzureObject()
 {
 	if (!Super::InitializeAzureObject())
@@ -157,34 +194,122 @@ bool FAzSpeechSynthesisRunnable::InitializeAzureObject()
 	
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating synthesizer object"), *GetThreadName(), *FString(__func__));
 
-	const auto SpeechConfig = CreateSpeechConfig();
+	const FAzSpeechBackendConfig BackendConfig = GetCachedBackendConfig();
 
-	if (!SpeechConfig)
+	if (!BackendConfig.IsValid())
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Invalid speech config"), *GetThreadName(), *FString(__func__));	
 		return false;
 	}
-	
-	ApplySDKSettings(SpeechConfig);
 
-	if (SynthesizerTask->IsUsingAutoLanguage())
+	SpeechSynthesizer = CreateSpeechSynthesizer(BackendConfig, GetAudioConfig());
+	if (!ConnectVisemeSignal(SpeechSynthesizer, EAzSpeechAttempt::Primary) || !ConnectBoundarySignals(SpeechSynthesizer, EAzSpeechAttempt::Primary) || !ConnectSynthesisStartedSignal(SpeechSynthesizer) || !ConnectSynthesisUpdateSignals(SpeechSynthesizer, EAzSpeechAttempt::Primary))
+	{
+		return false;
+	}
+
+	InitializeFallbackPolicy(BackendConfig);
+	InitializeHedgingPolicy();
+
+	return true;
+}
+
+const FString FAzSpeechSynthesisRunnable::GetSpeechConfigKey() const
+{
+	return Super::GetSpeechConfigKey() + TEXT("|Synthesis");
+}
+
+bool FAzSpeechSynthesisRunnable::StartFallbackAttempt()
+{
+	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	{
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating %s synthesizer"), *GetThreadName(), *FString(__func__), IsHedgingEnabled() ? TEXT("hedged request") : TEXT("embedded fallback"));
+
+	// The task audio data comes from the synthesis result, so the fallback doesn't need to share the output of the primary synthesizer
+	const auto FallbackAudioConfig = Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromStreamOutput(Microsoft::CognitiveServices::Speech::Audio::AudioOutputStream::CreatePullStream());
+
+	FallbackSynthesizer = CreateSpeechSynthesizer(GetFallbackConfig(), FallbackAudioConfig);
+	if (!FallbackSynthesizer || !ConnectVisemeSignal(FallbackSynthesizer, EAzSpeechAttempt::Fallback) || !ConnectBoundarySignals(FallbackSynthesizer, EAzSpeechAttempt::Fallback) || !ConnectSynthesisStartedSignal(FallbackSynthesizer) || !ConnectSynthesisUpdateSignals(FallbackSynthesizer, EAzSpeechAttempt::Fallback))
+	{
+		return false;
+	}
+
+	FallbackFuture = StartSpeaking(FallbackSynthesizer);
+
+	return true;
+}
+
+void FAzSpeechSynthesisRunnable::StopAttempt(const EAzSpeechAttempt InAttempt)
+{
+	const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& Synthesizer = InAttempt == EAzSpeechAttempt::Fallback ? FallbackSynthesizer : SpeechSynthesizer;
+	if (!Synthesizer)
+	{
+		return;
+	}
+
+	Synthesizer->StopSpeakingAsync().wait_for(GetTaskTimeout());
+}
+
+void FAzSpeechSynthesisRunnable::OnAllAttemptsFailed()
+{
+	if (UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask(); UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	{
+		AzSpeech::Internal::AsyncGameThreadTask(
+			[SynthesizerTask]
+			{
+				SynthesizerTask->SynthesisFailed.Broadcast();
+			}
+		);
+	}
+
+	Super::OnAllAttemptsFailed();
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer> FAzSpeechSynthesisRunnable::CreateSpeechSynthesizer(const FAzSpeechBackendConfig& InBackendConfig, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig) const
+{
+	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	{
+		return nullptr;
+	}
+
+	// Auto language detection is only available in the cloud synthesis
+	if (SynthesizerTask->IsUsingAutoLanguage() && InBackendConfig.Backend == EAzSpeechBackend::Cloud)
 	{
 		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Initializing auto language detection"), *GetThreadName(), *FString(__func__));
 
-		SpeechSynthesizer = Microsoft::CognitiveServices::Speech::SpeechSynthesizer::FromConfig(SpeechConfig, Microsoft::CognitiveServices::Speech::AutoDetectSourceLanguageConfig::FromOpenRange(), GetAudioConfig());
+		return Microsoft::CognitiveServices::Speech::SpeechSynthesizer::FromConfig(InBackendConfig.CloudConfig, Microsoft::CognitiveServices::Speech::AutoDetectSourceLanguageConfig::FromOpenRange(), InAudioConfig);
 	}
-	else
+
+	return InBackendConfig.Visit(
+		[&InAudioConfig](const auto& SpeechConfig)
+		{
+			return Microsoft::CognitiveServices::Speech::SpeechSynthesizer::FromConfig(SpeechConfig, InAudioConfig);
+		}
+	);
+}
+
+std::future<std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>> FAzSpeechSynthesisRunnable::StartSpeaking(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer) const
+{
+	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
+
+	const std::string SynthesisStr = TCHAR_TO_UTF8(*SynthesizerTask->GetSynthesisText());
+	if (SynthesizerTask->IsSSMLBased())
 	{
-		SpeechSynthesizer = Microsoft::CognitiveServices::Speech::SpeechSynthesizer::FromConfig(SpeechConfig, GetAudioConfig());
+		return InSynthesizer->StartSpeakingSsmlAsync(SynthesisStr);
 	}
 
-	return ConnectVisemeSignal() && ConnectSynthesisStartedSignal() && ConnectSynthesisUpdateSignals();
+	return InSynthesizer->StartSpeakingTextAsync(SynthesisStr);
 }
 
-bool FAzSpeechSynthesisRunnable::ConnectVisemeSignal()
+bool FAzSpeechSynthesisRunnable::ConnectVisemeSignal(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer, const EAzSpeechAttempt InAttempt)
 {
 	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
-	if (!IsSpeechSynthesizerValid() || !UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	if (!InSynthesizer || !UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
 	{
 		return false;
 	}
@@ -196,8 +321,8 @@ bool FAzSpeechSynthesisRunnable::ConnectVisemeSignal()
 
 	bFilterVisemeData = SynthesizerTask->bIsSSMLBased && UAzSpeechSettings::Get()->bFilterVisemeFacialExpression && SynthesizerTask->SynthesisText.Contains("<mstts:viseme type=\"FacialExpression\"/>", ESearchCase::IgnoreCase);
 
-	SpeechSynthesizer->VisemeReceived.Connect(
-		[this, SynthesizerTask](const Microsoft::CognitiveServices::Speech::SpeechSynthesisVisemeEventArgs& VisemeEventArgs)
+	InSynthesizer->VisemeReceived.Connect(
+		[this, SynthesizerTask, InAttempt](const Microsoft::CognitiveServices::Speech::SpeechSynthesisVisemeEventArgs& VisemeEventArgs)
 		{
 			if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
 			{
@@ -205,6 +330,11 @@ bool FAzSpeechSynthesisRunnable::ConnectVisemeSignal()
 				return;
 			}
 
+			if (!ClaimAttempt(InAttempt))
+			{
+				return;
+			}
+
 			if (bFilterVisemeData && VisemeEventArgs.Animation.empty())
 			{
 				return;
@@ -222,23 +352,87 @@ bool FAzSpeechSynthesisRunnable::ConnectVisemeSignal()
 	return true;
 }
 
-bool FAzSpeechSynthesisRunnable::ConnectSynthesisStartedSignal()
+bool FAzSpeechSynthesisRunnable::ConnectBoundarySignals(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer, const EAzSpeechAttempt InAttempt)
 {
 	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
-	if (!IsSpeechSynthesizerValid() || !UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	if (!InSynthesizer || !UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	{
+		return false;
+	}
+
+	// The SDK only requests the word boundaries from the service if the signal is connected
+	if (SynthesizerTask->GetTaskOptions().bEnableWordBoundary)
+	{
+		InSynthesizer->WordBoundary.Connect(
+			[this, SynthesizerTask, InAttempt](const Microsoft::CognitiveServices::Speech::SpeechSynthesisWordBoundaryEventArgs& WordBoundaryEventArgs)
+			{
+				if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+				{
+					StopAzSpeechRunnableTask();
+					return;
+				}
+
+				if (!ClaimAttempt(InAttempt))
+				{
+					return;
+				}
+
+				// Only the offsets are stored: The word is a span of the synthesis text
+				FAzSpeechWordBoundary WordBoundary;
+				WordBoundary.AudioOffsetMilliseconds = WordBoundaryEventArgs.AudioOffset / 10000;
+				WordBoundary.DurationMilliseconds = static_cast<int32>(WordBoundaryEventArgs.Duration.count());
+				WordBoundary.TextOffset = static_cast<int32>(WordBoundaryEventArgs.TextOffset);
+				WordBoundary.TextLength = static_cast<int32>(WordBoundaryEventArgs.WordLength);
+				WordBoundary.BoundaryType = static_cast<int32>(WordBoundaryEventArgs.BoundaryType);
+
+				SynthesizerTask->OnWordBoundaryReceived(WordBoundary);
+			}
+		);
+	}
+
+	// Bookmarks are only sent for SSML with bookmark elements
+	if (SynthesizerTask->IsSSMLBased())
+	{
+		InSynthesizer->BookmarkReached.Connect(
+			[this, SynthesizerTask, InAttempt](const Microsoft::CognitiveServices::Speech::SpeechSynthesisBookmarkEventArgs& BookmarkEventArgs)
+			{
+				if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+				{
+					StopAzSpeechRunnableTask();
+					return;
+				}
+
+				if (!ClaimAttempt(InAttempt))
+				{
+					return;
+				}
+
+				SynthesizerTask->OnBookmarkReached(FAzSpeechBookmarkData(BookmarkEventArgs.AudioOffset / 10000, UTF8_TO_TCHAR(BookmarkEventArgs.Text.c_str())));
+			}
+		);
+	}
+
+	return true;
+}
+
+bool FAzSpeechSynthesisRunnable::ConnectSynthesisStartedSignal(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer)
+{
+	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
+	if (!InSynthesizer || !UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
 	{
 		return false;
 	}
 
 	const auto SynthesisStarted_Lambda = [this, SynthesizerTask]([[maybe_unused]] const Microsoft::CognitiveServices::Speech::SpeechSynthesisEventArgs& SynthesisEventArgs)
 	{
+		// Only the first attempt to start is broadcasted when the fallback policy is used
 		if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
 		{
 			StopAzSpeechRunnableTask();
 		}
-		else
+		else if (!bSynthesisStartedBroadcast.exchange(true))
 		{
-			AsyncTask(ENamedThreads::GameThread, 
+			AzSpeech::Internal::AsyncGameThreadTask(
 				[SynthesizerTask] 
 				{ 
 					SynthesizerTask->SynthesisStarted.Broadcast(); 
@@ -247,34 +441,34 @@ bool FAzSpeechSynthesisRunnable::ConnectSynthesisStartedSignal()
 		}
 	};
 
-	SpeechSynthesizer->SynthesisStarted.Connect(SynthesisStarted_Lambda);
+	InSynthesizer->SynthesisStarted.Connect(SynthesisStarted_Lambda);
 
 	return true;
 }
 
-bool FAzSpeechSynthesisRunnable::ConnectSynthesisUpdateSignals()
+bool FAzSpeechSynthesisRunnable::ConnectSynthesisUpdateSignals(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer, const EAzSpeechAttempt InAttempt)
 {
 	UAzSpeechSynthesizerTaskBase* const SynthesizerTask = GetOwningSynthesizerTask();
-	if (!IsSpeechSynthesizerValid() || !UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
+	if (!InSynthesizer || !UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
 	{
 		return false;
 	}
 
-	SpeechSynthesizer->Synthesizing.Connect(
-		[this, SynthesizerTask](const Microsoft::CognitiveServices::Speech::SpeechSynthesisEventArgs& SynthesisEventArgs)
+	InSynthesizer->Synthesizing.Connect(
+		[this, SynthesizerTask, InAttempt](const Microsoft::CognitiveServices::Speech::SpeechSynthesisEventArgs& SynthesisEventArgs)
 		{
 			if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
 			{
 				StopAzSpeechRunnableTask();
 			}
-			else
+			else if (ClaimAttempt(InAttempt))
 			{
-				SynthesizerTask->OnSynthesisUpdate(SynthesisEventArgs.Result);
+				SynthesizerTask->OnSynthesisUpdate(FAzSpeechSynthesisResultData::FromResult(SynthesisEventArgs.Result));
 			}
 		}
 	);
 
-	const auto TaskResultReach_Lambda = [this, SynthesizerTask](const Microsoft::CognitiveServices::Speech::SpeechSynthesisEventArgs& SynthesisEventArgs)
+	const auto TaskResultReach_Lambda = [this, SynthesizerTask, InAttempt](const Microsoft::CognitiveServices::Speech::SpeechSynthesisEventArgs& SynthesisEventArgs)
 	{
 		if (!UAzSpeechTaskStatus::IsTaskStillValid(SynthesizerTask))
 		{
@@ -282,10 +476,15 @@ bool FAzSpeechSynthesisRunnable::ConnectSynthesisUpdateSignals()
 			return;
 		}
 		
-		const bool bValidResult = ProcessSynthesisResult(SynthesisEventArgs.Result);
+		const bool bValidResult = ProcessSynthesisResult(SynthesisEventArgs.Result, InAttempt);
+		if ((!bValidResult && DeferAttemptFailure(InAttempt)) || !ClaimAttempt(InAttempt, bValidResult))
+		{
+			return;
+		}
+
 		if (!bValidResult)
 		{
-			AsyncTask(ENamedThreads::GameThread, 
+			AzSpeech::Internal::AsyncGameThreadTask(
 				[SynthesizerTask] 
 				{
 					SynthesizerTask->SynthesisFailed.Broadcast(); 
@@ -294,21 +493,31 @@ bool FAzSpeechSynthesisRunnable::ConnectSynthesisUpdateSignals()
 		}
 		else
 		{
-			SynthesizerTask->OnSynthesisUpdate(SynthesisEventArgs.Result);
+			SynthesizerTask->OnSynthesisUpdate(FAzSpeechSynthesisResultData::FromResult(SynthesisEventArgs.Result));
+
+			ReportEndpointSuccess(InAttempt, SynthesizerTask->GetFirstByteLatency());
+
+			if (const FAzSpeechEndpoint* const AttemptEndpoint = GetAttemptEndpoint(InAttempt))
+			{
+				FAzSpeechHedgingManager::AddLatencySample(*AttemptEndpoint, SynthesizerTask->GetFirstByteLatency());
+			}
+
 			SynthesizerTask->BroadcastFinalResult();
 		}
 
 		StopAzSpeechRunnableTask();
 	};
 
-	SpeechSynthesizer->SynthesisCanceled.Connect(TaskResultReach_Lambda);
-	SpeechSynthesizer->SynthesisCompleted.Connect(TaskResultReach_Lambda);
+	InSynthesizer->SynthesisCanceled.Connect(TaskResultReach_Lambda);
+	InSynthesizer->SynthesisCompleted.Connect(TaskResultReach_Lambda);
 	
 	return true;
 }
 
-bool FAzSpeechSynthesisRunnable::ProcessSynthesisResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>& LastResult)
+bool FAzSpeechSynthesisRunnable::ProcessSynthesisResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>& LastResult, const EAzSpeechAttempt InAttempt)
 {
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Runnable_ProcessSynthesisResult);
+
 	bool bOutput = true;
 
 	switch (LastResult->Reason)
@@ -341,7 +550,7 @@ bool FAzSpeechSynthesisRunnable::ProcessSynthesisResult(const std::shared_ptr<Mi
 
 		if (CancellationDetails->Reason == Microsoft::CognitiveServices::Speech::CancellationReason::Error)
 		{
-			ProcessCancellationError(CancellationDetails->ErrorCode, CancellationDetails->ErrorDetails);
+			ProcessCancellationError(CancellationDetails->ErrorCode, CancellationDetails->ErrorDetails, InAttempt);
 		}		
 	}
 
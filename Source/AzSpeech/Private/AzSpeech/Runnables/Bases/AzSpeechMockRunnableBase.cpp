@@ -0,0 +1,101 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Runnables/Bases/AzSpeechMockRunnableBase.h"
+#include "AzSpeech/AzSpeechSettings.h"
+#include "LogAzSpeech.h"
+
+std::atomic<int32> FAzSpeechMockRunnableBase::TaskSequence { 0 };
+
+FAzSpeechMockRunnableBase::FAzSpeechMockRunnableBase(UAzSpeechTaskBase* InOwningTask, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig) : Super(InOwningTask, InAudioConfig), MockOptions(UAzSpeechSettings::Get()->MockBackend)
+{
+}
+
+bool FAzSpeechMockRunnableBase::InitializeAzureObject()
+{
+	if (!Super::InitializeAzureObject())
+	{
+		return false;
+	}
+
+	const int32 Sequence = TaskSequence.fetch_add(1);
+	RandomStream.Initialize(static_cast<int32>(HashCombine(GetTypeHash(MockOptions.RandomSeed), GetTypeHash(Sequence))));
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using mock backend with seed %d and sequence %d"), *GetThreadName(), *FString(__func__), MockOptions.RandomSeed, Sequence);
+
+	return true;
+}
+
+const FAzSpeechMockBackendOptions& FAzSpeechMockRunnableBase::GetMockOptions() const
+{
+	return MockOptions;
+}
+
+const bool FAzSpeechMockRunnableBase::WaitFor(const int32 InMilliseconds) const
+{
+	const double EndTime = FPlatformTime::Seconds() + FMath::Max(0, InMilliseconds) / 1000.0;
+	const float SleepTime = GetThreadUpdateInterval();
+
+	while (!IsPendingStop())
+	{
+		const double RemainingTime = EndTime - FPlatformTime::Seconds();
+		if (RemainingTime <= 0.0)
+		{
+			return true;
+		}
+
+		FPlatformProcess::Sleep(FMath::Min(SleepTime, static_cast<float>(RemainingTime)));
+	}
+
+	return false;
+}
+
+const int32 FAzSpeechMockRunnableBase::GetJitteredLatency(const int32 InLatencyMs)
+{
+	if (MockOptions.LatencyJitterMs <= 0)
+	{
+		return FMath::Max(0, InLatencyMs);
+	}
+
+	return FMath::Max(0, InLatencyMs + RandomStream.RandRange(-MockOptions.LatencyJitterMs, MockOptions.LatencyJitterMs));
+}
+
+const Microsoft::CognitiveServices::Speech::CancellationErrorCode FAzSpeechMockRunnableBase::RollError()
+{
+	// Always consume the stream so the latencies don't depend on the error rate
+	const float Roll = RandomStream.GetFraction();
+
+	if (MockOptions.ErrorCode == EAzSpeechMockError::None || Roll >= MockOptions.ErrorRate)
+	{
+		return Microsoft::CognitiveServices::Speech::CancellationErrorCode::NoError;
+	}
+
+	switch (MockOptions.ErrorCode)
+	{
+		case EAzSpeechMockError::ConnectionFailure:
+			return Microsoft::CognitiveServices::Speech::CancellationErrorCode::ConnectionFailure;
+
+		case EAzSpeechMockError::ServiceUnavailable:
+			return Microsoft::CognitiveServices::Speech::CancellationErrorCode::ServiceUnavailable;
+
+		case EAzSpeechMockError::ServiceTimeout:
+			return Microsoft::CognitiveServices::Speech::CancellationErrorCode::ServiceTimeout;
+
+		case EAzSpeechMockError::TooManyRequests:
+			return Microsoft::CognitiveServices::Speech::CancellationErrorCode::TooManyRequests;
+
+		case EAzSpeechMockError::AuthenticationFailure:
+			return Microsoft::CognitiveServices::Speech::CancellationErrorCode::AuthenticationFailure;
+
+		default:
+			break;
+	}
+
+	return Microsoft::CognitiveServices::Speech::CancellationErrorCode::NoError;
+}
+
+const std::string FAzSpeechMockRunnableBase::GenerateResultID()
+{
+	return TCHAR_TO_UTF8(*FString::Printf(TEXT("mock-%08x"), static_cast<uint32>(RandomStream.GetUnsignedInt())));
+}
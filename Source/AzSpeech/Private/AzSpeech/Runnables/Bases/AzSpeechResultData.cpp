@@ -0,0 +1,56 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Runnables/Bases/AzSpeechResultData.h"
+
+namespace AzSpeech::Internal
+{
+	template<typename ResultTy>
+	const int32 GetLatencyProperty(const std::shared_ptr<ResultTy>& InResult, const Microsoft::CognitiveServices::Speech::PropertyId InProperty)
+	{
+		const std::string Value = InResult->Properties.GetProperty(InProperty);
+		return Value.empty() ? 0 : FCString::Atoi(UTF8_TO_TCHAR(Value.c_str()));
+	}
+}
+
+FAzSpeechSynthesisResultData FAzSpeechSynthesisResultData::FromResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>& InResult)
+{
+	FAzSpeechSynthesisResultData Output;
+	if (!InResult)
+	{
+		return Output;
+	}
+
+	Output.Reason = InResult->Reason;
+	Output.ResultID = InResult->ResultId;
+	Output.AudioData = InResult->GetAudioData();
+	Output.AudioDurationTicks = static_cast<int64>(InResult->AudioDuration.count());
+
+	Output.ConnectionLatencyMs = AzSpeech::Internal::GetLatencyProperty(InResult, Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisConnectionLatencyMs);
+	Output.FinishLatencyMs = AzSpeech::Internal::GetLatencyProperty(InResult, Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisFinishLatencyMs);
+	Output.FirstByteLatencyMs = AzSpeech::Internal::GetLatencyProperty(InResult, Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisFirstByteLatencyMs);
+	Output.NetworkLatencyMs = AzSpeech::Internal::GetLatencyProperty(InResult, Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisNetworkLatencyMs);
+	Output.ServiceLatencyMs = AzSpeech::Internal::GetLatencyProperty(InResult, Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisServiceLatencyMs);
+
+	return Output;
+}
+
+FAzSpeechRecognitionResultData FAzSpeechRecognitionResultData::FromResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognitionResult>& InResult)
+{
+	FAzSpeechRecognitionResultData Output;
+	if (!InResult)
+	{
+		return Output;
+	}
+
+	Output.Reason = InResult->Reason;
+	Output.ResultID = InResult->ResultId;
+	Output.Text = InResult->Text;
+	Output.DurationTicks = InResult->Duration();
+	Output.OffsetTicks = InResult->Offset();
+
+	Output.RecognitionLatencyMs = AzSpeech::Internal::GetLatencyProperty(InResult, Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_RecognitionLatencyMs);
+
+	return Output;
+}
@@ -5,6 +5,10 @@
 #include "AzSpeech/Runnables/Bases/AzSpeechRunnableBase.h"
 #include "AzSpeech/Tasks/Bases/AzSpeechTaskBase.h"
 #include "AzSpeech/AzSpeechHelper.h"
+#include "AzSpeech/Managers/AzSpeechConfigCache.h"
+#include "AzSpeech/Managers/AzSpeechEndpointManager.h"
+#include "AzSpeech/Managers/AzSpeechCircuitBreaker.h"
+#include "AzSpeech/Managers/AzSpeechHedgingManager.h"
 #include "AzSpeechInternalFuncs.h"
 #include "LogAzSpeech.h"
 #include <HAL/ThreadManager.h>
@@ -18,6 +22,18 @@
 #include <HAL/PlatformFileManager.h>
 #endif
 
+#if !UE_BUILD_SHIPPING
+THIRD_PARTY_INCLUDES_START
+#include <speechapi_cxx_memory_logger.h>
+THIRD_PARTY_INCLUDES_END
+
+namespace AzSpeech::Internal
+{
+	/* The SDK memory logger is process-wide: Started by the first task and kept running for the rest of the session */
+	static std::atomic<bool> bSDKMemoryLoggerStarted { false };
+}
+#endif
+
 FAzSpeechRunnableBase::FAzSpeechRunnableBase(UAzSpeechTaskBase* InOwningTask, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig) : OwningTask(InOwningTask), AudioConfig(InAudioConfig)
 {
 }
@@ -62,7 +78,10 @@ void FAzSpeechRunnableBase::Stop()
 void FAzSpeechRunnableBase::Exit()
 {
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Exiting thread"), *GetThreadName(), *FString(__func__));
-	
+
+	// Canceled or timed out tasks can exit before the primary attempt reports the result of its probe
+	ReleaseEndpointProbe();
+
 	UAzSpeechTaskBase* const Task = GetOwningTask();
 	if (!Task)
 	{
@@ -99,79 +118,283 @@ std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> FAzSpe
 
 bool FAzSpeechRunnableBase::InitializeAzureObject()
 {
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Runnable_InitializeAzureObject);
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Initializing Azure Object"), *GetThreadName(), *FString(__func__));
+
+#if !UE_BUILD_SHIPPING
+	if (UAzSpeechSettings::Get()->bEnableSDKMemoryLogger && !AzSpeech::Internal::bSDKMemoryLoggerStarted.exchange(true))
+	{
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Starting Azure SDK memory logger"), *GetThreadName(), *FString(__func__));
+		Microsoft::CognitiveServices::Speech::Diagnostics::Logging::MemoryLogger::Start();
+	}
+#endif
 	
-	return true;
+	return SelectEndpoint();
 }
 
 bool FAzSpeechRunnableBase::CanInitializeTask() const
 {
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Checking if can initialize task in current context"), *GetThreadName(), *FString(__func__));
 	
-	bool bOutput = true;
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
+	{
+		return false;
+	}
 
-	if (!UAzSpeechSettings::CheckAzSpeechSettings())
+	if (!UAzSpeechSettings::CheckAzSpeechSettings(GetOwningTask()->GetTaskOptions()))
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Failed to initialize task due to invalid settings"), *GetThreadName(), *FString(__func__));
 
-		bOutput = false;
+		return false;
 	}
 
+	return true;
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig> FAzSpeechRunnableBase::CreateSpeechConfig() const
+{
+	return CreateSpeechConfig(Endpoint);
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig> FAzSpeechRunnableBase::CreateSpeechConfig(const FAzSpeechEndpoint& InEndpoint) const
+{
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating Azure SDK speech config"), *GetThreadName(), *FString(__func__));
+
 	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
 	{
-		bOutput = false;
+		return nullptr;
+	}
+
+	const FName& SubscriptionKey = AzSpeech::Internal::HasEmptyParam(InEndpoint.SubscriptionKey) ? OwningTask->GetTaskOptions().SubscriptionKey : InEndpoint.SubscriptionKey;
+
+	if (InEndpoint.bUsePrivateEndpoint)
+	{
+		return Microsoft::CognitiveServices::Speech::SpeechConfig::FromEndpoint(TCHAR_TO_UTF8(*InEndpoint.PrivateEndpoint.ToString()), TCHAR_TO_UTF8(*SubscriptionKey.ToString()));
 	}
 
-	return bOutput;
+	return Microsoft::CognitiveServices::Speech::SpeechConfig::FromSubscription(TCHAR_TO_UTF8(*SubscriptionKey.ToString()), TCHAR_TO_UTF8(*InEndpoint.RegionID.ToString()));
 }
 
-std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig> FAzSpeechRunnableBase::CreateSpeechConfig() const
+std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig> FAzSpeechRunnableBase::CreateEmbeddedSpeechConfig() const
 {
-	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating Azure SDK speech config"), *GetThreadName(), *FString(__func__));
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating Azure SDK embedded speech config"), *GetThreadName(), *FString(__func__));
 
 	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
 	{
 		return nullptr;
 	}
 
-	if (OwningTask->GetTaskOptions().bUsePrivateEndpoint)
+	std::vector<std::string> ModelPaths;
+	for (const FString& Iterator : OwningTask->GetTaskOptions().GetQualifiedEmbeddedModelPaths())
 	{
-		return Microsoft::CognitiveServices::Speech::SpeechConfig::FromEndpoint(TCHAR_TO_UTF8(*OwningTask->GetTaskOptions().PrivateEndpoint.ToString()), TCHAR_TO_UTF8(*OwningTask->GetTaskOptions().SubscriptionKey.ToString()));
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using embedded model path: %s"), *GetThreadName(), *FString(__func__), *Iterator);
+
+		ModelPaths.push_back(TCHAR_TO_UTF8(*Iterator));
+	}
+
+	if (ModelPaths.empty())
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: No embedded model paths were specified"), *GetThreadName(), *FString(__func__));
+		return nullptr;
 	}
 
-	return Microsoft::CognitiveServices::Speech::SpeechConfig::FromSubscription(TCHAR_TO_UTF8(*OwningTask->GetTaskOptions().SubscriptionKey.ToString()), TCHAR_TO_UTF8(*OwningTask->GetTaskOptions().RegionID.ToString()));
+	return Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig::FromPaths(ModelPaths);
 }
 
-const std::chrono::seconds FAzSpeechRunnableBase::GetTaskTimeout() const
+FAzSpeechBackendConfig FAzSpeechRunnableBase::CreateBackendConfig(bool& bOutIsConfigured) const
 {
-	return std::chrono::seconds(GetTimeout());
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Runnable_CreateBackendConfig);
+	FAzSpeechBackendConfig Output;
+	bOutIsConfigured = false;
+
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
+	{
+		return Output;
+	}
+
+	const FAzSpeechSettingsOptions Options = OwningTask->GetTaskOptions();
+	Output.Backend = Options.Backend;
+	bOutIsConfigured = true;
+
+	if (Options.UsesCloudBackend())
+	{
+		Output.CloudConfig = CreateSpeechConfig();
+		bOutIsConfigured = ApplySDKSettings(Output.CloudConfig) && bOutIsConfigured;
+	}
+
+	if (Options.UsesEmbeddedBackend())
+	{
+		Output.EmbeddedConfig = CreateEmbeddedSpeechConfig();
+		bOutIsConfigured = ApplyEmbeddedSDKSettings(Output.EmbeddedConfig) && bOutIsConfigured;
+	}
+	else if (Options.UsesEmbeddedFallback())
+	{
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating embedded config for the latency fallback"), *GetThreadName(), *FString(__func__));
+
+		// The fallback is optional: the task can still run with the cloud backend only
+		Output.EmbeddedConfig = CreateEmbeddedSpeechConfig();
+		if (!ApplyEmbeddedSDKSettings(Output.EmbeddedConfig))
+		{
+			UE_LOG(LogAzSpeech_Internal, Warning, TEXT("Thread: %s; Function: %s; Message: Embedded fallback is unavailable, only the cloud backend will be used"), *GetThreadName(), *FString(__func__));
+			Output.EmbeddedConfig = nullptr;
+		}
+	}
+
+	if (Options.Backend == EAzSpeechBackend::Hybrid && Output.CloudConfig && Output.EmbeddedConfig)
+	{
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Creating Azure SDK hybrid speech config"), *GetThreadName(), *FString(__func__));
+		Output.HybridConfig = Microsoft::CognitiveServices::Speech::HybridSpeechConfig::FromConfigs(Output.CloudConfig, Output.EmbeddedConfig);
+	}
+
+	return Output;
 }
 
-const bool FAzSpeechRunnableBase::ApplySDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig>& InSpeechConfig) const
+FAzSpeechBackendConfig FAzSpeechRunnableBase::GetCachedBackendConfig() const
 {
-	if (!InSpeechConfig)
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
+	{
+		return FAzSpeechBackendConfig();
+	}
+
+	// Cached configs are shared between tasks and must not be modified after being added to the cache: the SDK copies its properties when creating the recognizer/synthesizer
+	FAzSpeechBackendConfig Output = FAzSpeechConfigCache::FindOrAdd(GetSpeechConfigKey(),
+		[this](bool& bCanCache)
+		{
+			// Only traced when the config is really created: Cache hits don't cost the config creation
+			AZSPEECH_TRACE_TASK_EVENT(ConfigCreated, OwningTask->GetUniqueID(), OwningTask->GetLastResultID().c_str());
+			return CreateBackendConfig(bCanCache);
+		}
+	);
+
+	return Output;
+}
+
+const FString FAzSpeechRunnableBase::GetSpeechConfigKey() const
+{
+	const FAzSpeechSettingsOptions Options = OwningTask->GetTaskOptions();
+
+	// Viseme and word boundary outputs are enabled by connecting the synthesizer events, not in the config: They don't split the cached configs
+	TArray<FString> Values {
+		Options.SubscriptionKey.ToString(),
+		Endpoint.SubscriptionKey.ToString(),
+		Endpoint.RegionID.ToString(),
+		FString::FromInt(Endpoint.bUsePrivateEndpoint),
+		Endpoint.PrivateEndpoint.ToString(),
+		FString::FromInt(static_cast<int32>(Options.Backend)),
+		Options.EmbeddedRecognitionModel.ToString(),
+		Options.EmbeddedSynthesisVoice.ToString(),
+		Options.EmbeddedModelKey.ToString(),
+		FString::FromInt(static_cast<int32>(Options.FallbackPolicy)),
+		Options.LanguageID.ToString(),
+		Options.VoiceName.ToString(),
+		FString::FromInt(static_cast<int32>(Options.ProfanityFilter)),
+		FString::FromInt(static_cast<int32>(Options.SpeechSynthesisOutputFormat)),
+		FString::FromInt(static_cast<int32>(Options.SpeechRecognitionOutputFormat)),
+		FString::FromInt(UAzSpeechSettings::Get()->bEnableSDKLogs),
+		FString::JoinBy(Options.AutoCandidateLanguages, TEXT(","), [](const FName& Iterator) { return Iterator.ToString(); }),
+		FString::Join(Options.EmbeddedModelPaths, TEXT(","))
+	};
+
+	return FString::Join(Values, TEXT("|"));
+}
+
+bool FAzSpeechRunnableBase::SelectEndpoint()
+{
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
 	{
-		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Invalid speech config"), *GetThreadName(), *FString(__func__));
 		return false;
 	}
 
-	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Applying Azure SDK Settings"), *GetThreadName(), *FString(__func__));
+	const FAzSpeechSettingsOptions Options = OwningTask->GetTaskOptions();
+	if (!Options.bUseEndpointPool || !Options.UsesEndpoints())
+	{
+		Endpoint = Options.GetDefaultEndpoint();
+	}
+	else
+	{
+		const int32 SelectedIndex = FAzSpeechEndpointManager::SelectEndpoint(Options.EndpointPool);
+		if (!Options.EndpointPool.IsValidIndex(SelectedIndex))
+		{
+			UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: No available endpoint in the endpoint pool"), *GetThreadName(), *FString(__func__));
+			return false;
+		}
 
-	EnableLogInConfiguration(InSpeechConfig);
+		Endpoint = Options.EndpointPool[SelectedIndex];
 
-	InSpeechConfig->SetProfanity(GetProfanityFilter());
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using endpoint %s from the endpoint pool"), *GetThreadName(), *FString(__func__), *Endpoint.GetEndpointID());
+	}
 
-	if (GetOwningTask()->IsUsingAutoLanguage())
+	// Hybrid and fallback tasks can still be answered by the embedded backend while the circuit is open
+	bool bIsProbe = false;
+	if (Options.RequiresCloudBackend() && !FAzSpeechCircuitBreaker::TryAcquire(Endpoint, bIsProbe))
 	{
-		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using auto language identification"), *GetThreadName(), *FString(__func__));
-		
-		InSpeechConfig->SetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceConnection_LanguageIdMode, "Continuous");
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Circuit of endpoint %s is open"), *GetThreadName(), *FString(__func__), *Endpoint.GetEndpointID());
+		return false;
 	}
 
+	bIsProbingEndpoint = bIsProbe;
+
 	return true;
 }
 
-const bool FAzSpeechRunnableBase::EnableLogInConfiguration(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig>& InSpeechConfig) const
+const FAzSpeechEndpoint& FAzSpeechRunnableBase::GetEndpoint() const
+{
+	return Endpoint;
+}
+
+const FAzSpeechEndpoint* FAzSpeechRunnableBase::GetAttemptEndpoint(const EAzSpeechAttempt InAttempt) const
+{
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
+	{
+		return nullptr;
+	}
+
+	if (InAttempt == EAzSpeechAttempt::Fallback)
+	{
+		return bIsHedging ? &HedgeEndpoint : nullptr;
+	}
+
+	return OwningTask->GetTaskOptions().UsesEndpoints() ? &Endpoint : nullptr;
+}
+
+void FAzSpeechRunnableBase::ReportEndpointSuccess(const EAzSpeechAttempt InAttempt, const int32 LatencyMs) const
+{
+	const FAzSpeechEndpoint* const AttemptEndpoint = GetAttemptEndpoint(InAttempt);
+	if (AttemptEndpoint)
+	{
+		if (InAttempt == EAzSpeechAttempt::Primary)
+		{
+			bIsProbingEndpoint = false;
+		}
+
+		FAzSpeechEndpointManager::ReportSuccess(*AttemptEndpoint, LatencyMs);
+		FAzSpeechCircuitBreaker::ReportSuccess(*AttemptEndpoint);
+	}
+
+	if (UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
+	{
+		OwningTask->RecordLatencyMetrics(AttemptEndpoint ? AttemptEndpoint->GetEndpointID() : FString());
+	}
+}
+
+void FAzSpeechRunnableBase::ReleaseEndpointProbe() const
+{
+	if (!bIsProbingEndpoint.exchange(false))
+	{
+		return;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Primary attempt stopped while probing endpoint %s"), *GetThreadName(), *FString(__func__), *Endpoint.GetEndpointID());
+	FAzSpeechCircuitBreaker::ReleaseProbe(Endpoint);
+}
+
+const std::chrono::seconds FAzSpeechRunnableBase::GetTaskTimeout() const
+{
+	return std::chrono::seconds(GetTimeout());
+}
+
+template<typename ConfigTy>
+const bool FAzSpeechRunnableBase::EnableLogInConfiguration(const std::shared_ptr<ConfigTy>& InSpeechConfig) const
 {
 	if (!UAzSpeechSettings::Get()->bEnableSDKLogs)
 	{
@@ -207,6 +430,51 @@ const bool FAzSpeechRunnableBase::EnableLogInConfiguration(const std::shared_ptr
 #endif
 }
 
+const bool FAzSpeechRunnableBase::ApplySDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig>& InSpeechConfig) const
+{
+	if (!InSpeechConfig)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Invalid speech config"), *GetThreadName(), *FString(__func__));
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Applying Azure SDK Settings"), *GetThreadName(), *FString(__func__));
+
+	EnableLogInConfiguration(InSpeechConfig);
+
+	InSpeechConfig->SetProfanity(GetProfanityFilter());
+
+	if (GetOwningTask()->IsUsingAutoLanguage())
+	{
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using auto language identification"), *GetThreadName(), *FString(__func__));
+		
+		InSpeechConfig->SetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceConnection_LanguageIdMode, "Continuous");
+	}
+
+	return true;
+}
+
+const bool FAzSpeechRunnableBase::ApplyEmbeddedSDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig>& InEmbeddedConfig) const
+{
+	if (!InEmbeddedConfig)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Invalid embedded speech config"), *GetThreadName(), *FString(__func__));
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Applying Azure SDK Embedded Settings"), *GetThreadName(), *FString(__func__));
+
+	// Hybrid configs already write the SDK log through the cloud config
+	if (GetOwningTask()->GetTaskOptions().Backend == EAzSpeechBackend::Embedded)
+	{
+		EnableLogInConfiguration(InEmbeddedConfig);
+	}
+
+	InEmbeddedConfig->SetProfanity(GetProfanityFilter());
+
+	return true;
+}
+
 const Microsoft::CognitiveServices::Speech::ProfanityOption FAzSpeechRunnableBase::GetProfanityFilter() const
 {
 	if (UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
@@ -247,7 +515,7 @@ const FString FAzSpeechRunnableBase::CancellationReasonToString(const Microsoft:
 	}
 }
 
-void FAzSpeechRunnableBase::ProcessCancellationError(const Microsoft::CognitiveServices::Speech::CancellationErrorCode& ErrorCode, const std::string& ErrorDetails) const
+void FAzSpeechRunnableBase::ProcessCancellationError(const Microsoft::CognitiveServices::Speech::CancellationErrorCode& ErrorCode, const std::string& ErrorDetails, const EAzSpeechAttempt InAttempt) const
 {
 	FString ErrorCodeStr;
 	switch (ErrorCode)
@@ -310,8 +578,62 @@ void FAzSpeechRunnableBase::ProcessCancellationError(const Microsoft::CognitiveS
 	}
 
 	UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Error code: %s"), *GetThreadName(), *FString(__func__), *ErrorCodeStr);
+
+	if (UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
+	{
+		OwningTask->RecordEvent(EAzSpeechLogEvent::Canceled, static_cast<int32>(ErrorCode), static_cast<int64>(InAttempt));
+		OwningTask->FlushEventLog(FString::Printf(TEXT("Canceled with error code %s"), *ErrorCodeStr));
+	}
+
+	// Errors caused by the service or the connection count against the endpoint, so the next tasks can fail over to another one
+	const FAzSpeechEndpoint* const AttemptEndpoint = GetAttemptEndpoint(InAttempt);
+	switch (ErrorCode)
+	{
+		case Microsoft::CognitiveServices::Speech::CancellationErrorCode::ConnectionFailure:
+		case Microsoft::CognitiveServices::Speech::CancellationErrorCode::ServiceUnavailable:
+			if (AttemptEndpoint)
+			{
+				if (InAttempt == EAzSpeechAttempt::Primary)
+				{
+					bIsProbingEndpoint = false;
+				}
+
+				FAzSpeechEndpointManager::ReportFailure(*AttemptEndpoint);
+				FAzSpeechCircuitBreaker::ReportOutage(*AttemptEndpoint);
+			}
+			break;
+
+		case Microsoft::CognitiveServices::Speech::CancellationErrorCode::AuthenticationFailure:
+		case Microsoft::CognitiveServices::Speech::CancellationErrorCode::Forbidden:
+		case Microsoft::CognitiveServices::Speech::CancellationErrorCode::TooManyRequests:
+		case Microsoft::CognitiveServices::Speech::CancellationErrorCode::ServiceTimeout:
+		case Microsoft::CognitiveServices::Speech::CancellationErrorCode::ServiceError:
+			if (AttemptEndpoint)
+			{
+				FAzSpeechEndpointManager::ReportFailure(*AttemptEndpoint);
+			}
+			break;
+
+		default:
+			break;
+	}
+
 	UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Error details: %s"), *GetThreadName(), *FString(__func__), UTF8_TO_TCHAR(ErrorDetails.c_str()));
 	UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Log generated in directory: %s"), *GetThreadName(), *FString(__func__), *UAzSpeechHelper::GetAzSpeechLogsBaseDir());
+
+#if !UE_BUILD_SHIPPING
+	if (AzSpeech::Internal::bSDKMemoryLoggerStarted.load())
+	{
+		if (FString MemoryLogPath = UAzSpeechHelper::GetAzSpeechLogsBaseDir(); IFileManager::Get().MakeDirectory(*MemoryLogPath, true))
+		{
+			MemoryLogPath = FPaths::Combine(MemoryLogPath, FString::Printf(TEXT("AzSpeech Memory %s %d.log"), *FDateTime::Now().ToString(), GetOwningTask() ? GetOwningTask()->GetUniqueID() : 0));
+			FPaths::NormalizeFilename(MemoryLogPath);
+
+			Microsoft::CognitiveServices::Speech::Diagnostics::Logging::MemoryLogger::Dump(TCHAR_TO_UTF8(*MemoryLogPath));
+			UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Azure SDK memory log dumped to: %s"), *GetThreadName(), *FString(__func__), *MemoryLogPath);
+		}
+	}
+#endif
 }
 
 const EThreadPriority FAzSpeechRunnableBase::GetCPUThreadPriority() const
@@ -368,6 +690,217 @@ const FString FAzSpeechRunnableBase::GetThreadName() const
 	return ThreadName.ToString();
 }
 
+void FAzSpeechRunnableBase::InitializeFallbackPolicy(const FAzSpeechBackendConfig& InBackendConfig)
+{
+	FallbackPolicy = EAzSpeechFallbackPolicy::Disabled;
+
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()) || !OwningTask->GetTaskOptions().UsesEmbeddedFallback() || !InBackendConfig.HasEmbeddedFallback())
+	{
+		return;
+	}
+
+	FallbackConfig = InBackendConfig.GetEmbeddedFallback();
+	FallbackPolicy = OwningTask->GetTaskOptions().FallbackPolicy;
+	FallbackDelayMs = OwningTask->GetTaskOptions().FallbackLatencyBudgetMs;
+	FallbackStartTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using embedded fallback with a latency budget of %dms"), *GetThreadName(), *FString(__func__), OwningTask->GetTaskOptions().FallbackLatencyBudgetMs);
+}
+
+const bool FAzSpeechRunnableBase::IsFallbackPolicyEnabled() const
+{
+	return FallbackPolicy != EAzSpeechFallbackPolicy::Disabled;
+}
+
+const FAzSpeechBackendConfig& FAzSpeechRunnableBase::GetFallbackConfig() const
+{
+	return FallbackConfig;
+}
+
+void FAzSpeechRunnableBase::InitializeHedgingPolicy()
+{
+	if (IsFallbackPolicyEnabled() || !UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()) || !OwningTask->GetTaskOptions().UsesRequestHedging())
+	{
+		return;
+	}
+
+	FAzSpeechHedgingManager::AddRequest();
+
+	const int32 HedgeDelayMs = FAzSpeechHedgingManager::GetHedgeDelayMs(Endpoint);
+	if (HedgeDelayMs == INDEX_NONE)
+	{
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Not enough latency samples of endpoint %s to hedge the request"), *GetThreadName(), *FString(__func__), *Endpoint.GetEndpointID());
+		return;
+	}
+
+	bIsHedging = true;
+	FallbackPolicy = EAzSpeechFallbackPolicy::Race;
+	FallbackDelayMs = HedgeDelayMs;
+	FallbackStartTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using request hedging with a delay of %dms"), *GetThreadName(), *FString(__func__), HedgeDelayMs);
+}
+
+const bool FAzSpeechRunnableBase::IsHedgingEnabled() const
+{
+	return bIsHedging;
+}
+
+bool FAzSpeechRunnableBase::PrepareHedgeAttempt()
+{
+	if (!UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
+	{
+		return false;
+	}
+
+	if (!FAzSpeechHedgingManager::TryConsumeHedge())
+	{
+		UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Hedge budget exhausted, waiting for the endpoint %s"), *GetThreadName(), *FString(__func__), *Endpoint.GetEndpointID());
+		return false;
+	}
+
+	const TArray<FAzSpeechEndpoint>& EndpointPool = OwningTask->GetTaskOptions().EndpointPool;
+
+	// A hedge sent to an unhealthy endpoint wouldn't improve the latency
+	const int32 SelectedIndex = FAzSpeechEndpointManager::SelectEndpoint(EndpointPool, Endpoint.GetEndpointID());
+	if (!EndpointPool.IsValidIndex(SelectedIndex) || !FAzSpeechEndpointManager::GetHealth(EndpointPool[SelectedIndex]).bIsHealthy)
+	{
+		UE_LOG(LogAzSpeech_Internal, Warning, TEXT("Thread: %s; Function: %s; Message: No healthy endpoint available to hedge the request"), *GetThreadName(), *FString(__func__));
+		return false;
+	}
+
+	HedgeEndpoint = EndpointPool[SelectedIndex];
+
+	// Hedge configs aren't cached: they're only created for the small share of requests allowed by the hedge budget
+	FallbackConfig = FAzSpeechBackendConfig();
+	FallbackConfig.Backend = EAzSpeechBackend::Cloud;
+	FallbackConfig.CloudConfig = CreateSpeechConfig(HedgeEndpoint);
+
+	return ApplySDKSettings(FallbackConfig.CloudConfig);
+}
+
+void FAzSpeechRunnableBase::UpdateFallbackPolicy()
+{
+	if (!IsFallbackPolicyEnabled() || bLoserStopped || !UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()))
+	{
+		return;
+	}
+
+	if (!bFallbackStarted && WinnerAttempt == EAzSpeechAttempt::None)
+	{
+		const double ElapsedMs = (FPlatformTime::Seconds() - FallbackStartTime) * 1000.0;
+		if (!bFallbackRequested && ElapsedMs < static_cast<double>(FallbackDelayMs))
+		{
+			return;
+		}
+
+		bFallbackStarted = true;
+
+		if (bIsHedging)
+		{
+			UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: No audio from endpoint %s after %.0fms, hedging the request"), *GetThreadName(), *FString(__func__), *Endpoint.GetEndpointID(), ElapsedMs);
+		}
+		else
+		{
+			UE_LOG(LogAzSpeech_Internal, Warning, TEXT("Thread: %s; Function: %s; Message: No cloud result after %.0fms, starting embedded fallback"), *GetThreadName(), *FString(__func__), ElapsedMs);
+		}
+
+		if (bIsHedging ? !PrepareHedgeAttempt() || !StartFallbackAttempt() : !StartFallbackAttempt())
+		{
+			// Hedges are optional: the primary attempt keeps running if the request can't be hedged
+			if (bIsHedging)
+			{
+				UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Request not hedged, waiting for the primary attempt"), *GetThreadName(), *FString(__func__));
+			}
+			else
+			{
+				UE_LOG(LogAzSpeech_Internal, Error, TEXT("Thread: %s; Function: %s; Message: Failed to start embedded fallback"), *GetThreadName(), *FString(__func__));
+			}
+
+			if (DeferAttemptFailure(EAzSpeechAttempt::Fallback) || !ClaimAttempt(EAzSpeechAttempt::Fallback, false))
+			{
+				return;
+			}
+
+			// Both attempts failed and the primary failure was deferred to the fallback
+			OnAllAttemptsFailed();
+			return;
+		}
+
+		if (FallbackPolicy == EAzSpeechFallbackPolicy::Switch)
+		{
+			ClaimAttempt(EAzSpeechAttempt::Fallback, false);
+		}
+	}
+
+	const EAzSpeechAttempt Winner = WinnerAttempt;
+	if (Winner == EAzSpeechAttempt::None || !bFallbackStarted)
+	{
+		return;
+	}
+
+	bLoserStopped = true;
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Thread: %s; Function: %s; Message: Using %s result, stopping the other attempt"), *GetThreadName(), *FString(__func__), Winner == EAzSpeechAttempt::Primary ? TEXT("primary") : bIsHedging ? TEXT("hedged") : TEXT("embedded"));
+
+	StopAttempt(Winner == EAzSpeechAttempt::Primary ? EAzSpeechAttempt::Fallback : EAzSpeechAttempt::Primary);
+
+	// The stopped primary attempt never reports its result: Without releasing its probe, the breaker would reject the other tasks until the probe timeout
+	if (Winner != EAzSpeechAttempt::Primary)
+	{
+		ReleaseEndpointProbe();
+	}
+}
+
+const bool FAzSpeechRunnableBase::ClaimAttempt(const EAzSpeechAttempt InAttempt, const bool bHasResult)
+{
+	EAzSpeechAttempt Expected = EAzSpeechAttempt::None;
+	if (!WinnerAttempt.compare_exchange_strong(Expected, InAttempt) && Expected != InAttempt)
+	{
+		return false;
+	}
+
+	// Called from the SDK callbacks: The task lock can be held by the runnable exit while it waits for the attempts to stop
+	if (bHasResult && InAttempt == EAzSpeechAttempt::Fallback && !bIsHedging && UAzSpeechTaskStatus::IsTaskStillValid(GetOwningTask()) && !OwningTask->bIsUsingFallbackBackend.load())
+	{
+		OwningTask->bIsUsingFallbackBackend = true;
+	}
+
+	return true;
+}
+
+const bool FAzSpeechRunnableBase::DeferAttemptFailure(const EAzSpeechAttempt InAttempt)
+{
+	if (!IsFallbackPolicyEnabled() || WinnerAttempt != EAzSpeechAttempt::None)
+	{
+		return false;
+	}
+
+	constexpr uint8 AllAttempts = (1u << static_cast<uint8>(EAzSpeechAttempt::Primary)) | (1u << static_cast<uint8>(EAzSpeechAttempt::Fallback));
+	const uint8 Failed = FailedAttempts.fetch_or(1u << static_cast<uint8>(InAttempt)) | (1u << static_cast<uint8>(InAttempt));
+
+	if (InAttempt == EAzSpeechAttempt::Primary && !bFallbackRequested.exchange(true))
+	{
+		UE_LOG(LogAzSpeech_Internal, Warning, TEXT("Thread: %s; Function: %s; Message: Primary attempt failed, requesting %s"), *GetThreadName(), *FString(__func__), bIsHedging ? TEXT("hedged request") : TEXT("embedded fallback"));
+	}
+
+	return Failed != AllAttempts;
+}
+
+bool FAzSpeechRunnableBase::StartFallbackAttempt()
+{
+	return false;
+}
+
+void FAzSpeechRunnableBase::StopAttempt([[maybe_unused]] const EAzSpeechAttempt InAttempt)
+{
+}
+
+void FAzSpeechRunnableBase::OnAllAttemptsFailed()
+{
+	StopAzSpeechRunnableTask();
+}
+
 void FAzSpeechRunnableBase::StoreThreadInformation()
 {
 	const FString& ThreadNameRef = FThreadManager::Get().GetThreadName(FPlatformTLS::GetCurrentThreadId());
@@ -0,0 +1,37 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Structures/AzSpeechEndpoint.h"
+#include "AzSpeechInternalFuncs.h"
+
+#ifdef UE_INLINE_GENERATED_CPP_BY_NAME
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AzSpeechEndpoint)
+#endif
+
+const bool FAzSpeechEndpoint::IsValid() const
+{
+	return !AzSpeech::Internal::HasEmptyParam(bUsePrivateEndpoint ? PrivateEndpoint : RegionID);
+}
+
+const FString FAzSpeechEndpoint::GetEndpointID() const
+{
+	const FString Location = bUsePrivateEndpoint ? PrivateEndpoint.ToString() : FString::Printf(TEXT("region:%s"), *RegionID.ToString());
+	if (AzSpeech::Internal::HasEmptyParam(SubscriptionKey))
+	{
+		return Location;
+	}
+
+	// The ID is logged and used in the metrics: Only a hash of the key is added to distinguish resources sharing the same location
+	return FString::Printf(TEXT("%s;key:%08x"), *Location, FCrc::StrCrc32(*SubscriptionKey.ToString()));
+}
+
+uint32 GetTypeHash(const FAzSpeechEndpoint& Endpoint)
+{
+	uint32 Output = GetTypeHash(Endpoint.SubscriptionKey);
+	Output = HashCombine(Output, GetTypeHash(Endpoint.RegionID));
+	Output = HashCombine(Output, GetTypeHash(static_cast<uint8>(Endpoint.bUsePrivateEndpoint)));
+	Output = HashCombine(Output, GetTypeHash(Endpoint.PrivateEndpoint));
+
+	return Output;
+}
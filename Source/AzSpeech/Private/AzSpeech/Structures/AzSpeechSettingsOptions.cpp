@@ -4,6 +4,7 @@
 
 #include "AzSpeech/Structures/AzSpeechSettingsOptions.h"
 #include "AzSpeech/AzSpeechSettings.h"
+#include <Misc/Paths.h>
 
 #ifdef UE_INLINE_GENERATED_CPP_BY_NAME
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AzSpeechSettingsOptions)
@@ -37,12 +38,108 @@ void FAzSpeechSettingsOptions::SetDefaults()
 		RegionID = Settings->DefaultOptions.RegionID;
 		bUsePrivateEndpoint = Settings->DefaultOptions.bUsePrivateEndpoint;
 		PrivateEndpoint = Settings->DefaultOptions.PrivateEndpoint;
+		bUseEndpointPool = Settings->DefaultOptions.bUseEndpointPool;
+		EndpointPool = Settings->DefaultOptions.EndpointPool;
+		bEnableRequestHedging = Settings->DefaultOptions.bEnableRequestHedging;
+		Backend = Settings->DefaultOptions.Backend;
+		EmbeddedModelPaths = Settings->DefaultOptions.EmbeddedModelPaths;
+		EmbeddedRecognitionModel = Settings->DefaultOptions.EmbeddedRecognitionModel;
+		EmbeddedSynthesisVoice = Settings->DefaultOptions.EmbeddedSynthesisVoice;
+		EmbeddedModelKey = Settings->DefaultOptions.EmbeddedModelKey;
+		FallbackPolicy = Settings->DefaultOptions.FallbackPolicy;
+		FallbackLatencyBudgetMs = Settings->DefaultOptions.FallbackLatencyBudgetMs;
 		LanguageID = Settings->DefaultOptions.LanguageID;
 		AutoCandidateLanguages = Settings->DefaultOptions.AutoCandidateLanguages;
 		VoiceName = Settings->DefaultOptions.VoiceName;
 		ProfanityFilter = Settings->DefaultOptions.ProfanityFilter;
 		bEnableViseme = Settings->DefaultOptions.bEnableViseme;
+		bEnableWordBoundary = Settings->DefaultOptions.bEnableWordBoundary;
 		SpeechSynthesisOutputFormat = Settings->DefaultOptions.SpeechSynthesisOutputFormat;
 		SpeechRecognitionOutputFormat = Settings->DefaultOptions.SpeechRecognitionOutputFormat;
 	}
 }
+
+const bool FAzSpeechSettingsOptions::UsesCloudBackend() const
+{
+	return Backend == EAzSpeechBackend::Cloud || Backend == EAzSpeechBackend::Hybrid;
+}
+
+const bool FAzSpeechSettingsOptions::UsesEmbeddedBackend() const
+{
+	return Backend == EAzSpeechBackend::Embedded || Backend == EAzSpeechBackend::Hybrid;
+}
+
+const bool FAzSpeechSettingsOptions::UsesEmbeddedFallback() const
+{
+	return Backend == EAzSpeechBackend::Cloud && FallbackPolicy != EAzSpeechFallbackPolicy::Disabled;
+}
+
+const bool FAzSpeechSettingsOptions::UsesEndpoints() const
+{
+	return UsesCloudBackend();
+}
+
+const bool FAzSpeechSettingsOptions::UsesRequestHedging() const
+{
+	return Backend == EAzSpeechBackend::Cloud && bUseEndpointPool && bEnableRequestHedging && EndpointPool.Num() > 1 && !UsesEmbeddedFallback();
+}
+
+const bool FAzSpeechSettingsOptions::RequiresCloudBackend() const
+{
+	return Backend == EAzSpeechBackend::Cloud && !UsesEmbeddedFallback();
+}
+
+const TArray<FAzSpeechEndpoint> FAzSpeechSettingsOptions::GetCandidateEndpoints() const
+{
+	if (bUseEndpointPool)
+	{
+		return EndpointPool;
+	}
+
+	return TArray<FAzSpeechEndpoint> { GetDefaultEndpoint() };
+}
+
+const FAzSpeechEndpoint FAzSpeechSettingsOptions::GetDefaultEndpoint() const
+{
+	FAzSpeechEndpoint Output;
+	Output.SubscriptionKey = SubscriptionKey;
+	Output.RegionID = RegionID;
+	Output.bUsePrivateEndpoint = bUsePrivateEndpoint;
+	Output.PrivateEndpoint = PrivateEndpoint;
+
+	return Output;
+}
+
+const bool FAzSpeechSettingsOptions::HasValidEndpoint() const
+{
+	if (!bUseEndpointPool)
+	{
+		return GetDefaultEndpoint().IsValid() && !SubscriptionKey.IsNone();
+	}
+
+	for (const FAzSpeechEndpoint& Iterator : EndpointPool)
+	{
+		if (Iterator.IsValid() && !(Iterator.SubscriptionKey.IsNone() && SubscriptionKey.IsNone()))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const TArray<FString> FAzSpeechSettingsOptions::GetQualifiedEmbeddedModelPaths() const
+{
+	TArray<FString> Output;
+	for (const FString& Iterator : EmbeddedModelPaths)
+	{
+		if (Iterator.IsEmpty())
+		{
+			continue;
+		}
+
+		Output.Add(FPaths::ConvertRelativePathToFull(FPaths::IsRelative(Iterator) ? FPaths::Combine(FPaths::ProjectDir(), Iterator) : Iterator));
+	}
+
+	return Output;
+}
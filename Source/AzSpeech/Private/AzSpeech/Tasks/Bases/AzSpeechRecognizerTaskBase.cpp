@@ -4,6 +4,8 @@
 
 #include "AzSpeech/Tasks/Bases/AzSpeechRecognizerTaskBase.h"
 #include "AzSpeech/Runnables/AzSpeechRecognitionRunnable.h"
+#include "AzSpeech/Runnables/AzSpeechMockRecognitionRunnable.h"
+#include "AzSpeech/Managers/AzSpeechMetricsRegistry.h"
 #include "LogAzSpeech.h"
 #include <Async/Async.h>
 
@@ -36,7 +38,14 @@ const int32 UAzSpeechRecognizerTaskBase::GetRecognitionLatency() const
 
 void UAzSpeechRecognizerTaskBase::StartRecognitionWork(const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig)
 {
-	RunnableTask = MakeShared<FAzSpeechRecognitionRunnable>(this, InAudioConfig);
+	if (GetTaskOptions().Backend == EAzSpeechBackend::Mock)
+	{
+		RunnableTask = MakeShared<FAzSpeechMockRecognitionRunnable>(this, InAudioConfig);
+	}
+	else
+	{
+		RunnableTask = MakeShared<FAzSpeechRecognitionRunnable>(this, InAudioConfig);
+	}
 
 	if (!RunnableTask)
 	{
@@ -47,6 +56,13 @@ void UAzSpeechRecognizerTaskBase::StartRecognitionWork(const std::shared_ptr<Mic
 	RunnableTask->StartAzSpeechRunnableTask();
 }
 
+std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> UAzSpeechRecognizerTaskBase::CreateFallbackAudioConfig()
+{
+	UE_LOG(LogAzSpeech_Internal, Warning, TEXT("Task: %s (%d); Function: %s; Message: Task doesn't support the embedded fallback"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+
+	return nullptr;
+}
+
 void UAzSpeechRecognizerTaskBase::BroadcastFinalResult()
 {
 	if (!UAzSpeechTaskStatus::IsTaskActive(this))
@@ -56,7 +72,7 @@ void UAzSpeechRecognizerTaskBase::BroadcastFinalResult()
 
 	Super::BroadcastFinalResult();
 
-	AsyncTask(ENamedThreads::GameThread,
+	AzSpeech::Internal::AsyncGameThreadTask(GetUniqueID(), GetLastResultID(),
 		[this]
 		{
 			RecognitionCompleted.Broadcast(GetRecognizedString());
@@ -64,13 +80,31 @@ void UAzSpeechRecognizerTaskBase::BroadcastFinalResult()
 	);
 }
 
-void UAzSpeechRecognizerTaskBase::OnRecognitionUpdated(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognitionResult>& LastResult)
+void UAzSpeechRecognizerTaskBase::OnCircuitOpen()
+{
+	// Called while activating the task, in the game thread
+	RecognitionFailed.Broadcast();
+}
+
+void UAzSpeechRecognizerTaskBase::RecordLatencyMetrics(const FString& EndpointID) const
 {
 	FScopeLock Lock(&Mutex);
 
-	RecognitionLatency = static_cast<int32>(std::stoi(LastResult->Properties.GetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_RecognitionLatencyMs)));
+	// Recognition doesn't use a voice: Samples are grouped by language
+	FAzSpeechMetricsRegistry::RecordSample(EAzSpeechLatencyMetric::Recognition, GetTaskOptions().LanguageID, EndpointID, RecognitionLatency);
+}
+
+void UAzSpeechRecognizerTaskBase::OnRecognitionUpdated(const FAzSpeechRecognitionResultData& LastResult)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Task_OnRecognitionUpdated);
+	FScopeLock Lock(&Mutex);
 
-	if (UAzSpeechSettings::Get()->bEnableDebuggingLogs || UAzSpeechSettings::Get()->bEnableDebuggingPrints)
+	SetLastResultID(LastResult.ResultID);
+	RecognitionLatency = LastResult.RecognitionLatencyMs;
+	RecordEvent(EAzSpeechLogEvent::Partial, static_cast<int32>(LastResult.Text.size()), static_cast<int64>(LastResult.OffsetTicks));
+
+	bool bPrintDebuggingInfo = false;
+	if (IsDebuggingInfoEnabled(bPrintDebuggingInfo))
 	{
 		const auto TicksToMs = [](const auto& Ticks)
 		{
@@ -81,11 +115,11 @@ void UAzSpeechRecognizerTaskBase::OnRecognitionUpdated(const std::shared_ptr<Mic
 			TaskName.ToString(),
 			GetUniqueID(),
 			FString(__func__),
-			UTF8_TO_TCHAR(LastResult->Text.c_str()),
-			TicksToMs(LastResult->Duration()),
-			TicksToMs(LastResult->Offset()),
-			static_cast<int32>(LastResult->Reason),
-			UTF8_TO_TCHAR(LastResult->ResultId.c_str()),
+			UTF8_TO_TCHAR(LastResult.Text.c_str()),
+			TicksToMs(LastResult.DurationTicks),
+			TicksToMs(LastResult.OffsetTicks),
+			static_cast<int32>(LastResult.Reason),
+			UTF8_TO_TCHAR(LastResult.ResultID.c_str()),
 			RecognitionLatency
 		};
 
@@ -94,16 +128,21 @@ void UAzSpeechRecognizerTaskBase::OnRecognitionUpdated(const std::shared_ptr<Mic
 		UE_LOG(LogAzSpeech_Debugging, Display, TEXT("%s"), *MountedDebuggingInfo);
 
 #if !UE_BUILD_SHIPPING
-		if (UAzSpeechSettings::Get()->bEnableDebuggingPrints)
+		if (bPrintDebuggingInfo)
 		{
 			GEngine->AddOnScreenDebugMessage(static_cast<int32>(GetUniqueID()), 5.f, FColor::Yellow, MountedDebuggingInfo);
 		}
 #endif
 	}
 
-	RecognizedText = LastResult->Text;
+	if (RecognizedText.empty() && !LastResult.Text.empty())
+	{
+		AZSPEECH_TRACE_TASK_EVENT(FirstPartial, GetUniqueID(), LastResult.ResultID.c_str());
+	}
+
+	RecognizedText = LastResult.Text;
 
-	AsyncTask(ENamedThreads::GameThread,
+	AzSpeech::Internal::AsyncGameThreadTask(
 		[this]
 		{
 			RecognitionUpdated.Broadcast(GetRecognizedString());
@@ -52,10 +52,10 @@ void UAzSpeechSpeechSynthesisBase::BroadcastFinalResult()
 
 	Super::BroadcastFinalResult();
 
-	AsyncTask(ENamedThreads::GameThread,
+	AzSpeech::Internal::AsyncGameThreadTask(GetUniqueID(), GetLastResultID(),
 		[this]
 		{
-			AudioComponent = UGameplayStatics::CreateSound2D(WorldContextObject, UAzSpeechHelper::ConvertAudioDataToSoundWave(GetAudioData()));
+			AudioComponent = UGameplayStatics::CreateSound2D(WorldContextObject, UAzSpeechHelper::ConvertAudioBufferToSoundWave(GetAudioBuffer()));
 
 			FScriptDelegate UniqueDelegate_AudioStateChanged;
 			UniqueDelegate_AudioStateChanged.BindUFunction(this, TEXT("OnAudioPlayStateChanged"));
@@ -4,10 +4,15 @@
 
 #include "AzSpeech/Tasks/Bases/AzSpeechSynthesizerTaskBase.h"
 #include "AzSpeech/Runnables/AzSpeechSynthesisRunnable.h"
+#include "AzSpeech/Runnables/AzSpeechMockSynthesisRunnable.h"
 #include "AzSpeech/AzSpeechHelper.h"
+#include "AzSpeech/Managers/AzSpeechMetricsRegistry.h"
+#include "AzSpeech/Animation/AzSpeechAnimationParser.h"
+#include "AzSpeech/Animation/AzSpeechVisemeTimeline.h"
 #include "AzSpeechInternalFuncs.h"
 #include "LogAzSpeech.h"
 #include <Async/Async.h>
+#include <Algo/BinarySearch.h>
 
 #if !UE_BUILD_SHIPPING
 #include <Engine/Engine.h>
@@ -41,29 +46,163 @@ const TArray<uint8> UAzSpeechSynthesizerTaskBase::GetAudioData() const
 {
 	FScopeLock Lock(&Mutex);
 
-	if (AudioData.empty())
-	{
-		return TArray<uint8>();
-	}
+	return AudioData.ToArray();
+}
 
-	TArray<uint8> OutputArr;
-	OutputArr.Append(reinterpret_cast<const uint8*>(AudioData.data()), AudioData.size());
+const FAzSpeechAudioBuffer UAzSpeechSynthesizerTaskBase::GetAudioBuffer() const
+{
+	FScopeLock Lock(&Mutex);
 
-	return OutputArr;
+	return AudioData;
 }
 
 const FAzSpeechAnimationData UAzSpeechSynthesizerTaskBase::GetLastExtractedAnimationData() const
 {
 	FScopeLock Lock(&Mutex);
 
-	return UAzSpeechHelper::ExtractAnimationDataFromVisemeData(GetLastVisemeData());
+	if (AzSpeech::Internal::HasEmptyParam(VisemeSegments))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Animation data is empty"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+		return FAzSpeechAnimationData();
+	}
+
+	return BlendShapeMatrix.GetSegmentAnimationData(VisemeSegments.Last());
 }
 
 const TArray<FAzSpeechAnimationData> UAzSpeechSynthesizerTaskBase::GetExtractedAnimationDataArray() const
 {
 	FScopeLock Lock(&Mutex);
 
-	return UAzSpeechHelper::ExtractAnimationDataFromVisemeDataArray(GetVisemeDataArray());
+	TArray<FAzSpeechAnimationData> Output;
+	Output.Reserve(VisemeSegments.Num());
+
+	for (const int32 SegmentIndex : VisemeSegments)
+	{
+		Output.Add(BlendShapeMatrix.GetSegmentAnimationData(SegmentIndex));
+	}
+
+	return Output;
+}
+
+const int32 UAzSpeechSynthesizerTaskBase::GetBlendShapeFrameCount() const
+{
+	FScopeLock Lock(&Mutex);
+
+	return BlendShapeMatrix.GetNumRows();
+}
+
+const int32 UAzSpeechSynthesizerTaskBase::GetBlendShapeChannelCount() const
+{
+	FScopeLock Lock(&Mutex);
+
+	return BlendShapeMatrix.GetNumChannels();
+}
+
+const TArray<float> UAzSpeechSynthesizerTaskBase::GetBlendShapesAtTime(const float TimeInSeconds) const
+{
+	FScopeLock Lock(&Mutex);
+
+	TArray<float> Output;
+	Output.SetNumUninitialized(BlendShapeMatrix.GetNumChannels());
+
+	if (!BlendShapeMatrix.Sample(TimeInSeconds, Output))
+	{
+		Output.Empty();
+	}
+
+	return Output;
+}
+
+const bool UAzSpeechSynthesizerTaskBase::SampleBlendShapes(const float TimeInSeconds, const TArrayView<float> OutValues) const
+{
+	FScopeLock Lock(&Mutex);
+
+	return BlendShapeMatrix.Sample(TimeInSeconds, OutValues);
+}
+
+void UAzSpeechSynthesizerTaskBase::UpdateVisemeTimeline(FAzSpeechVisemeTimeline& Timeline) const
+{
+	// Called per anim instance and frame: Only lock the task when new visemes were received - Comparing the counts is only valid for a timeline filled by this task
+	if (Timeline.GetSourceTaskID() == GetUniqueID() && Timeline.GetNumVisemes() == NumVisemesReceived.load())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&Mutex);
+
+	// The timeline is reused, was filled by another task or loaded from a file: Start again
+	if (Timeline.GetSourceTaskID() != GetUniqueID())
+	{
+		Timeline.Reset();
+		Timeline.SetSourceTaskID(GetUniqueID());
+	}
+
+	const int32 NumSynced = Timeline.GetNumVisemes();
+	Timeline.Append(MakeArrayView(VisemeDataArray).Slice(NumSynced, VisemeDataArray.Num() - NumSynced), BlendShapeMatrix);
+}
+
+const TArray<FAzSpeechWordBoundaryData> UAzSpeechSynthesizerTaskBase::GetWordBoundaries() const
+{
+	FScopeLock Lock(&Mutex);
+
+	TArray<FAzSpeechWordBoundaryData> Output;
+	Output.Reserve(WordBoundaries.Num());
+
+	for (const FAzSpeechWordBoundary& Iterator : WordBoundaries)
+	{
+		Output.Emplace(Iterator, SynthesisText);
+	}
+
+	return Output;
+}
+
+const int32 UAzSpeechSynthesizerTaskBase::GetWordBoundaryCount() const
+{
+	FScopeLock Lock(&Mutex);
+
+	return WordBoundaries.Num();
+}
+
+const bool UAzSpeechSynthesizerTaskBase::FindWordBoundaryAtTime(const float TimeInSeconds, const EAzSpeechBoundaryType BoundaryType, FAzSpeechWordBoundaryData& WordBoundary) const
+{
+	FScopeLock Lock(&Mutex);
+
+	const int64 TimeInMs = static_cast<int64>(TimeInSeconds * 1000.f);
+
+	// Words are the most frequent type: The search only walks back over the punctuation and sentences received after the word
+	for (int32 Index = Algo::UpperBoundBy(WordBoundaries, TimeInMs, &FAzSpeechWordBoundary::AudioOffsetMilliseconds) - 1; Index >= 0; --Index)
+	{
+		if (WordBoundaries[Index].BoundaryType == static_cast<int32>(BoundaryType))
+		{
+			WordBoundary = FAzSpeechWordBoundaryData(WordBoundaries[Index], SynthesisText);
+			return true;
+		}
+	}
+
+	WordBoundary = FAzSpeechWordBoundaryData();
+	return false;
+}
+
+const int32 UAzSpeechSynthesizerTaskBase::CopyWordBoundaries(TArray<FAzSpeechWordBoundary>& OutBoundaries, const int32 StartIndex) const
+{
+	FScopeLock Lock(&Mutex);
+
+	if (StartIndex < 0 || StartIndex >= WordBoundaries.Num())
+	{
+		return 0;
+	}
+
+	const int32 NumCopied = WordBoundaries.Num() - StartIndex;
+	OutBoundaries.Append(WordBoundaries.GetData() + StartIndex, NumCopied);
+
+	return NumCopied;
+}
+
+const TArray<FAzSpeechBookmarkData> UAzSpeechSynthesizerTaskBase::GetBookmarks() const
+{
+	FScopeLock Lock(&Mutex);
+
+	return Bookmarks;
 }
 
 const bool UAzSpeechSynthesizerTaskBase::IsLastResultValid() const
@@ -120,7 +259,14 @@ const int32 UAzSpeechSynthesizerTaskBase::GetServiceLatency() const
 
 void UAzSpeechSynthesizerTaskBase::StartSynthesisWork(const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig)
 {
-	RunnableTask = MakeShared<FAzSpeechSynthesisRunnable>(this, InAudioConfig);
+	if (GetTaskOptions().Backend == EAzSpeechBackend::Mock)
+	{
+		RunnableTask = MakeShared<FAzSpeechMockSynthesisRunnable>(this, InAudioConfig);
+	}
+	else
+	{
+		RunnableTask = MakeShared<FAzSpeechSynthesisRunnable>(this, InAudioConfig);
+	}
 
 	if (!RunnableTask)
 	{
@@ -131,11 +277,70 @@ void UAzSpeechSynthesizerTaskBase::StartSynthesisWork(const std::shared_ptr<Micr
 	RunnableTask->StartAzSpeechRunnableTask();
 }
 
-void UAzSpeechSynthesizerTaskBase::OnVisemeReceived(const FAzSpeechVisemeData& VisemeData)
+void UAzSpeechSynthesizerTaskBase::OnCircuitOpen()
+{
+	// Called while activating the task, in the game thread
+	SynthesisFailed.Broadcast();
+}
+
+void UAzSpeechSynthesizerTaskBase::BeginDestroy()
+{
+	UpdateMemoryStats(true);
+
+	Super::BeginDestroy();
+}
+
+void UAzSpeechSynthesizerTaskBase::UpdateMemoryStats([[maybe_unused]] const bool bRelease)
+{
+#if STATS
+	const int64 AudioBytes = bRelease ? 0 : static_cast<int64>(AudioData.Num());
+	const int64 VisemeBytes = bRelease ? 0 : static_cast<int64>(VisemeDataArray.GetAllocatedSize() + VisemeSegments.GetAllocatedSize() + BlendShapeMatrix.GetAllocatedSize() + WordBoundaries.GetAllocatedSize() + Bookmarks.GetAllocatedSize()) + VisemeAnimationBytes;
+
+	if (AudioBytes > TrackedAudioBytes)
+	{
+		INC_MEMORY_STAT_BY(STAT_AzSpeech_AudioMemory, AudioBytes - TrackedAudioBytes);
+	}
+	else if (AudioBytes < TrackedAudioBytes)
+	{
+		DEC_MEMORY_STAT_BY(STAT_AzSpeech_AudioMemory, TrackedAudioBytes - AudioBytes);
+	}
+
+	if (VisemeBytes > TrackedVisemeBytes)
+	{
+		INC_MEMORY_STAT_BY(STAT_AzSpeech_VisemeMemory, VisemeBytes - TrackedVisemeBytes);
+	}
+	else if (VisemeBytes < TrackedVisemeBytes)
+	{
+		DEC_MEMORY_STAT_BY(STAT_AzSpeech_VisemeMemory, TrackedVisemeBytes - VisemeBytes);
+	}
+
+	TrackedAudioBytes = AudioBytes;
+	TrackedVisemeBytes = VisemeBytes;
+#endif
+}
+
+void UAzSpeechSynthesizerTaskBase::RecordLatencyMetrics(const FString& EndpointID) const
 {
 	FScopeLock Lock(&Mutex);
 
-	if (UAzSpeechSettings::Get()->bEnableDebuggingLogs || UAzSpeechSettings::Get()->bEnableDebuggingPrints)
+	const FName Voice = EndpointID.IsEmpty() && !GetTaskOptions().EmbeddedSynthesisVoice.IsNone() ? GetTaskOptions().EmbeddedSynthesisVoice : GetTaskOptions().VoiceName;
+
+	FAzSpeechMetricsRegistry::RecordSample(EAzSpeechLatencyMetric::Connection, Voice, EndpointID, ConnectionLatency);
+	FAzSpeechMetricsRegistry::RecordSample(EAzSpeechLatencyMetric::FirstByte, Voice, EndpointID, FirstByteLatency);
+	FAzSpeechMetricsRegistry::RecordSample(EAzSpeechLatencyMetric::Finish, Voice, EndpointID, FinishLatency);
+	FAzSpeechMetricsRegistry::RecordSample(EAzSpeechLatencyMetric::Network, Voice, EndpointID, NetworkLatency);
+	FAzSpeechMetricsRegistry::RecordSample(EAzSpeechLatencyMetric::Service, Voice, EndpointID, ServiceLatency);
+}
+
+void UAzSpeechSynthesizerTaskBase::OnVisemeReceived(const FAzSpeechVisemeData& VisemeData)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Task_OnVisemeReceived);
+	AZSPEECH_LLM_SCOPE(Visemes);
+
+	AZSPEECH_TRACE_TASK_EVENT(Viseme, GetUniqueID(), GetLastResultID().c_str());
+
+	bool bPrintDebuggingInfo = false;
+	if (IsDebuggingInfoEnabled(bPrintDebuggingInfo))
 	{
 		const FStringFormatOrderedArguments Arguments{
 			TaskName.ToString(),
@@ -151,16 +356,44 @@ void UAzSpeechSynthesizerTaskBase::OnVisemeReceived(const FAzSpeechVisemeData& V
 		UE_LOG(LogAzSpeech_Debugging, Display, TEXT("%s"), *MountedDebuggingInfo);
 
 #if !UE_BUILD_SHIPPING
-		if (UAzSpeechSettings::Get()->bEnableDebuggingPrints)
+		if (bPrintDebuggingInfo)
 		{
 			GEngine->AddOnScreenDebugMessage(static_cast<int32>(GetUniqueID()), 5.f, FColor::Yellow, MountedDebuggingInfo);
 		}
 #endif
 	}
-	
-	VisemeDataArray.Add(VisemeData);
 
-	AsyncTask(ENamedThreads::GameThread,
+	// Parsed without holding the task lock: Only the copy of the parsed frames to the task matrix is done under it
+	FAzSpeechBlendShapeMatrix SegmentBuffer;
+	int32 ParsedSegment = INDEX_NONE;
+	if (!VisemeData.Animation.IsEmpty() && !FAzSpeechAnimationParser::Parse(VisemeData.Animation, SegmentBuffer, ParsedSegment))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Failed to parse the viseme animation"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+	}
+
+	{
+		FScopeLock Lock(&Mutex);
+
+		RecordEvent(EAzSpeechLogEvent::Viseme, VisemeData.VisemeID, VisemeData.AudioOffsetMilliseconds);
+
+		int32 SegmentIndex = INDEX_NONE;
+		if (ParsedSegment != INDEX_NONE && SegmentBuffer.GetNumRows() > 0)
+		{
+			SegmentIndex = BlendShapeMatrix.AppendSegment(SegmentBuffer.GetSegments()[ParsedSegment].FrameIndex, SegmentBuffer.GetNumChannels(), SegmentBuffer.GetSegmentValues(ParsedSegment));
+			if (SegmentIndex == INDEX_NONE)
+			{
+				UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Viseme animation has %d blend shapes, expected %d"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), SegmentBuffer.GetNumChannels(), BlendShapeMatrix.GetNumChannels());
+			}
+		}
+
+		VisemeDataArray.Add(VisemeData);
+		VisemeSegments.Add(SegmentIndex);
+		NumVisemesReceived.store(VisemeDataArray.Num());
+		VisemeAnimationBytes += VisemeData.Animation.GetAllocatedSize();
+		UpdateMemoryStats();
+	}
+
+	AzSpeech::Internal::AsyncGameThreadTask(
 		[this, VisemeData]
 		{
 			VisemeReceived.Broadcast(VisemeData);
@@ -168,27 +401,67 @@ void UAzSpeechSynthesizerTaskBase::OnVisemeReceived(const FAzSpeechVisemeData& V
 	);
 }
 
-void UAzSpeechSynthesizerTaskBase::OnSynthesisUpdate(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>& LastResult)
+void UAzSpeechSynthesizerTaskBase::OnWordBoundaryReceived(const FAzSpeechWordBoundary& WordBoundary)
 {
+	AZSPEECH_LLM_SCOPE(Boundaries);
 	FScopeLock Lock(&Mutex);
 
-	ConnectionLatency = static_cast<int32>(std::stoi(LastResult->Properties.GetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisConnectionLatencyMs)));
-	FinishLatency = static_cast<int32>(std::stoi(LastResult->Properties.GetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisFinishLatencyMs)));
-	FirstByteLatency = static_cast<int32>(std::stoi(LastResult->Properties.GetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisFirstByteLatencyMs)));
-	NetworkLatency = static_cast<int32>(std::stoi(LastResult->Properties.GetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisNetworkLatencyMs)));
-	ServiceLatency = static_cast<int32>(std::stoi(LastResult->Properties.GetProperty(Microsoft::CognitiveServices::Speech::PropertyId::SpeechServiceResponse_SynthesisServiceLatencyMs)));
+	RecordEvent(EAzSpeechLogEvent::WordBoundary, WordBoundary.TextOffset, WordBoundary.AudioOffsetMilliseconds);
+
+	// The boundaries are received in order: Inserting in the middle only happens with unordered events
+	if (WordBoundaries.Num() == 0 || WordBoundaries.Last().AudioOffsetMilliseconds <= WordBoundary.AudioOffsetMilliseconds)
+	{
+		WordBoundaries.Add(WordBoundary);
+	}
+	else
+	{
+		WordBoundaries.Insert(WordBoundary, Algo::UpperBoundBy(WordBoundaries, WordBoundary.AudioOffsetMilliseconds, &FAzSpeechWordBoundary::AudioOffsetMilliseconds));
+	}
+
+	UpdateMemoryStats();
+}
+
+void UAzSpeechSynthesizerTaskBase::OnBookmarkReached(const FAzSpeechBookmarkData& BookmarkData)
+{
+	AZSPEECH_LLM_SCOPE(Boundaries);
+	FScopeLock Lock(&Mutex);
+
+	RecordEvent(EAzSpeechLogEvent::Bookmark, Bookmarks.Num(), BookmarkData.AudioOffsetMilliseconds);
+
+	UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Bookmark '%s' reached at %lldms"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), *BookmarkData.Name, BookmarkData.AudioOffsetMilliseconds);
+
+	Bookmarks.Insert(BookmarkData, Algo::UpperBoundBy(Bookmarks, BookmarkData.AudioOffsetMilliseconds, &FAzSpeechBookmarkData::AudioOffsetMilliseconds));
+	UpdateMemoryStats();
+}
+
+void UAzSpeechSynthesizerTaskBase::OnSynthesisUpdate(const FAzSpeechSynthesisResultData& LastResult)
+{
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Task_OnSynthesisUpdate);
+	AZSPEECH_LLM_SCOPE(Audio);
+	FScopeLock Lock(&Mutex);
+
+	SetLastResultID(LastResult.ResultID);
+	ConnectionLatency = LastResult.ConnectionLatencyMs;
+	FinishLatency = LastResult.FinishLatencyMs;
+	FirstByteLatency = LastResult.FirstByteLatencyMs;
+	NetworkLatency = LastResult.NetworkLatencyMs;
+	ServiceLatency = LastResult.ServiceLatencyMs;
+
+	const uint32 AudioSize = LastResult.AudioData ? static_cast<uint32>(LastResult.AudioData->size()) : 0u;
+	RecordEvent(EAzSpeechLogEvent::AudioChunk, static_cast<int32>(AudioSize), LastResult.AudioDurationTicks);
 	
-	if (UAzSpeechSettings::Get()->bEnableDebuggingLogs || UAzSpeechSettings::Get()->bEnableDebuggingPrints)
+	bool bPrintDebuggingInfo = false;
+	if (IsDebuggingInfoEnabled(bPrintDebuggingInfo))
 	{
 		const FStringFormatOrderedArguments Arguments{
 			TaskName.ToString(),
 			GetUniqueID(),
 			FString(__func__),
-			static_cast<int64>(LastResult->AudioDuration.count()),
-			static_cast<uint32>(LastResult->GetAudioLength()),
-			static_cast<uint32>(LastResult->GetAudioData().get()->size()),
-			static_cast<int32>(LastResult->Reason),
-			UTF8_TO_TCHAR(LastResult->ResultId.c_str()),
+			LastResult.AudioDurationTicks,
+			AudioSize,
+			AudioSize,
+			static_cast<int32>(LastResult.Reason),
+			UTF8_TO_TCHAR(LastResult.ResultID.c_str()),
 			ConnectionLatency,
 			FinishLatency,
 			FirstByteLatency,
@@ -201,17 +474,26 @@ void UAzSpeechSynthesizerTaskBase::OnSynthesisUpdate(const std::shared_ptr<Micro
 		UE_LOG(LogAzSpeech_Debugging, Display, TEXT("%s"), *MountedDebuggingInfo);
 
 #if !UE_BUILD_SHIPPING
-		if (UAzSpeechSettings::Get()->bEnableDebuggingPrints)
+		if (bPrintDebuggingInfo)
 		{
 			GEngine->AddOnScreenDebugMessage(static_cast<int32>(GetUniqueID()), 5.f, FColor::Yellow, MountedDebuggingInfo);
 		}
 #endif
 	}
 
-	AudioData = *LastResult->GetAudioData().get();
-	bLastResultIsValid = !AudioData.empty();
+	if (AudioData.IsEmpty() && AudioSize > 0u)
+	{
+		AZSPEECH_TRACE_TASK_EVENT(FirstAudioByte, GetUniqueID(), LastResult.ResultID.c_str());
+	}
+
+	// Shares the buffer of the SDK result instead of copying it
+	AudioData = FAzSpeechAudioBuffer(LastResult.AudioData);
+
+	UpdateMemoryStats();
+
+	bLastResultIsValid = !AudioData.IsEmpty();
 
-	AsyncTask(ENamedThreads::GameThread,
+	AzSpeech::Internal::AsyncGameThreadTask(
 		[this]
 		{
 			SynthesisUpdated.Broadcast();
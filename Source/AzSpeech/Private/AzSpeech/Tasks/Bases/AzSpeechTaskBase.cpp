@@ -4,6 +4,7 @@
 
 #include "AzSpeech/Tasks/Bases/AzSpeechTaskBase.h"
 #include "AzSpeech/Runnables/Bases/AzSpeechRunnableBase.h"
+#include "AzSpeech/Managers/AzSpeechCircuitBreaker.h"
 #include "AzSpeech/AzSpeechHelper.h"
 #include "LogAzSpeech.h"
 
@@ -15,8 +16,31 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AzSpeechTaskBase)
 #endif
 
+void UAzSpeechTaskBase::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		INC_DWORD_STAT(STAT_AzSpeech_TaskObjects);
+	}
+}
+
+void UAzSpeechTaskBase::BeginDestroy()
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		DEC_DWORD_STAT(STAT_AzSpeech_TaskObjects);
+	}
+
+	Super::BeginDestroy();
+}
+
 void UAzSpeechTaskBase::Activate()
 {
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Task_Activate);
+	AZSPEECH_LLM_SCOPE(Tasks);
+
 #if PLATFORM_ANDROID
 	if (!UAzSpeechHelper::CheckAndroidPermission("android.permission.INTERNET"))
 	{
@@ -32,6 +56,14 @@ void UAzSpeechTaskBase::Activate()
 	TaskName = *NewTaskName;
 
 	UE_LOG(LogAzSpeech, Display, TEXT("Task: %s (%d); Function: %s; Message: Activating task"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+	AZSPEECH_TRACE_TASK_EVENT(Activate, GetUniqueID());
+
+	// Created before starting the runnable: The SDK threads only record in the existing buffer
+	if (UAzSpeechSettings::Get()->bEnableFailureEventLog)
+	{
+		EventLog = MakeUnique<FAzSpeechEventLog>();
+		RecordEvent(EAzSpeechLogEvent::Activate);
+	}
 
 	bIsTaskActive = true;
 	
@@ -60,6 +92,7 @@ void UAzSpeechTaskBase::StopAzSpeechTask()
 	}
 
 	UE_LOG(LogAzSpeech, Display, TEXT("Task: %s (%d); Function: %s; Message: Stopping task"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+	RecordEvent(EAzSpeechLogEvent::Stop);
 	bIsTaskActive = false;
 
 	if (RunnableTask)
@@ -85,8 +118,48 @@ const FAzSpeechSettingsOptions UAzSpeechTaskBase::GetTaskOptions() const
 	return TaskOptions;
 }
 
+const bool UAzSpeechTaskBase::IsUsingFallbackBackend() const
+{
+	return bIsUsingFallbackBackend.load();
+}
+
+const std::string UAzSpeechTaskBase::GetLastResultID() const
+{
+	FScopeLock Lock(&Mutex);
+
+	return LastResultID;
+}
+
+void UAzSpeechTaskBase::SetLastResultID(const std::string& InResultID)
+{
+	if (InResultID.empty())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&Mutex);
+	LastResultID = InResultID;
+}
+
+void UAzSpeechTaskBase::RecordEvent(const EAzSpeechLogEvent Event, const int32 Value0, const int64 Value1) const
+{
+	if (EventLog)
+	{
+		EventLog->Record(Event, Value0, Value1);
+	}
+}
+
+void UAzSpeechTaskBase::FlushEventLog(const FString& Reason) const
+{
+	if (EventLog)
+	{
+		EventLog->Flush(TaskName.ToString(), GetUniqueID(), Reason);
+	}
+}
+
 void UAzSpeechTaskBase::SetReadyToDestroy()
 {
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Task_SetReadyToDestroy);
 	FScopeLock Lock(&Mutex);
 
 	if (UAzSpeechTaskStatus::IsTaskReadyToDestroy(this))
@@ -95,6 +168,7 @@ void UAzSpeechTaskBase::SetReadyToDestroy()
 	}
 
 	UE_LOG(LogAzSpeech, Display, TEXT("Task: %s (%d); Function: %s; Message: Setting task as Ready to Destroy"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+	AZSPEECH_TRACE_TASK_EVENT(Teardown, GetUniqueID(), LastResultID.c_str());
 	bIsReadyToDestroy = true;
 
 #if WITH_EDITOR
@@ -116,7 +190,28 @@ bool UAzSpeechTaskBase::StartAzureTaskWork()
 {
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Task: %s (%d); Function: %s; Message: Starting Azure SDK task"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
 
-	return UAzSpeechSettings::CheckAzSpeechSettings() && UAzSpeechTaskStatus::IsTaskStillValid(this);
+	if (!UAzSpeechSettings::CheckAzSpeechSettings(GetTaskOptions()) || !UAzSpeechTaskStatus::IsTaskStillValid(this))
+	{
+		return false;
+	}
+
+	// Fail immediately while the service is down instead of creating the SDK objects and the thread to wait for the timeout
+	if (GetTaskOptions().RequiresCloudBackend() && !FAzSpeechCircuitBreaker::CanRequestAny(GetTaskOptions().GetCandidateEndpoints()))
+	{
+		UE_LOG(LogAzSpeech, Warning, TEXT("Task: %s (%d); Function: %s; Message: Circuit of all endpoints is open, failing task"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+		OnCircuitOpen();
+		return false;
+	}
+
+	return true;
+}
+
+void UAzSpeechTaskBase::OnCircuitOpen()
+{
+}
+
+void UAzSpeechTaskBase::RecordLatencyMetrics([[maybe_unused]] const FString& EndpointID) const
+{
 }
 
 void UAzSpeechTaskBase::BroadcastFinalResult()
@@ -129,6 +224,8 @@ void UAzSpeechTaskBase::BroadcastFinalResult()
 	}
 	
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Task: %s (%d); Function: %s; Message: Task completed, broadcasting final result"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+	AZSPEECH_TRACE_TASK_EVENT(FinalResult, GetUniqueID(), LastResultID.c_str());
+	RecordEvent(EAzSpeechLogEvent::FinalResult);
 
 	bIsTaskActive = false;
 }
@@ -148,6 +245,17 @@ void UAzSpeechTaskBase::PrePIEEnded(bool bIsSimulating)
 }
 #endif
 
+const bool UAzSpeechTaskBase::IsDebuggingInfoEnabled(bool& bOutPrintToScreen)
+{
+#if UE_BUILD_SHIPPING
+	bOutPrintToScreen = false;
+#else
+	bOutPrintToScreen = UAzSpeechSettings::Get()->bEnableDebuggingPrints;
+#endif
+
+	return bOutPrintToScreen || UE_LOG_ACTIVE(LogAzSpeech_Debugging, Display);
+}
+
 FAzSpeechSettingsOptions UAzSpeechTaskBase::GetValidatedOptions(const FAzSpeechSettingsOptions& Options)
 {
 	FAzSpeechSettingsOptions Output = Options;
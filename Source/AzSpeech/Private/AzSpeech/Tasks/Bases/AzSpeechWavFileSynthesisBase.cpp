@@ -6,6 +6,7 @@
 #include "AzSpeech/AzSpeechHelper.h"
 #include "LogAzSpeech.h"
 #include <HAL/FileManager.h>
+#include <Misc/FileHelper.h>
 #include <Async/Async.h>
 
 #ifdef UE_INLINE_GENERATED_CPP_BY_NAME
@@ -66,12 +67,22 @@ void UAzSpeechWavFileSynthesisBase::BroadcastFinalResult()
 		return;
 	}
 
+	// With the embedded fallback or request hedging, the file is written from the result of the attempt that answered first
+	if (WritesFileFromResult() && IsLastResultValid())
+	{
+		const FString Full_FileName = UAzSpeechHelper::QualifyWAVFileName(FilePath, FileName);
+		if (!FFileHelper::SaveArrayToFile(GetAudioBuffer().GetView(), *Full_FileName))
+		{
+			UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Failed to write file '%s'"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), *Full_FileName);
+		}
+	}
+
 	Super::BroadcastFinalResult();
 
-	AsyncTask(ENamedThreads::GameThread,
+	AzSpeech::Internal::AsyncGameThreadTask(GetUniqueID(), GetLastResultID(),
 		[this]
 		{
-			SynthesisCompleted.Broadcast(IsLastResultValid() && UAzSpeechHelper::IsAudioDataValid(GetAudioData()));
+			SynthesisCompleted.Broadcast(IsLastResultValid() && !GetAudioBuffer().IsEmpty());
 		}
 	);
 }
@@ -93,8 +104,21 @@ bool UAzSpeechWavFileSynthesisBase::StartAzureTaskWork()
 		return false;
 	}
 
+	// Two attempts can't write to the same file: with the embedded fallback or request hedging, the file is written when the final result is received
+	if (WritesFileFromResult())
+	{
+		StartSynthesisWork(Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromStreamOutput(Microsoft::CognitiveServices::Speech::Audio::AudioOutputStream::CreatePullStream()));
+		return true;
+	}
+
 	const auto AudioConfig = Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromWavFileOutput(TCHAR_TO_UTF8(*UAzSpeechHelper::QualifyWAVFileName(FilePath, FileName)));
 	StartSynthesisWork(AudioConfig);
 
 	return true;
 }
+
+const bool UAzSpeechWavFileSynthesisBase::WritesFileFromResult() const
+{
+	// The mock backend doesn't use the SDK audio output
+	return GetTaskOptions().UsesEmbeddedFallback() || GetTaskOptions().UsesRequestHedging() || GetTaskOptions().Backend == EAzSpeechBackend::Mock;
+}
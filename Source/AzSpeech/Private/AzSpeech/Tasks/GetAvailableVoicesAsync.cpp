@@ -9,12 +9,52 @@
 
 THIRD_PARTY_INCLUDES_START
 #include <speechapi_cxx_speech_synthesizer.h>
+#include <speechapi_cxx_embedded_speech_config.h>
 THIRD_PARTY_INCLUDES_END
 
 #ifdef UE_INLINE_GENERATED_CPP_BY_NAME
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GetAvailableVoicesAsync)
 #endif
 
+namespace AzSpeech::Internal
+{
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer> CreateVoicesSynthesizer()
+	{
+		const FAzSpeechSettingsOptions& Options = UAzSpeechSettings::Get()->DefaultOptions;
+
+		// Embedded backends list the voices available in the local models
+		if (Options.Backend == EAzSpeechBackend::Embedded)
+		{
+			std::vector<std::string> ModelPaths;
+			for (const FString& Iterator : Options.GetQualifiedEmbeddedModelPaths())
+			{
+				ModelPaths.push_back(TCHAR_TO_UTF8(*Iterator));
+			}
+
+			if (ModelPaths.empty())
+			{
+				UE_LOG(LogAzSpeech_Internal, Error, TEXT("%s: No embedded model paths were specified"), *FString(__func__));
+				return nullptr;
+			}
+
+			if (const auto EmbeddedConfig = Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig::FromPaths(ModelPaths))
+			{
+				return Microsoft::CognitiveServices::Speech::SpeechSynthesizer::FromConfig(EmbeddedConfig, nullptr);
+			}
+
+			return nullptr;
+		}
+
+		const auto Settings = UAzSpeechSettings::GetAzSpeechKeys();
+		if (const auto SpeechConfig = Microsoft::CognitiveServices::Speech::SpeechConfig::FromSubscription(Settings.at(AZSPEECH_KEY_SUBSCRIPTION), Settings.at(AZSPEECH_KEY_REGION)))
+		{
+			return Microsoft::CognitiveServices::Speech::SpeechSynthesizer::FromConfig(SpeechConfig);
+		}
+
+		return nullptr;
+	}
+}
+
 UGetAvailableVoicesAsync* UGetAvailableVoicesAsync::GetAvailableVoicesAsync(UObject* WorldContextObject, const FString& Locale)
 {
 	UGetAvailableVoicesAsync* const NewAsyncTask = NewObject<UGetAvailableVoicesAsync>();
@@ -42,7 +82,7 @@ void UGetAvailableVoicesAsync::Activate()
 		[this]
 		{
 			const TArray<FString> TaskResult = GetAvailableVoices();
-			AsyncTask(ENamedThreads::GameThread, 
+			AzSpeech::Internal::AsyncGameThreadTask(
 				[this, TaskResult] 
 				{ 
 					BroadcastResult(TaskResult); 
@@ -91,24 +131,20 @@ const TArray<FString> UGetAvailableVoicesAsync::GetAvailableVoices() const
 {
 	TArray<FString> Output;
 
-	const auto Settings = UAzSpeechSettings::GetAzSpeechKeys();
-	if (const auto SpeechConfig = Microsoft::CognitiveServices::Speech::SpeechConfig::FromSubscription(Settings.at(0), Settings.at(1)))
+	if (std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer> SpeechSynthesizer = AzSpeech::Internal::CreateVoicesSynthesizer())
 	{
-		if (std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer> SpeechSynthesizer = Microsoft::CognitiveServices::Speech::SpeechSynthesizer::FromConfig(SpeechConfig))
+		const auto SynthesisVoices = SpeechSynthesizer->GetVoicesAsync(TCHAR_TO_UTF8(*Locale)).get();
+		for (const auto& Voice : SynthesisVoices->Voices)
 		{
-			const auto SynthesisVoices = SpeechSynthesizer->GetVoicesAsync(TCHAR_TO_UTF8(*Locale)).get();
-			for (const auto& Voice : SynthesisVoices->Voices)
-			{
-				UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Name: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->Name.c_str()));
-				UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Short Name: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->ShortName.c_str()));
-				UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Local Name: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->LocalName.c_str()));
-				UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Path: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->VoicePath.c_str()));
-				UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Locale: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->Locale.c_str()));
-				UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Gender: %d"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), Voice->Gender);
-				UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Type: %d"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), Voice->VoiceType);
-
-				Output.Add(UTF8_TO_TCHAR(Voice->ShortName.c_str()));
-			}
+			UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Name: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->Name.c_str()));
+			UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Short Name: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->ShortName.c_str()));
+			UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Local Name: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->LocalName.c_str()));
+			UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Path: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->VoicePath.c_str()));
+			UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Locale: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(Voice->Locale.c_str()));
+			UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Gender: %d"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), Voice->Gender);
+			UE_LOG(LogAzSpeech_Debugging, Display, TEXT("Task: %s (%d); Function: %s; Message: Voice Type: %d"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), Voice->VoiceType);
+
+			Output.Add(UTF8_TO_TCHAR(Voice->ShortName.c_str()));
 		}
 	}
 
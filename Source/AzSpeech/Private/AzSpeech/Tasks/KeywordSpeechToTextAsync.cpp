@@ -0,0 +1,213 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeech/Tasks/KeywordSpeechToTextAsync.h"
+#include "AzSpeech/AzSpeechHelper.h"
+#include <Misc/Paths.h>
+#include <HAL/FileManager.h>
+#include <Async/Async.h>
+
+THIRD_PARTY_INCLUDES_START
+#include <speechapi_cxx_keyword_recognition_model.h>
+THIRD_PARTY_INCLUDES_END
+
+#ifdef UE_INLINE_GENERATED_CPP_BY_NAME
+#include UE_INLINE_GENERATED_CPP_BY_NAME(KeywordSpeechToTextAsync)
+#endif
+
+UKeywordSpeechToTextAsync* UKeywordSpeechToTextAsync::KeywordSpeechToText_DefaultOptions(UObject* WorldContextObject, const FString& KeywordModelPath, const FString& LanguageID, const FString& AudioInputDeviceID, const FName PhraseListGroup)
+{
+	return KeywordSpeechToText_CustomOptions(WorldContextObject, KeywordModelPath, FAzSpeechSettingsOptions(*LanguageID), AudioInputDeviceID, PhraseListGroup);
+}
+
+UKeywordSpeechToTextAsync* UKeywordSpeechToTextAsync::KeywordSpeechToText_CustomOptions(UObject* WorldContextObject, const FString& KeywordModelPath, const FAzSpeechSettingsOptions& Options, const FString& AudioInputDeviceID, const FName PhraseListGroup)
+{
+	UKeywordSpeechToTextAsync* const NewAsyncTask = NewObject<UKeywordSpeechToTextAsync>();
+	NewAsyncTask->WorldContextObject = WorldContextObject;
+	NewAsyncTask->TaskOptions = GetValidatedOptions(Options);
+	NewAsyncTask->KeywordModelPath = KeywordModelPath;
+	NewAsyncTask->AudioInputDeviceID = AudioInputDeviceID;
+	NewAsyncTask->PhraseListGroup = PhraseListGroup;
+	NewAsyncTask->bIsSSMLBased = false;
+	NewAsyncTask->TaskName = *FString(__func__);
+	NewAsyncTask->RegisterWithGameInstance(WorldContextObject);
+
+	return NewAsyncTask;
+}
+
+void UKeywordSpeechToTextAsync::SetReadyToDestroy()
+{
+	StopKeywordRecognition();
+
+	Super::SetReadyToDestroy();
+}
+
+bool UKeywordSpeechToTextAsync::StartAudioInputWork()
+{
+	const FString QualifiedPath = FPaths::ConvertRelativePathToFull(KeywordModelPath);
+	if (AzSpeech::Internal::HasEmptyParam(KeywordModelPath) || !IFileManager::Get().FileExists(*QualifiedPath))
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Keyword model '%s' not found"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), *QualifiedPath);
+		return false;
+	}
+
+	SharedAudioCapture = FAzSpeechSharedAudioCapture::FindOrCreate(IsUsingDefaultAudioInputDevice() ? FString() : AudioInputDeviceID);
+	if (!SharedAudioCapture.IsValid())
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Failed to get the shared audio capture"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+		return false;
+	}
+
+	const auto KeywordModel = Microsoft::CognitiveServices::Speech::KeywordRecognitionModel::FromFile(TCHAR_TO_UTF8(*QualifiedPath));
+	if (!KeywordModel)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Failed to load keyword model '%s'"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), *QualifiedPath);
+		return false;
+	}
+
+	KeywordCaptureListener = SharedAudioCapture->AddListener();
+	KeywordStartSample = KeywordCaptureListener->GetStartSample();
+
+	KeywordRecognizer = Microsoft::CognitiveServices::Speech::KeywordRecognizer::FromConfig(KeywordCaptureListener->CreateAudioConfig());
+	if (!KeywordRecognizer)
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Failed to create keyword recognizer"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+		return false;
+	}
+
+	// The signals are disconnected before the task is destroyed, but a callback can still be running at that moment
+	KeywordRecognizer->Recognized.Connect([this](const Microsoft::CognitiveServices::Speech::KeywordRecognitionEventArgs& RecognitionEventArgs)
+	{
+		if (!UAzSpeechTaskStatus::IsTaskStillValid(this))
+		{
+			return;
+		}
+
+		if (RecognitionEventArgs.Result->Reason == Microsoft::CognitiveServices::Speech::ResultReason::RecognizedKeyword)
+		{
+			OnKeywordRecognized(RecognitionEventArgs.Result);
+		}
+	});
+
+	KeywordRecognizer->Canceled.Connect([this](const Microsoft::CognitiveServices::Speech::SpeechRecognitionCanceledEventArgs& CanceledEventArgs)
+	{
+		if (!UAzSpeechTaskStatus::IsTaskStillValid(this) || CanceledEventArgs.Reason != Microsoft::CognitiveServices::Speech::CancellationReason::Error)
+		{
+			return;
+		}
+
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Keyword recognition canceled with error: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), UTF8_TO_TCHAR(CanceledEventArgs.ErrorDetails.c_str()));
+
+		AzSpeech::Internal::AsyncGameThreadTask(
+			[this]
+			{
+				if (!UAzSpeechTaskStatus::IsTaskStillValid(this))
+				{
+					return;
+				}
+
+				RecognitionFailed.Broadcast();
+				SetReadyToDestroy();
+			}
+		);
+	});
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Task: %s (%d); Function: %s; Message: Waiting for keyword from model '%s'"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), *QualifiedPath);
+
+	KeywordRecognitionFuture = KeywordRecognizer->RecognizeOnceAsync(KeywordModel);
+
+	return true;
+}
+
+bool UKeywordSpeechToTextAsync::UseSharedAudioCapture() const
+{
+	// The audio captured after the keyword is only available through the shared capture history
+	return true;
+}
+
+void UKeywordSpeechToTextAsync::OnKeywordRecognized(const std::shared_ptr<Microsoft::CognitiveServices::Speech::KeywordRecognitionResult>& KeywordResult)
+{
+	// Result offsets are in ticks of 100 nanoseconds, relative to the first sample written to the keyword listener
+	constexpr uint64 TicksPerSample = 10000000u / FAzSpeechSharedAudioCapture::OutputSampleRate;
+	const uint64 KeywordEndSample = KeywordStartSample + (KeywordResult->Offset() + KeywordResult->Duration()) / TicksPerSample;
+
+	const FString Keyword = UTF8_TO_TCHAR(KeywordResult->Text.c_str());
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Task: %s (%d); Function: %s; Message: Keyword '%s' recognized, ending at sample %llu"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), *Keyword, KeywordEndSample);
+
+	AzSpeech::Internal::AsyncGameThreadTask(
+		[this, Keyword, KeywordEndSample]
+		{
+			if (!UAzSpeechTaskStatus::IsTaskStillValid(this))
+			{
+				return;
+			}
+
+			KeywordRecognized.Broadcast(Keyword);
+
+			// The task could be stopped by the keyword callback
+			if (!UAzSpeechTaskStatus::IsTaskStillValid(this) || !SharedAudioCapture.IsValid() || !KeywordCaptureListener.IsValid())
+			{
+				return;
+			}
+
+			SharedAudioCapture->RemoveListener(KeywordCaptureListener);
+			KeywordCaptureListener.Reset();
+
+			// Send everything captured since the keyword ended, so the start of the command isn't lost while the cloud session is created
+			const auto AudioConfig = CreateSharedCaptureAudioConfigFromSample(KeywordEndSample);
+			if (!AudioConfig)
+			{
+				RecognitionFailed.Broadcast();
+				SetReadyToDestroy();
+				return;
+			}
+
+			StartRecognitionWork(AudioConfig);
+		}
+	);
+}
+
+void UKeywordSpeechToTextAsync::StopKeywordRecognition()
+{
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::KeywordRecognizer> RecognizerToStop;
+	std::future<std::shared_ptr<Microsoft::CognitiveServices::Speech::KeywordRecognitionResult>> FutureToWait;
+	{
+		FScopeLock Lock(&Mutex);
+
+		if (SharedAudioCapture.IsValid() && KeywordCaptureListener.IsValid())
+		{
+			SharedAudioCapture->RemoveListener(KeywordCaptureListener);
+		}
+
+		KeywordCaptureListener.Reset();
+		RecognizerToStop = KeywordRecognizer;
+		FutureToWait = std::move(KeywordRecognitionFuture);
+		KeywordRecognizer = nullptr;
+	}
+
+	if (!RecognizerToStop)
+	{
+		return;
+	}
+
+	RecognizerToStop->Recognized.DisconnectAll();
+	RecognizerToStop->Canceled.DisconnectAll();
+
+	// This can be called from the game thread or with the task lock held by the runnable exit: Wait for the recognizer in a background thread, which keeps it alive until it stops
+	const int32 TimeOutInSeconds = FMath::Max(UAzSpeechSettings::Get()->TimeOutInSeconds, 1);
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+		[RecognizerToStop, RecognitionFuture = std::move(FutureToWait), TimeOutInSeconds]
+		{
+			const std::chrono::seconds Timeout(TimeOutInSeconds);
+			RecognizerToStop->StopRecognitionAsync().wait_for(Timeout);
+
+			if (RecognitionFuture.valid())
+			{
+				RecognitionFuture.wait_for(Timeout);
+			}
+		}
+	);
+}
@@ -35,7 +35,7 @@ void URecognitionMapCheckAsync::Activate()
 		[this]
 		{
 			const int32 TaskResult = CheckRecognitionResult();
-			AsyncTask(ENamedThreads::GameThread, 
+			AzSpeech::Internal::AsyncGameThreadTask(
 				[this, TaskResult] 
 				{ 
 					BroadcastResult(TaskResult); 
@@ -82,6 +82,8 @@ void URecognitionMapCheckAsync::BroadcastResult(const int32 Result)
 
 const int32 URecognitionMapCheckAsync::CheckRecognitionResult() const
 {
+	AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_Task_CheckRecognitionResult);
+
 	if (AzSpeech::Internal::HasEmptyParam(InputString, GroupName))
 	{
 		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Invalid input string or group name"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
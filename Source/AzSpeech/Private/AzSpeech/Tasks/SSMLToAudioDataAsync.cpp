@@ -38,7 +38,7 @@ void USSMLToAudioDataAsync::BroadcastFinalResult()
 
 	Super::BroadcastFinalResult();
 
-	AsyncTask(ENamedThreads::GameThread,
+	AzSpeech::Internal::AsyncGameThreadTask(GetUniqueID(), GetLastResultID(),
 		[this]
 		{
 			SynthesisCompleted.Broadcast(GetAudioData());
@@ -4,6 +4,7 @@
 
 #include "AzSpeech/Tasks/SpeechToTextAsync.h"
 #include "AzSpeech/AzSpeechHelper.h"
+#include "AzSpeech/Audio/AzSpeechVoiceActivityDetector.h"
 
 #ifdef UE_INLINE_GENERATED_CPP_BY_NAME
 #include UE_INLINE_GENERATED_CPP_BY_NAME(SpeechToTextAsync)
@@ -67,9 +68,172 @@ bool USpeechToTextAsync::StartAzureTaskWork()
 	}
 
 	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Task: %s (%d); Function: %s; Message: Using audio input device: %s"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), IsUsingDefaultAudioInputDevice() ? *FString("Default") : *DeviceInfo.GetAudioInputDeviceEndpointID());
-	
-	const auto AudioConfig = IsUsingDefaultAudioInputDevice() ? Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromDefaultMicrophoneInput() : Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromMicrophoneInput(TCHAR_TO_UTF8(*DeviceInfo.GetAudioInputDeviceEndpointID()));
+
+	return StartAudioInputWork();
+}
+
+bool USpeechToTextAsync::StartAudioInputWork()
+{
+	const auto AudioConfig = CreateAudioConfig();
+	if (!AudioConfig)
+	{
+		return false;
+	}
+
 	StartRecognitionWork(AudioConfig);
 
 	return true;
 }
+
+void USpeechToTextAsync::SetReadyToDestroy()
+{
+	ReleaseSharedCapture();
+
+	Super::SetReadyToDestroy();
+}
+
+bool USpeechToTextAsync::UseSharedAudioCapture() const
+{
+	// The embedded fallback replays the audio already sent to the cloud from the shared capture history
+	return UAzSpeechSettings::Get()->bUseSharedAudioCapture || GetTaskOptions().UsesEmbeddedFallback();
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> USpeechToTextAsync::CreateAudioConfig(const int32 PreRollSamples)
+{
+	if (PreRollSamples > 0 || UseSharedAudioCapture())
+	{
+		return CreateSharedCaptureAudioConfig(PreRollSamples);
+	}
+
+	if (IsUsingDefaultAudioInputDevice())
+	{
+		return Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromDefaultMicrophoneInput();
+	}
+
+	const FAzSpeechAudioInputDeviceInfo DeviceInfo = UAzSpeechHelper::GetAudioInputDeviceInfoFromID(AudioInputDeviceID);
+	return Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromMicrophoneInput(TCHAR_TO_UTF8(*DeviceInfo.GetAudioInputDeviceEndpointID()));
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> USpeechToTextAsync::CreateSharedCaptureAudioConfig(const int32 PreRollSamples)
+{
+	if (!CreateSharedCaptureListener())
+	{
+		return nullptr;
+	}
+
+	SharedAudioCapture->AddListener(AudioCaptureListener, PreRollSamples);
+
+	return AudioCaptureListener->CreateAudioConfig();
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> USpeechToTextAsync::CreateSharedCaptureAudioConfigFromSample(const uint64 StartSample)
+{
+	if (!CreateSharedCaptureListener())
+	{
+		return nullptr;
+	}
+
+	SharedAudioCapture->AddListenerFromSample(AudioCaptureListener, StartSample);
+
+	return AudioCaptureListener->CreateAudioConfig();
+}
+
+bool USpeechToTextAsync::CreateSharedCaptureListener()
+{
+	SharedAudioCapture = FAzSpeechSharedAudioCapture::FindOrCreate(IsUsingDefaultAudioInputDevice() ? FString() : AudioInputDeviceID);
+	if (!SharedAudioCapture.IsValid())
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Failed to get the shared audio capture"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+		return false;
+	}
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Task: %s (%d); Function: %s; Message: Using shared audio capture"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+
+	// The voice activity detection options are only editable with the shared audio capture enabled: Captures opened for the embedded fallback ignore them
+	const UAzSpeechSettings* const Settings = UAzSpeechSettings::Get();
+	if (Settings->bUseSharedAudioCapture && Settings->VoiceActivityDetection.bEnableVoiceActivityDetection)
+	{
+		AudioCaptureListener = CreateVoiceActivityListener();
+	}
+	else
+	{
+		AudioCaptureListener = MakeShared<FAzSpeechAudioCaptureListener, ESPMode::ThreadSafe>();
+	}
+
+	return true;
+}
+
+FAzSpeechAudioCaptureListenerPtr USpeechToTextAsync::CreateVoiceActivityListener()
+{
+	const UAzSpeechSettings* const Settings = UAzSpeechSettings::Get();
+
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Task: %s (%d); Function: %s; Message: Using local voice activity detection"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+
+	// Slightly above the segmentation timeout so the service can finalize the current phrase once the local detector finds the speech end
+	const TSharedPtr<FAzSpeechVoiceActivityListener, ESPMode::ThreadSafe> NewListener = MakeShared<FAzSpeechVoiceActivityListener, ESPMode::ThreadSafe>(Settings->VoiceActivityDetection, Settings->SegmentationSilenceTimeoutMs + 100);
+
+	// Called from the capture thread: listeners are removed before the task is destroyed, but the game thread callbacks can still run after it
+	const TWeakObjectPtr<USpeechToTextAsync> WeakThis(this);
+
+	NewListener->OnSpeechStarted = [WeakThis]
+	{
+		AzSpeech::Internal::AsyncGameThreadTask(
+			[WeakThis]
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->SpeechStarted.Broadcast();
+				}
+			}
+		);
+	};
+
+	NewListener->OnSpeechEnded = [WeakThis]
+	{
+		AzSpeech::Internal::AsyncGameThreadTask(
+			[WeakThis]
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->SpeechEnded.Broadcast();
+				}
+			}
+		);
+	};
+
+	return NewListener;
+}
+
+void USpeechToTextAsync::ReleaseSharedCapture()
+{
+	FScopeLock Lock(&Mutex);
+
+	if (SharedAudioCapture.IsValid())
+	{
+		SharedAudioCapture->RemoveListener(AudioCaptureListener);
+		SharedAudioCapture->RemoveListener(FallbackCaptureListener);
+	}
+
+	AudioCaptureListener.Reset();
+	FallbackCaptureListener.Reset();
+	SharedAudioCapture.Reset();
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> USpeechToTextAsync::CreateFallbackAudioConfig()
+{
+	FScopeLock Lock(&Mutex);
+
+	if (!SharedAudioCapture.IsValid() || !AudioCaptureListener.IsValid())
+	{
+		UE_LOG(LogAzSpeech_Internal, Error, TEXT("Task: %s (%d); Function: %s; Message: Embedded fallback requires the shared audio capture"), *TaskName.ToString(), GetUniqueID(), *FString(__func__));
+		return nullptr;
+	}
+
+	// Replay everything the cloud recognizer already received, limited by the capture history
+	UE_LOG(LogAzSpeech_Internal, Display, TEXT("Task: %s (%d); Function: %s; Message: Creating fallback audio input starting at sample %llu"), *TaskName.ToString(), GetUniqueID(), *FString(__func__), AudioCaptureListener->GetStartSample());
+
+	FallbackCaptureListener = MakeShared<FAzSpeechAudioCaptureListener, ESPMode::ThreadSafe>();
+	SharedAudioCapture->AddListenerFromSample(FallbackCaptureListener, AudioCaptureListener->GetStartSample());
+
+	return FallbackCaptureListener->CreateAudioConfig();
+}
@@ -40,11 +40,10 @@ void UTextToSoundWaveAsync::BroadcastFinalResult()
 
 	Super::BroadcastFinalResult();
 
-	AsyncTask(ENamedThreads::GameThread,
+	AzSpeech::Internal::AsyncGameThreadTask(GetUniqueID(), GetLastResultID(),
 		[this]
 		{
-			const TArray<uint8> LastBuffer = GetAudioData();
-			SynthesisCompleted.Broadcast(UAzSpeechHelper::ConvertAudioDataToSoundWave(LastBuffer));
+			SynthesisCompleted.Broadcast(UAzSpeechHelper::ConvertAudioBufferToSoundWave(GetAudioBuffer()));
 		}
 	);
 }
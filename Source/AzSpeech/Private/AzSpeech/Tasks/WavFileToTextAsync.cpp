@@ -86,4 +86,10 @@ bool UWavFileToTextAsync::StartAzureTaskWork()
 	StartRecognitionWork(AudioConfig);
 
 	return true;
+}
+
+std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> UWavFileToTextAsync::CreateFallbackAudioConfig()
+{
+	// The file was already validated when the task started
+	return Microsoft::CognitiveServices::Speech::Audio::AudioConfig::FromWavFileInput(TCHAR_TO_UTF8(*UAzSpeechHelper::QualifyWAVFileName(FilePath, FileName)));
 }
\ No newline at end of file
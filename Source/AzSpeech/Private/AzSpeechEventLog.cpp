@@ -0,0 +1,77 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeechEventLog.h"
+#include "LogAzSpeech.h"
+
+void FAzSpeechEventLog::Record(const EAzSpeechLogEvent Event, const int32 Value0, const int64 Value1)
+{
+	FRecord& Slot = Records[NextIndex.fetch_add(1u, std::memory_order_relaxed) % Capacity];
+	Slot.Cycles = FPlatformTime::Cycles64();
+	Slot.Value1 = Value1;
+	Slot.Value0 = Value0;
+	Slot.ThreadID = FPlatformTLS::GetCurrentThreadId();
+	Slot.Event = Event;
+}
+
+void FAzSpeechEventLog::Flush(const FString& TaskName, const uint32 TaskID, const FString& Reason)
+{
+	const uint32 RecordedCount = NextIndex.load(std::memory_order_acquire);
+	if (RecordedCount == 0u || bFlushed.exchange(true))
+	{
+		return;
+	}
+
+	const uint32 FirstIndex = RecordedCount > Capacity ? RecordedCount - Capacity : 0u;
+	const uint64 FirstCycles = Records[FirstIndex % Capacity].Cycles;
+
+	UE_LOG(LogAzSpeech, Warning, TEXT("Task: %s (%d); Function: %s; Message: %s - Last %u of %u recorded events:"), *TaskName, TaskID, *FString(__func__), *Reason, RecordedCount - FirstIndex, RecordedCount);
+
+	for (uint32 Index = FirstIndex; Index < RecordedCount; ++Index)
+	{
+		const FRecord& Iterator = Records[Index % Capacity];
+		const double ElapsedMs = FPlatformTime::ToMilliseconds64(Iterator.Cycles - FirstCycles);
+
+		UE_LOG(LogAzSpeech, Warning, TEXT("\t+%.3fms; Thread: %u; Event: %s; Values: %d, %lld"), ElapsedMs, Iterator.ThreadID, GetEventName(Iterator.Event), Iterator.Value0, Iterator.Value1);
+	}
+}
+
+const TCHAR* FAzSpeechEventLog::GetEventName(const EAzSpeechLogEvent Event)
+{
+	switch (Event)
+	{
+		case EAzSpeechLogEvent::Activate:
+			return TEXT("Activate");
+
+		case EAzSpeechLogEvent::SDKStarted:
+			return TEXT("SDKStarted");
+
+		case EAzSpeechLogEvent::Partial:
+			return TEXT("Partial");
+
+		case EAzSpeechLogEvent::AudioChunk:
+			return TEXT("AudioChunk");
+
+		case EAzSpeechLogEvent::Viseme:
+			return TEXT("Viseme");
+
+		case EAzSpeechLogEvent::WordBoundary:
+			return TEXT("WordBoundary");
+
+		case EAzSpeechLogEvent::Bookmark:
+			return TEXT("Bookmark");
+
+		case EAzSpeechLogEvent::Canceled:
+			return TEXT("Canceled");
+
+		case EAzSpeechLogEvent::FinalResult:
+			return TEXT("FinalResult");
+
+		case EAzSpeechLogEvent::Stop:
+			return TEXT("Stop");
+
+		default:
+			return TEXT("Unknown");
+	}
+}
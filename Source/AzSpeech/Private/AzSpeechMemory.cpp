@@ -0,0 +1,20 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeechMemory.h"
+
+DEFINE_STAT(STAT_AzSpeech_TaskObjects);
+DEFINE_STAT(STAT_AzSpeech_AudioMemory);
+DEFINE_STAT(STAT_AzSpeech_VisemeMemory);
+DEFINE_STAT(STAT_AzSpeech_MetricsMemory);
+DEFINE_STAT(STAT_AzSpeech_CachedConfigs);
+
+#if ENGINE_MAJOR_VERSION >= 5
+LLM_DEFINE_TAG(AzSpeech);
+LLM_DEFINE_TAG(AzSpeech_Tasks, TEXT("AzSpeech/Tasks"), TEXT("AzSpeech"));
+LLM_DEFINE_TAG(AzSpeech_Audio, TEXT("AzSpeech/Audio"), TEXT("AzSpeech"));
+LLM_DEFINE_TAG(AzSpeech_Visemes, TEXT("AzSpeech/Visemes"), TEXT("AzSpeech"));
+LLM_DEFINE_TAG(AzSpeech_Boundaries, TEXT("AzSpeech/Boundaries"), TEXT("AzSpeech"));
+LLM_DEFINE_TAG(AzSpeech_Caches, TEXT("AzSpeech/Caches"), TEXT("AzSpeech"));
+#endif
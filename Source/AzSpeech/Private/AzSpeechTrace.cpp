@@ -0,0 +1,86 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeechTrace.h"
+
+#if AZSPEECH_TRACE_ENABLED
+#include <ProfilingDebugging/MiscTrace.h>
+#include <Runtime/Launch/Resources/Version.h>
+
+UE_TRACE_CHANNEL_DEFINE(AzSpeechChannel)
+
+#if ENGINE_MAJOR_VERSION >= 5
+#define AZSPEECH_TRACE_ANSI_STRING UE::Trace::AnsiString
+#else
+#define AZSPEECH_TRACE_ANSI_STRING Trace::AnsiString
+#endif
+
+UE_TRACE_EVENT_BEGIN(AzSpeech, TaskEvent)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, TaskID)
+	UE_TRACE_EVENT_FIELD(uint8, EventType)
+	UE_TRACE_EVENT_FIELD(AZSPEECH_TRACE_ANSI_STRING, ResultID)
+UE_TRACE_EVENT_END()
+
+#undef AZSPEECH_TRACE_ANSI_STRING
+
+namespace AzSpeech::Internal
+{
+	const TCHAR* GetTraceEventName(const EAzSpeechTraceEvent InEvent)
+	{
+		switch (InEvent)
+		{
+			case EAzSpeechTraceEvent::Activate:
+				return TEXT("Activate");
+
+			case EAzSpeechTraceEvent::ConfigCreated:
+				return TEXT("ConfigCreated");
+
+			case EAzSpeechTraceEvent::SDKStarted:
+				return TEXT("SDKStarted");
+
+			case EAzSpeechTraceEvent::FirstPartial:
+				return TEXT("FirstPartial");
+
+			case EAzSpeechTraceEvent::FirstAudioByte:
+				return TEXT("FirstAudioByte");
+
+			case EAzSpeechTraceEvent::Viseme:
+				return TEXT("Viseme");
+
+			case EAzSpeechTraceEvent::FinalResult:
+				return TEXT("FinalResult");
+
+			case EAzSpeechTraceEvent::Broadcast:
+				return TEXT("Broadcast");
+
+			case EAzSpeechTraceEvent::Teardown:
+				return TEXT("Teardown");
+
+			default:
+				return TEXT("Unknown");
+		}
+	}
+
+	void TraceTaskEvent(const EAzSpeechTraceEvent InEvent, const uint32 InTaskID, const ANSICHAR* InResultID)
+	{
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(AzSpeechChannel))
+		{
+			return;
+		}
+
+		UE_TRACE_LOG(AzSpeech, TaskEvent, AzSpeechChannel)
+			<< TaskEvent.Cycle(FPlatformTime::Cycles64())
+			<< TaskEvent.TaskID(InTaskID)
+			<< TaskEvent.EventType(static_cast<uint8>(InEvent))
+			<< TaskEvent.ResultID(InResultID);
+
+		// Bookmarks are shown in the timing view without a custom analyzer
+		if (InEvent != EAzSpeechTraceEvent::Viseme)
+		{
+			TRACE_BOOKMARK(TEXT("AzSpeech %s: Task %u"), GetTraceEventName(InEvent), InTaskID);
+		}
+	}
+}
+#endif
@@ -0,0 +1,67 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Animation/AnimNodeBase.h>
+#include <Runtime/Launch/Resources/Version.h>
+#include "AnimNode_AzSpeechBlendShapes.generated.h"
+
+class UAzSpeechVisemeTimeline;
+
+/**
+ * Writes the blend shapes of an AzSpeech viseme timeline to animation curves - The timeline is sampled once per update in the game thread and the curves are written in the worker threads
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct AZSPEECH_API FAnimNode_AzSpeechBlendShapes : public FAnimNode_Base
+{
+	GENERATED_BODY()
+
+	FAnimNode_AzSpeechBlendShapes();
+
+	UPROPERTY(EditAnywhere, Category = "Links")
+	FPoseLink Source;
+
+	/* Timeline providing the blend shapes, sampled at its playback time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings", Meta = (PinShownByDefault))
+	UAzSpeechVisemeTimeline* Timeline = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings", Meta = (PinShownByDefault, ClampMin = "0", ClampMax = "1"))
+	float Alpha = 1.f;
+
+	/* Added to the playback time of the timeline, in seconds - Use to compensate the audio output latency */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings", Meta = (PinHiddenByDefault))
+	float TimeOffset = 0.f;
+
+	/* Curve written for each blend shape channel, in the order sent by the service - Channels with None are ignored */
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	TArray<FName> CurveNames;
+
+	/* Names of the 55 blend shapes sent by Azure, in channel order */
+	static const TArray<FName>& GetDefaultCurveNames();
+
+	// FAnimNode_Base interface
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+	virtual void CacheBones_AnyThread(const FAnimationCacheBonesContext& Context) override;
+	virtual void Update_AnyThread(const FAnimationUpdateContext& Context) override;
+	virtual void Evaluate_AnyThread(FPoseContext& Output) override;
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+	virtual bool HasPreUpdate() const override;
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
+	// End of FAnimNode_Base interface
+
+private:
+	/* Sampled in the game thread, read in the worker threads */
+	TArray<float> SampledValues;
+	bool bHasSample = false;
+
+#if ENGINE_MAJOR_VERSION < 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 3)
+	/* Curve UID of each channel, resolved once per skeleton */
+	TArray<SmartName::UID_Type> CurveUIDs;
+#else
+	/* Channels with a curve name, in ascending order */
+	TArray<int32> MappedChannels;
+#endif
+};
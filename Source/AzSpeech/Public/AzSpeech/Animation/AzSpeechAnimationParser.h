@@ -0,0 +1,28 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechAnimationData.h"
+
+class FAzSpeechBlendShapeMatrix;
+
+/**
+ * Single pass parser for the facial expression animation of the viseme events: {"FrameIndex": N, "BlendShapes": [[...], ...]}
+ */
+class AZSPEECH_API FAzSpeechAnimationParser
+{
+public:
+	/* Doesn't build a JSON tree: The only allocations are the output arrays, reserved from the width of the previous frame - Returns false if the data is malformed */
+	static const bool Parse(const TCHAR* Data, const int32 Length, FAzSpeechAnimationData& OutAnimationData);
+	static const bool Parse(const FString& Data, FAzSpeechAnimationData& OutAnimationData);
+
+	/* Append the frames as a new segment of the matrix, without allocating besides the growth of its buffers - Nothing is appended if the data is malformed */
+	static const bool Parse(const TCHAR* Data, const int32 Length, FAzSpeechBlendShapeMatrix& OutMatrix, int32& OutSegmentIndex);
+	static const bool Parse(const FString& Data, FAzSpeechBlendShapeMatrix& OutMatrix, int32& OutSegmentIndex);
+
+	/* Parse a JSON number: Up to 15 significant digits and exponents in the range [-22, 22] are converted exactly without calling the CRT */
+	static const bool ParseNumber(const TCHAR*& Cursor, const TCHAR* const End, double& OutValue);
+};
@@ -0,0 +1,69 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechAnimationData.h"
+
+/**
+ * Blend shapes of all the received visemes in a single frames x channels buffer - Each viseme appends a segment of consecutive frames
+ */
+class AZSPEECH_API FAzSpeechBlendShapeMatrix
+{
+public:
+	/* Frame rate of the facial expression animation sent by the service */
+	static constexpr int32 FrameRate = 60;
+
+	struct FSegment
+	{
+		/* Animation frame of the first row, as sent by the service */
+		int32 FrameIndex = 0;
+		int32 FirstRow = 0;
+		int32 NumRows = 0;
+	};
+
+	/* Append a segment value by value, as done by FAzSpeechAnimationParser - The channel count is defined by the first frame and frames with another width are rejected */
+	void BeginSegment();
+	void AddValue(const float Value);
+	const bool EndFrame();
+	const int32 EndSegment(const int32 FrameIndex);
+	void CancelSegment();
+
+	/* Append a segment with all its frames at once - InValues must contain whole frames of InNumChannels values */
+	const int32 AppendSegment(const int32 FrameIndex, const int32 InNumChannels, const TArrayView<const float> InValues);
+
+	void Reset();
+
+	const int32 GetNumChannels() const;
+	const int32 GetNumRows() const;
+	const TArray<FSegment>& GetSegments() const;
+
+	const TArrayView<const float> GetRow(const int32 Row) const;
+
+	/* Values of all the frames of the segment, frame by frame */
+	const TArrayView<const float> GetSegmentValues(const int32 SegmentIndex) const;
+
+	/* Row containing the animation frame, searched in the segments - INDEX_NONE if not received */
+	const int32 FindRow(const int32 FrameIndex) const;
+
+	/* Blend shapes interpolated at the time in seconds from the start of the audio - Writes up to OutValues.Num() channels, returns false if the frame was not received */
+	const bool Sample(const float TimeInSeconds, const TArrayView<float> OutValues) const;
+
+	const FAzSpeechAnimationData GetSegmentAnimationData(const int32 SegmentIndex) const;
+
+	const SIZE_T GetAllocatedSize() const;
+
+	/* OutValues = A + (B - A) * Alpha, vectorized across the channels */
+	static void Blend(const float* A, const float* B, const float Alpha, float* OutValues, const int32 NumValues);
+
+private:
+	TArray<float> Values;
+	TArray<FSegment> Segments;
+	int32 NumChannels = 0;
+
+	/* State of the segment being appended */
+	int32 PendingFirstValue = 0;
+	int32 PendingFrameValue = 0;
+};
@@ -0,0 +1,121 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/Object.h>
+#include "AzSpeech/Animation/AzSpeechBlendShapeMatrix.h"
+#include "AzSpeech/Structures/AzSpeechVisemeData.h"
+#include "AzSpeechVisemeTimeline.generated.h"
+
+class UAudioComponent;
+class USoundWave;
+class UAzSpeechSynthesizerTaskBase;
+class FAzSpeechLineFile;
+
+/**
+ * Visemes and blend shape frames of a synthesis sorted by audio time - Filled incrementally from the task and sampled at any playback time in O(log n)
+ */
+class AZSPEECH_API FAzSpeechVisemeTimeline
+{
+public:
+	/* Append the visemes and the matrix segments received since the last call - Visemes must be the ones not appended yet */
+	void Append(const TArrayView<const FAzSpeechVisemeData> NewVisemes, const FAzSpeechBlendShapeMatrix& BlendShapeSource);
+
+	/* Replace the content with visemes and blend shapes read from a file - Visemes must be sorted by offset */
+	void Load(const TArrayView<const int64> InVisemeOffsetsMs, const TArrayView<const int32> InVisemeIDs, const int32 NumChannels, const TArrayView<const FAzSpeechBlendShapeMatrix::FSegment> InSegments, const TArrayView<const float> InValues);
+
+	void Reset();
+
+	/* Unique ID of the synthesis task filling the timeline - 0 if the timeline is empty or was loaded from a file */
+	void SetSourceTaskID(const uint32 InTaskID);
+	const uint32 GetSourceTaskID() const;
+
+	const int32 GetNumVisemes() const;
+	const int32 GetNumChannels() const;
+
+	/* Time of the last viseme or blend shape frame, in seconds */
+	const float GetDuration() const;
+
+	/* Viseme active at the time and the next one, Alpha is the position between both in the range [0, 1] - Returns false if no viseme starts before the time */
+	const bool SampleViseme(const float TimeInSeconds, int32& OutVisemeID, int32& OutNextVisemeID, float& OutAlpha) const;
+
+	/* Blend shapes interpolated between the frames at the time - Writes up to OutValues.Num() channels without allocating */
+	const bool SampleBlendShapes(const float TimeInSeconds, const TArrayView<float> OutValues) const;
+
+	const TArray<int64>& GetVisemeOffsets() const;
+	const TArray<int32>& GetVisemeIDs() const;
+	const FAzSpeechBlendShapeMatrix& GetBlendShapes() const;
+
+private:
+	TArray<int64> VisemeOffsetsMs;
+	TArray<int32> VisemeIDs;
+	FAzSpeechBlendShapeMatrix BlendShapes;
+	int32 SyncedSegments = 0;
+	uint32 SourceTaskID = 0u;
+};
+
+/**
+ * Game thread player of the viseme timeline of a synthesis task, following the playback position of an audio component
+ */
+UCLASS(BlueprintType, NotPlaceable, Category = "AzSpeech")
+class AZSPEECH_API UAzSpeechVisemeTimeline : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/* Create a timeline that receives the visemes of the task as they arrive */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	static UAzSpeechVisemeTimeline* CreateVisemeTimeline(UAzSpeechSynthesizerTaskBase* Task);
+
+	/* Create a timeline with the visemes and blend shapes of an opened line file */
+	static UAzSpeechVisemeTimeline* CreateVisemeTimelineFromLineFile(const FAzSpeechLineFile& LineFile);
+
+	/* Use the playback position of the audio component as the timeline time */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	void BindAudioComponent(UAudioComponent* AudioComponent);
+
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	void UnbindAudioComponent();
+
+	/* Playback position of the bound audio component, extrapolated between the audio updates */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const float GetPlaybackTime() const;
+
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const float GetDuration() const;
+
+	/* Viseme at the current playback time */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	const int32 GetCurrentVisemeID(int32& NextVisemeID, float& Alpha);
+
+	/* Blend shapes at the current playback time - Empty if the frame was not received yet */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	const TArray<float> GetCurrentBlendShapes();
+
+	/* Blend shapes at a given time in seconds - Empty if the frame was not received yet */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	const TArray<float> GetBlendShapesAtTime(const float TimeInSeconds);
+
+	/* Copy the visemes received by the task since the last update - Called by the sampling functions */
+	void UpdateFromTask();
+
+	const FAzSpeechVisemeTimeline& GetTimeline() const;
+
+protected:
+	virtual void BeginDestroy() override;
+
+private:
+	void OnAudioPlaybackPercent(const UAudioComponent* AudioComponent, const USoundWave* SoundWave, const float Percent);
+
+	TWeakObjectPtr<UAzSpeechSynthesizerTaskBase> Task;
+	TWeakObjectPtr<UAudioComponent> BoundAudioComponent;
+	FDelegateHandle PlaybackPercentHandle;
+
+	FAzSpeechVisemeTimeline Timeline;
+
+	float LastPlaybackTime = 0.f;
+	double LastPlaybackUpdateSeconds = 0.;
+};
@@ -0,0 +1,46 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Runtime/Launch/Resources/Version.h>
+#include <memory>
+#include <vector>
+
+#if ENGINE_MAJOR_VERSION >= 5
+#include <Memory/SharedBuffer.h>
+#endif
+
+/**
+ * Immutable and reference counted audio data: Shares the buffer created by the Azure SDK instead of copying it between the runnables, the tasks and the sound waves
+ */
+class AZSPEECH_API FAzSpeechAudioBuffer
+{
+public:
+	FAzSpeechAudioBuffer() = default;
+	explicit FAzSpeechAudioBuffer(std::shared_ptr<const std::vector<uint8_t>> InData);
+
+	/* Copy the data into a new buffer - Use when the data is not owned by a shared pointer */
+	static FAzSpeechAudioBuffer Clone(const TArrayView<const uint8> InData);
+
+	const uint8* GetData() const;
+	const int32 Num() const;
+	const bool IsEmpty() const;
+
+	const TArrayView<const uint8> GetView() const;
+
+	/* Copy the data into a new array - Required by Blueprint delegates and functions */
+	const TArray<uint8> ToArray() const;
+
+#if ENGINE_MAJOR_VERSION >= 5
+	/* Shared buffer referencing the same data: The audio data is kept alive until the returned buffer is released */
+	FSharedBuffer ToSharedBuffer() const;
+#endif
+
+	void Reset();
+
+private:
+	std::shared_ptr<const std::vector<uint8_t>> Data;
+};
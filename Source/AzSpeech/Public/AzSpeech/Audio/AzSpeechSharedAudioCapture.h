@@ -0,0 +1,141 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <HAL/Runnable.h>
+#include <atomic>
+
+THIRD_PARTY_INCLUDES_START
+#include <speechapi_cxx_audio_config.h>
+#include <speechapi_cxx_audio_stream.h>
+THIRD_PARTY_INCLUDES_END
+
+namespace Audio
+{
+	class FAudioCapture;
+	class FResampler;
+}
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechAudioCaptureListener
+{
+	friend class FAzSpeechSharedAudioCapture;
+
+public:
+	FAzSpeechAudioCaptureListener();
+	virtual ~FAzSpeechAudioCaptureListener();
+
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::PushAudioInputStream> GetStream() const;
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> CreateAudioConfig() const;
+
+	/* Signal the end of the stream to the connected recognizer */
+	void Close();
+
+	/* Index of the first captured sample written to this listener */
+	const uint64 GetStartSample() const;
+
+protected:
+	virtual void ProcessAudio(const float* InSamples, const int32 NumSamples);
+
+	void WriteToStream(const float* InSamples, const int32 NumSamples);
+
+private:
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::PushAudioInputStream> PushStream;
+	TArray<int16> ConversionBuffer;
+	uint64 StartSample = 0u;
+	std::atomic<bool> bIsClosed;
+};
+
+typedef TSharedPtr<FAzSpeechAudioCaptureListener, ESPMode::ThreadSafe> FAzSpeechAudioCaptureListenerPtr;
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechSharedAudioCapture final : public FRunnable
+{
+public:
+	/* Sample rate of the data sent to the listeners: 16 kHz, 16 bits, mono */
+	static constexpr int32 OutputSampleRate = 16000;
+
+	/* Amount of captured audio kept in memory to be sent as pre-roll to new listeners */
+	static constexpr int32 HistoryLengthMs = 3000;
+
+	/* Get the shared capture of the specified device or create a new one if there's no active capture - Use "Default" or an empty ID to get the default device */
+	static TSharedPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe> FindOrCreate(const FString& DeviceID);
+
+	FAzSpeechSharedAudioCapture() = delete;
+	FAzSpeechSharedAudioCapture(const FString& InDeviceID, const int32 InDeviceIndex);
+	virtual ~FAzSpeechSharedAudioCapture() override;
+
+	/* Create a new listener that will receive the captured audio. PreRollMs: Amount of already captured audio to write to the listener before the live data */
+	FAzSpeechAudioCaptureListenerPtr AddListener(const int32 PreRollMs = 0);
+
+	/* Add an existing listener. PreRollSamples: Amount of already captured samples to write to the listener before the live data */
+	void AddListener(const FAzSpeechAudioCaptureListenerPtr& Listener, const int32 PreRollSamples);
+
+	/* Add an existing listener starting at an absolute captured sample - The pre-roll is resolved under the capture lock and limited by the history */
+	void AddListenerFromSample(const FAzSpeechAudioCaptureListenerPtr& Listener, const uint64 InStartSample);
+
+	void RemoveListener(const FAzSpeechAudioCaptureListenerPtr& Listener);
+
+	/* Total amount of samples sent to the listeners since the capture started */
+	const uint64 GetCapturedSamples() const;
+
+	const bool IsCapturing() const;
+
+	const FString GetDeviceID() const;
+
+protected:
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End of FRunnable interface
+
+private:
+	bool OpenCaptureStream();
+	void CloseCaptureStream();
+
+	void AddListener_Internal(const FAzSpeechAudioCaptureListenerPtr& Listener, const int32 PreRollSamples);
+
+	void OnAudioCaptured(const float* InAudio, const int32 NumFrames, const int32 NumChannels, const int32 InSampleRate);
+	void DispatchCapturedAudio(const float* InSamples, const int32 NumSamples);
+
+	FString DeviceID;
+	int32 DeviceIndex;
+
+	// Lock-free single producer (capture callback) / single consumer (pump thread) buffer
+	struct FCaptureRingBuffer;
+
+	TUniquePtr<Audio::FAudioCapture> AudioCapture;
+	TUniquePtr<FCaptureRingBuffer> CaptureBuffer;
+	TUniquePtr<FRunnableThread> Thread;
+
+	// Capture thread only
+	TUniquePtr<Audio::FResampler> Resampler;
+	int32 ResamplerInputRate = 0;
+	TArray<float> MonoBuffer;
+	TArray<float> ResampleBuffer;
+
+	// Guarded by ListenersMutex
+	TArray<FAzSpeechAudioCaptureListenerPtr> Listeners;
+	TArray<float> History;
+	int32 HistoryWriteIndex = 0;
+	int32 HistoryNum = 0;
+	mutable FCriticalSection ListenersMutex;
+
+	std::atomic<uint64> CapturedSamples;
+
+	/* Samples dropped by the capture callback when the buffer is full - Reported by the pump thread */
+	std::atomic<uint32> DroppedSamples;
+
+	std::atomic<bool> bStopCapture;
+	std::atomic<bool> bIsCapturing;
+
+	static FCriticalSection RegistryMutex;
+	static TMap<FString, TWeakPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe>> ActiveCaptures;
+};
@@ -0,0 +1,93 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Audio/AzSpeechSharedAudioCapture.h"
+#include "AzSpeech/Structures/AzSpeechVoiceActivityOptions.h"
+
+enum class EAzSpeechVoiceActivityEvent : uint8
+{
+	None,
+	SpeechStarted,
+	SpeechEnded
+};
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechVoiceActivityDetector
+{
+public:
+	static constexpr int32 FrameLengthMs = 10;
+
+	FAzSpeechVoiceActivityDetector() = delete;
+	FAzSpeechVoiceActivityDetector(const FAzSpeechVoiceActivityOptions& InOptions, const int32 InSampleRate);
+
+	/* Process a single frame with GetFrameSize() samples */
+	EAzSpeechVoiceActivityEvent ProcessFrame(const float* InFrame);
+
+	void Reset();
+
+	const int32 GetFrameSize() const;
+	const bool IsSpeechActive() const;
+	const float GetNoiseFloorDb() const;
+
+	/* Mean of the squared samples, vectorized */
+	static const float GetMeanSquare(const float* InSamples, const int32 NumSamples);
+
+	/* Rate of sign changes between consecutive samples, in the range [0, 1] */
+	static const float GetZeroCrossingRate(const float* InSamples, const int32 NumSamples);
+
+private:
+	FAzSpeechVoiceActivityOptions Options;
+
+	int32 FrameSize;
+	int32 MinSpeechFrames;
+	int32 HangoverFrames;
+
+	bool bIsSpeechActive = false;
+	int32 VoicedFrames = 0;
+	int32 SilenceFrames = 0;
+	float NoiseFloorDb;
+};
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechVoiceActivityListener : public FAzSpeechAudioCaptureListener
+{
+public:
+	FAzSpeechVoiceActivityListener() = delete;
+	FAzSpeechVoiceActivityListener(const FAzSpeechVoiceActivityOptions& InOptions, const int32 InFlushSilenceMs);
+
+	/* Called in the capture thread when the detector finds the start of a speech */
+	TFunction<void()> OnSpeechStarted;
+
+	/* Called in the capture thread when the detector finds the end of a speech */
+	TFunction<void()> OnSpeechEnded;
+
+protected:
+	virtual void ProcessAudio(const float* InSamples, const int32 NumSamples) override;
+
+private:
+	void ProcessFrame(const float* InFrame);
+	void WritePreRoll(const float* InFrame);
+	void FlushPreRoll();
+
+	FAzSpeechVoiceActivityDetector Detector;
+	bool bFlushOnSpeechEnd;
+	int32 FlushSilenceSamples;
+
+	/* Preallocated to avoid allocations in the capture thread when flushing a speech end */
+	TArray<float> SilenceBuffer;
+
+	TArray<float> PendingFrame;
+	int32 PendingSamples = 0;
+
+	TArray<float> PreRoll;
+	int32 PreRollWriteIndex = 0;
+	int32 PreRollNum = 0;
+};
@@ -0,0 +1,55 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+/* Header only: Also used by the AzSpeech test server, which doesn't link the runtime module */
+namespace AzSpeech::Wave
+{
+	/* Size of the RIFF header of 16 bits mono PCM audio, as sent by the Riff*16BitMonoPcm synthesis output formats */
+	constexpr int32 HeaderSize = 44;
+
+	/* Write the RIFF header of 16 bits mono PCM audio - OutData must have at least HeaderSize bytes */
+	inline void WriteHeader(uint8* const OutData, const uint32 InSampleRate, const uint32 InDataSize)
+	{
+		int32 Offset = 0;
+		const auto WriteBytes = [OutData, &Offset](const char* const InBytes, const int32 InSize)
+		{
+			FMemory::Memcpy(OutData + Offset, InBytes, InSize);
+			Offset += InSize;
+		};
+
+		const auto WriteValue = [OutData, &Offset](const uint32 InValue, const int32 InSize)
+		{
+			for (int32 Index = 0; Index < InSize; ++Index)
+			{
+				OutData[Offset++] = static_cast<uint8>((InValue >> (8 * Index)) & 0xFF);
+			}
+		};
+
+		WriteBytes("RIFF", 4);
+		WriteValue(36u + InDataSize, 4);
+		WriteBytes("WAVEfmt ", 8);
+		WriteValue(16u, 4);
+		WriteValue(1u, 2);
+		WriteValue(1u, 2);
+		WriteValue(InSampleRate, 4);
+		WriteValue(InSampleRate * 2u, 4);
+		WriteValue(2u, 2);
+		WriteValue(16u, 2);
+		WriteBytes("data", 4);
+		WriteValue(InDataSize, 4);
+	}
+
+	/* Append the RIFF header of 16 bits mono PCM audio to the buffer */
+	inline void AppendHeader(TArray<uint8>& InOutData, const uint32 InSampleRate, const uint32 InDataSize)
+	{
+		const int32 Offset = InOutData.Num();
+		InOutData.AddUninitialized(HeaderSize);
+
+		WriteHeader(InOutData.GetData() + Offset, InSampleRate, InDataSize);
+	}
+}
\ No newline at end of file
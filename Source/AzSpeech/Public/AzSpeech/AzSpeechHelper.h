@@ -9,8 +9,17 @@
 #include "AzSpeech/Structures/AzSpeechAudioInputDeviceInfo.h"
 #include "AzSpeech/Structures/AzSpeechAnimationData.h"
 #include "AzSpeech/Structures/AzSpeechVisemeData.h"
+#include "AzSpeech/Structures/AzSpeechBoundaryData.h"
+#include "AzSpeech/Structures/AzSpeechEndpoint.h"
+#include "AzSpeech/Structures/AzSpeechEndpointHealth.h"
+#include "AzSpeech/Structures/AzSpeechLatencyMetrics.h"
+#include "AzSpeech/Structures/AzSpeechSettingsOptions.h"
+#include "AzSpeech/Audio/AzSpeechAudioBuffer.h"
 #include "AzSpeechHelper.generated.h"
 
+class UAzSpeechSynthesizerTaskBase;
+class UAzSpeechVisemeTimeline;
+
 /**
  *
  */
@@ -46,6 +55,13 @@ public:
 		return QualifyFileExtension(Path, Name, "xml");
 	}
 
+	/* Helper function to qualify a speech line file path + name to a single string like Full/File/Path/Filename.azspeech */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech", meta = (DisplayName = "Qualify Speech Line File Path"))
+	static const FString QualifySpeechLineFileName(const FString& Path, const FString& Name)
+	{
+		return QualifyFileExtension(Path, Name, "azspeech");
+	}
+
 	/* 
 		Convert .wav file to USoundWave.
 
@@ -74,6 +90,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
 	static USoundWave* ConvertAudioDataToSoundWave(const TArray<uint8>& RawData, const FString& OutputModulePath = "", const FString& RelativeOutputDirectory = "", const FString& OutputAssetName = "");
 
+	/* Same as ConvertAudioDataToSoundWave, but shares the audio buffer with the editor payload of the Sound Wave instead of copying it */
+	static USoundWave* ConvertAudioBufferToSoundWave(const FAzSpeechAudioBuffer& AudioBuffer, const FString& OutputModulePath = "", const FString& RelativeOutputDirectory = "", const FString& OutputAssetName = "");
+
+	/* Save the audio, visemes, blend shapes and text of a finished synthesis task to a .azspeech line file */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	static const bool SaveSpeechLineFile(UAzSpeechSynthesizerTaskBase* Task, const FString& FilePath, const FString& FileName);
+
+	/* 
+		Load a .azspeech line file to a Sound Wave and a viseme timeline. The file is memory mapped and read without parsing.
+
+		[OutputModuleName, RelativeOutputDirectory, OutputAssetName]: Same as ConvertAudioDataToSoundWave
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	static const bool LoadSpeechLineFile(const FString& FilePath, const FString& FileName, USoundWave*& OutSoundWave, UAzSpeechVisemeTimeline*& OutTimeline, const FString& OutputModulePath = "", const FString& RelativeOutputDirectory = "", const FString& OutputAssetName = "");
+
+	/* Get the word boundaries stored in a .azspeech line file, with the words extracted from its text */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	static const TArray<FAzSpeechWordBoundaryData> GetSpeechLineFileWordBoundaries(const FString& FilePath, const FString& FileName);
+
+	/* Check if the .azspeech line file was generated from the same text, voice, language and output format */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	static const bool IsSpeechLineFileUpToDate(const FString& FilePath, const FString& FileName, const FString& Text, const FName VoiceName, const FName LanguageID, const EAzSpeechSynthesisOutputFormat OutputFormat);
+
 	/* Load a given .xml file and return the content as string */
 	UFUNCTION(BlueprintCallable, Category = "AzSpeech", meta = (DisplayName = "Load XML to String"))
 	static const FString LoadXMLToString(const FString& FilePath, const FString& FileName);
@@ -98,6 +137,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
 	static const TArray<FAzSpeechAudioInputDeviceInfo> GetAvailableAudioInputDevices();
 
+	/* Enumerate the available audio input devices again - Devices are cached and refreshed automatically when the platform notifies a device change */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	static void RefreshAudioInputDevices();
+
 	/* Get the audio input devices info by it's ID */
 	UFUNCTION(BlueprintPure, Category = "AzSpeech")
 	static const FAzSpeechAudioInputDeviceInfo GetAudioInputDeviceInfoFromID(const FString& DeviceID);
@@ -110,6 +153,22 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AzSpeech", Meta = (DisplayName = "Is Audio Input Device ID Valid"))
 	static const bool IsAudioInputDeviceIDValid(const FString& DeviceID);
 
+	/* Get the health data collected for the endpoint by the finished tasks */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	static const FAzSpeechEndpointHealth GetEndpointHealth(const FAzSpeechEndpoint& Endpoint);
+
+	/* Clear the health and latency data of all endpoints and close their circuits, so the next tasks will try every endpoint of the pool again */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	static void ResetEndpointHealth();
+
+	/* Get the latency percentiles recorded by the finished tasks - Voice = None and empty Endpoint ID aggregate all voices/languages and endpoints */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	static const FAzSpeechLatencyPercentiles GetLatencyPercentiles(const EAzSpeechLatencyMetric Metric, const FName Voice, const FString& EndpointID);
+
+	/* Clear the latency histograms of all metrics, voices and endpoints */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech")
+	static void ResetLatencyMetrics();
+
 	/* Get available modules with content enabled */
 	UFUNCTION(BlueprintPure, Category = "AzSpeech")
 	static const TArray<FString> GetAvailableContentModules();
@@ -167,4 +226,7 @@ public:
 	static class UAzSpeechSynthesizerTaskBase* CastToAzSpeechSynthesizerTaskBase(UObject* Object);
 
 	static const FString GetAzSpeechLogsBaseDir();
+
+private:
+	static USoundWave* CreateSoundWaveFromAudioData(const TArrayView<const uint8> RawData, const FAzSpeechAudioBuffer* const SharedData, const FString& OutputModulePath, const FString& RelativeOutputDirectory, const FString& OutputAssetName);
 };
@@ -11,6 +11,8 @@
 #include "AzSpeech/Structures/AzSpeechRecognitionMap.h"
 #include "AzSpeech/Structures/AzSpeechPhraseListMap.h"
 #include "AzSpeech/Structures/AzSpeechSettingsOptions.h"
+#include "AzSpeech/Structures/AzSpeechVoiceActivityOptions.h"
+#include "AzSpeech/Structures/AzSpeechMockBackendOptions.h"
 #include "AzSpeechSettings.generated.h"
 
 constexpr unsigned short int AZSPEECH_KEY_SUBSCRIPTION = 0u;
@@ -49,10 +51,27 @@ public:
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Information", Meta = (DisplayName = "Filter Viseme Facial Expression"))
 	bool bFilterVisemeFacialExpression;
 
+	/* If enabled, Speech to Text tasks will share a single capture stream per audio input device instead of opening the device for each task */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Audio Input", Meta = (DisplayName = "Use Shared Audio Capture"))
+	bool bUseSharedAudioCapture;
+
+	/* Local voice activity detection used by Speech to Text tasks to avoid streaming silence to the service
+	 * Only available with the shared audio capture enabled: Enabling it doesn't change the capture path, tasks using the default capture path stream the device input directly through the SDK and ignore these options */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Audio Input", Meta = (DisplayName = "Voice Activity Detection", EditCondition = "bUseSharedAudioCapture"))
+	FAzSpeechVoiceActivityOptions VoiceActivityDetection;
+
 	/* Time limit in seconds to wait for related asynchronous tasks to complete */
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Tasks", Meta = (DisplayName = "Attempt Timeout in Seconds", ClampMin = "1", UIMin = "1", ClampMax = "600", UIMax = "600"))
 	int32 TimeOutInSeconds;
 
+	/* Max ratio of synthesis requests that can be hedged to a second endpoint of the pool - Shared by all tasks using request hedging */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Tasks", Meta = (DisplayName = "Max Hedge Ratio", ClampMin = "0", UIMin = "0", ClampMax = "1", UIMax = "1"))
+	float MaxHedgeRatio;
+
+	/* Latencies, chunks, visemes and errors replayed by tasks using the mock backend */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Mock Backend", Meta = (DisplayName = "Mock Backend"))
+	FAzSpeechMockBackendOptions MockBackend;
+
 	/* CPU thread priority to use in created runnable threads */
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Thread", Meta = (DisplayName = "Thread Priority"))
 	EAzSpeechThreadPriority TasksThreadPriority;
@@ -77,6 +96,14 @@ public:
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Information", Meta = (DisplayName = "Enable Debugging Prints"))
 	bool bEnableDebuggingPrints;
 
+	/* Will record the events of each task in a binary ring buffer and print them in log only when the task fails */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Information", Meta = (DisplayName = "Enable Failure Event Log"))
+	bool bEnableFailureEventLog;
+
+	/* Will keep the Azure SDK trace in a memory buffer and write it to the logs directory when a task is canceled with an error - Not available in shipping builds */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Information", Meta = (DisplayName = "Enable SDK Memory Logger"))
+	bool bEnableSDKMemoryLogger;
+
 	/* Map of Phrase Lists used to improve recognition accuracy */
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Extras", Meta = (DisplayName = "Phrase List Map", TitleProperty = "Group: {GroupName}"))
 	TArray<FAzSpeechPhraseListMap> PhraseListMap;
@@ -128,4 +155,5 @@ private:
 public:
 	static const std::map<unsigned short int, std::string> GetAzSpeechKeys();
 	static const bool CheckAzSpeechSettings();
+	static const bool CheckAzSpeechSettings(const FAzSpeechSettingsOptions& Options);
 };
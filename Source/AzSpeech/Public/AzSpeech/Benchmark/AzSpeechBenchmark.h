@@ -0,0 +1,176 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <UObject/Object.h>
+#include <Containers/Ticker.h>
+#include <Runtime/Launch/Resources/Version.h>
+#include "AzSpeech/Structures/AzSpeechSettingsOptions.h"
+#include "AzSpeechBenchmark.generated.h"
+
+class UAzSpeechTaskBase;
+
+/* Options of a benchmark run - All tasks are started at the same time */
+struct AZSPEECH_API FAzSpeechBenchmarkOptions
+{
+	int32 SynthesisTasks = 8;
+	int32 RecognitionTasks = 8;
+
+	/* Backend used by the tasks - Ignored if an endpoint is set */
+	EAzSpeechBackend Backend = EAzSpeechBackend::Mock;
+
+	/* Private endpoint used with the cloud backend, e.g. the local AzSpeech test server */
+	FString Endpoint;
+
+	FString SynthesisText = TEXT("The quick brown fox jumps over the lazy dog while the benchmark is running");
+
+	/* Tasks still running after this time are stopped and reported as failed */
+	float TimeoutSeconds = 60.f;
+
+	/* Directory of the reports - Uses the AzSpeech logs directory if empty */
+	FString OutputDirectory;
+
+	/* Request the engine exit when the run finishes, returning 1 if any task failed */
+	bool bExitWhenFinished = false;
+};
+
+/* Summary of a benchmark run - Latencies are measured in the game thread, from the activation to the delegate broadcast */
+struct AZSPEECH_API FAzSpeechBenchmarkResult
+{
+	int32 TotalTasks = 0;
+	int32 SucceededTasks = 0;
+	int32 FailedTasks = 0;
+
+	double DurationSeconds = 0.0;
+	double TasksPerSecond = 0.0;
+
+	double CompletionP50Ms = 0.0;
+	double CompletionP95Ms = 0.0;
+	double CompletionP99Ms = 0.0;
+
+	double FirstResultP50Ms = 0.0;
+	double FirstResultP95Ms = 0.0;
+	double FirstResultP99Ms = 0.0;
+
+	/* Threads created by the engine, including the task runnables - Threads created internally by the SDK aren't counted */
+	int32 PeakThreadCount = 0;
+
+	double PeakUsedPhysicalMB = 0.0;
+	double UsedPhysicalDeltaMB = 0.0;
+
+	/* Game thread time spent in the AzSpeech callbacks - -1 if the build doesn't account the callbacks (AZSPEECH_WITH_CALLBACK_ACCOUNTING) */
+	double GameThreadCallbackMs = 0.0;
+};
+
+/* Timestamps of a single benchmark task */
+struct FAzSpeechBenchmarkSample
+{
+	FName TaskName = NAME_None;
+	bool bIsSynthesis = false;
+	bool bIsFinished = false;
+	bool bSucceeded = false;
+
+	double StartTime = 0.0;
+	double FirstResultTime = -1.0;
+	double CompletedTime = -1.0;
+
+	/* Time the task was found ready to destroy without broadcasting the final result */
+	double ReadyToDestroyTime = -1.0;
+};
+
+/**
+ * Receives the delegates of a single benchmark task
+ */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class UAzSpeechBenchmarkProbe final : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	class UAzSpeechBenchmark* Benchmark = nullptr;
+
+	int32 SampleIndex = INDEX_NONE;
+
+	UFUNCTION()
+	void OnSynthesisUpdated();
+
+	UFUNCTION()
+	void OnSynthesisCompleted(const TArray<uint8>& FinalAudioData);
+
+	UFUNCTION()
+	void OnRecognitionUpdated(const FString UpdatedString);
+
+	UFUNCTION()
+	void OnRecognitionCompleted(const FString FinalString);
+
+	UFUNCTION()
+	void OnTaskFailed();
+};
+
+/**
+ * Launches concurrent synthesis and recognition tasks and writes the throughput, latency percentiles and resource peaks to JSON and CSV reports
+ */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class AZSPEECH_API UAzSpeechBenchmark final : public UObject
+{
+	GENERATED_BODY()
+
+	friend class UAzSpeechBenchmarkProbe;
+
+public:
+	/* Start a new run - Returns nullptr if another run is active or no task could be started */
+	static UAzSpeechBenchmark* StartBenchmark(UObject* WorldContextObject, const FAzSpeechBenchmarkOptions& Options);
+
+	static UAzSpeechBenchmark* GetActiveBenchmark();
+
+	void StopBenchmark();
+
+	const bool IsRunning() const;
+	const FAzSpeechBenchmarkResult GetResult() const;
+
+private:
+	bool Start(UObject* WorldContextObject);
+	bool Tick(float DeltaTime);
+	void Finish();
+
+	void MarkFirstResult(const int32 InSampleIndex);
+	void MarkCompleted(const int32 InSampleIndex, const bool bSucceeded);
+
+	void SampleResources();
+	void ComputeResult();
+	void WriteReports() const;
+
+	const FString CreateRecognitionInput() const;
+	const FAzSpeechSettingsOptions GetTaskOptions() const;
+
+	FAzSpeechBenchmarkOptions Options;
+	FAzSpeechBenchmarkResult Result;
+	TArray<FAzSpeechBenchmarkSample> Samples;
+
+	UPROPERTY()
+	TArray<UAzSpeechTaskBase*> Tasks;
+
+	UPROPERTY()
+	TArray<UAzSpeechBenchmarkProbe*> Probes;
+
+#if ENGINE_MAJOR_VERSION >= 5
+	FTSTicker::FDelegateHandle TickerHandle;
+#else
+	FDelegateHandle TickerHandle;
+#endif
+
+	bool bIsRunning = false;
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+	uint64 StartCallbackCycles = 0u;
+	uint64 StartUsedPhysical = 0u;
+	uint64 PeakUsedPhysical = 0u;
+	int32 PeakThreadCount = 0;
+	FString ReportName;
+
+	static TWeakObjectPtr<UAzSpeechBenchmark> ActiveBenchmark;
+};
@@ -0,0 +1,46 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+/* Result of a single microbenchmark case */
+struct AZSPEECH_API FAzSpeechMicrobenchmarkResult
+{
+	FString Name;
+	int32 Iterations = 0;
+	double NanosecondsPerOp = 0.0;
+	/* -1 if the allocation counter isn't installed */
+	double AllocationsPerOp = 0.0;
+	double BytesPerOp = 0.0;
+};
+
+/**
+ * Fixed input benchmarks of the CPU bound helpers: Measures the time and the allocations of the calling thread per operation
+ */
+class AZSPEECH_API FAzSpeechMicrobenchmark
+{
+public:
+	/* Command line parameter that installs the allocation counter at the module startup */
+	static constexpr const TCHAR* AllocationCounterParam = TEXT("AzSpeechCountAllocations");
+
+	/* Wrap the engine allocator with a proxy counting the allocations per thread - Installed once and kept until the application exits */
+	static void InstallAllocationCounter();
+
+	/* Must be called from the game thread: Some cases create UObjects */
+	static TArray<FAzSpeechMicrobenchmarkResult> RunAll(const int32 Iterations);
+
+	static void WriteReports(const TArray<FAzSpeechMicrobenchmarkResult>& Results, const FString& OutputDirectory = FString());
+
+private:
+	static FAzSpeechMicrobenchmarkResult RunCase(const FString& Name, const int32 Iterations, const TFunctionRef<void()> Function);
+
+	static FAzSpeechMicrobenchmarkResult RunRecognitionMapCheck(const int32 Iterations, const int32 MapSize);
+	static FAzSpeechMicrobenchmarkResult RunExtractAnimationData(const int32 Iterations);
+	static FAzSpeechMicrobenchmarkResult RunExtractAnimationDataArray(const int32 Iterations, const int32 VisemeCount);
+	static FAzSpeechMicrobenchmarkResult RunConvertAudioDataToSoundWave(const int32 Iterations);
+	static FAzSpeechMicrobenchmarkResult RunGetAudioData(const int32 Iterations);
+	static FAzSpeechMicrobenchmarkResult RunGetRecognizedString(const int32 Iterations);
+};
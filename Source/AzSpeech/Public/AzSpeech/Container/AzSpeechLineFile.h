@@ -0,0 +1,131 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Animation/AzSpeechBlendShapeMatrix.h"
+#include "AzSpeech/Structures/AzSpeechBoundaryData.h"
+#include "AzSpeech/Structures/AzSpeechSettingsOptions.h"
+
+class FAzSpeechVisemeTimeline;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Versioned binary container of a synthesized speech line (.azspeech) - Bundles the audio, visemes, blend shapes, word boundaries and the source text in a single file
+ * The sections are stored with the in-memory layout of the data: The reader maps the file and returns views over it without parsing
+ */
+class AZSPEECH_API FAzSpeechLineFile
+{
+public:
+	static constexpr uint32 Magic = 0x4C535A41; // "AZSL"
+
+	/* Newer minor versions only append sections and header fields, newer major versions can't be read */
+	static constexpr uint8 MajorVersion = 1;
+	static constexpr uint8 MinorVersion = 0;
+
+	/* Sections are aligned to this value from the start of the file */
+	static constexpr int32 SectionAlignment = 16;
+
+	enum class ESection : uint32
+	{
+		/* Audio as returned by the synthesis, with the RIFF header: int8[] */
+		Audio,
+		/* Audio offset of each viseme in milliseconds: int64[] */
+		VisemeOffsets,
+		/* ID of each viseme: int32[] */
+		VisemeIDs,
+		/* Segments of the blend shape matrix: FAzSpeechBlendShapeMatrix::FSegment[] */
+		BlendShapeSegments,
+		/* Frames x channels blend shape matrix: float[] */
+		BlendShapeValues,
+		/* Word boundaries: FAzSpeechWordBoundary[] */
+		WordBoundaries,
+		/* Source text or SSML, the text spans of the word boundaries refer to it: UTF-16 char[] */
+		Text,
+
+		Count
+	};
+
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		uint8 MajorVersion = 0;
+		uint8 MinorVersion = 0;
+		uint16 HeaderSize = 0;
+		uint64 SourceHash = 0;
+		int32 NumBlendShapeChannels = 0;
+		/* Number of entries in the section table following the header - Readers ignore the sections they don't know */
+		uint32 NumSections = 0;
+	};
+
+	struct FSectionEntry
+	{
+		uint64 Offset = 0;
+		uint64 Size = 0;
+	};
+
+	/* Records of the word boundaries section have the layout used by the synthesizer tasks */
+	using FWordBoundary = FAzSpeechWordBoundary;
+
+	/* Content of a line to be written */
+	struct FLineData
+	{
+		TArrayView<const uint8> AudioData;
+		TArrayView<const int64> VisemeOffsets;
+		TArrayView<const int32> VisemeIDs;
+		const FAzSpeechBlendShapeMatrix* BlendShapes = nullptr;
+		TArrayView<const FWordBoundary> WordBoundaries;
+		FString Text;
+		uint64 SourceHash = 0;
+	};
+
+	FAzSpeechLineFile() = default;
+	~FAzSpeechLineFile();
+
+	FAzSpeechLineFile(const FAzSpeechLineFile&) = delete;
+	FAzSpeechLineFile& operator=(const FAzSpeechLineFile&) = delete;
+
+	/* Hash of the text, voice, language and output format used to generate a line - Used to check if a line file is up to date with its source */
+	static const uint64 ComputeSourceHash(const FString& Text, const FName& VoiceName, const FName& LanguageID, const EAzSpeechSynthesisOutputFormat OutputFormat);
+
+	/* Serialize the line to the container format */
+	static void Serialize(const FLineData& LineData, TArray<uint8>& OutData);
+	static const bool Write(const FString& Filename, const FLineData& LineData);
+
+	/* Map the file and validate its header and section table - Falls back to loading the file in memory if the platform can't map it */
+	const bool Open(const FString& Filename);
+	void Close();
+
+	const bool IsOpen() const;
+
+	const uint64 GetSourceHash() const;
+	const int32 GetNumBlendShapeChannels() const;
+
+	const TArrayView<const uint8> GetAudioData() const;
+	const TArrayView<const int64> GetVisemeOffsets() const;
+	const TArrayView<const int32> GetVisemeIDs() const;
+	const TArrayView<const FAzSpeechBlendShapeMatrix::FSegment> GetBlendShapeSegments() const;
+	const TArrayView<const float> GetBlendShapeValues() const;
+	const TArrayView<const FWordBoundary> GetWordBoundaries() const;
+	const FString GetText() const;
+
+	/* Copy the visemes and blend shapes to the timeline */
+	void LoadVisemeTimeline(FAzSpeechVisemeTimeline& OutTimeline) const;
+
+private:
+	const bool Validate();
+
+	template<typename ElementType>
+	const TArrayView<const ElementType> GetSection(const ESection Section) const;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> LoadedData;
+
+	/* Mapped region or loaded data, only set if valid */
+	TArrayView<const uint8> FileData;
+	TArray<FSectionEntry> Sections;
+};
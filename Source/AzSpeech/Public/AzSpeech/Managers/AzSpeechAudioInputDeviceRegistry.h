@@ -0,0 +1,59 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechAudioInputDeviceInfo.h"
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechAudioInputDeviceRegistry
+{
+public:
+	static FAzSpeechAudioInputDeviceRegistry& Get();
+
+	/* Get the cached audio input devices - Devices are enumerated only if the registry is invalidated */
+	const TArray<FAzSpeechAudioInputDeviceInfo> GetDevices();
+
+	/* Find a device by it's ID - Returns false if the device isn't available */
+	const bool FindDevice(const FString& DeviceID, FAzSpeechAudioInputDeviceInfo& OutDeviceInfo);
+
+	/* Get the index of the device in the platform capture devices list - Returns INDEX_NONE if the device isn't available */
+	const int32 FindDeviceIndex(const FString& DeviceID);
+
+	/* Enumerate the available devices immediately */
+	void Refresh();
+
+	/* Mark the registry as dirty: The devices will be enumerated again in the next request */
+	void Invalidate();
+
+	/* Unbind the device change notifications - Called when the module is shut down */
+	void Deinitialize();
+
+private:
+	FAzSpeechAudioInputDeviceRegistry() = default;
+
+	void EnumerateDevicesIfDirty();
+	void BindDeviceNotifications();
+
+	const int32 FindDeviceIndex_Internal(const FString& DeviceID) const;
+
+	FCriticalSection Mutex;
+	TArray<FAzSpeechAudioInputDeviceInfo> Devices;
+	TMap<FString, int32> DeviceIndexMap;
+
+	bool bIsDirty = true;
+	bool bBoundNotifications = false;
+
+	FDelegateHandle DeviceAddedHandle;
+	FDelegateHandle DeviceRemovedHandle;
+	FDelegateHandle DeviceStateChangedHandle;
+	FDelegateHandle DefaultCaptureDeviceChangedHandle;
+
+	/* Engines without device change notifications enumerate the devices again after this interval */
+	static constexpr double RefreshIntervalSeconds = 5.0;
+	double LastEnumerationTime = 0.0;
+};
@@ -0,0 +1,56 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechEndpoint.h"
+#include "AzSpeech/Structures/AzSpeechEndpointHealth.h"
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechCircuitBreaker
+{
+public:
+	/* Check if a new task could use the endpoint, without starting a probe */
+	static const bool CanRequest(const FAzSpeechEndpoint& InEndpoint);
+
+	/* Check if a new task can use the endpoint - Starts the half-open probe if the open period of the endpoint ended, bOutIsProbe: True if the task must report the result of the probe */
+	static const bool TryAcquire(const FAzSpeechEndpoint& InEndpoint, bool& bOutIsProbe);
+
+	/* Check if a new task could use at least one of the endpoints */
+	static const bool CanRequestAny(const TArray<FAzSpeechEndpoint>& InEndpoints);
+
+	static void ReportSuccess(const FAzSpeechEndpoint& InEndpoint);
+
+	/* Called on connection failures and unavailable service errors */
+	static void ReportOutage(const FAzSpeechEndpoint& InEndpoint);
+
+	/* Called when the probe task is stopped without a result: The next task can probe the endpoint without waiting for the probe timeout */
+	static void ReleaseProbe(const FAzSpeechEndpoint& InEndpoint);
+
+	static const EAzSpeechCircuitState GetState(const FAzSpeechEndpoint& InEndpoint);
+
+	static void Reset();
+
+	static constexpr int32 OutagesToOpen = 3;
+	static constexpr double OpenDurationSeconds = 10.0;
+
+	/* Time to wait for the result of a probe before allowing a new one - Stopped probe tasks release the probe, only a hung probe waits for this timeout */
+	static constexpr double ProbeTimeoutSeconds = 30.0;
+
+private:
+	struct FCircuit
+	{
+		EAzSpeechCircuitState State = EAzSpeechCircuitState::Closed;
+		int32 ConsecutiveOutages = 0;
+		double StateTime = 0.0;
+	};
+
+	static const bool CanRequest_Internal(const FCircuit& InCircuit, const double CurrentTime);
+
+	static FCriticalSection Mutex;
+	static TMap<FString, FCircuit> Entries;
+};
@@ -0,0 +1,80 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechSettingsOptions.h"
+
+THIRD_PARTY_INCLUDES_START
+#include <speechapi_cxx_speech_config.h>
+#include <speechapi_cxx_embedded_speech_config.h>
+#include <speechapi_cxx_hybrid_speech_config.h>
+THIRD_PARTY_INCLUDES_END
+
+/**
+ *
+ */
+struct AZSPEECH_API FAzSpeechBackendConfig
+{
+	EAzSpeechBackend Backend = EAzSpeechBackend::Cloud;
+
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig> CloudConfig;
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig> EmbeddedConfig;
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::HybridSpeechConfig> HybridConfig;
+
+	/* Check if the config of the selected backend is valid */
+	const bool IsValid() const;
+
+	/* Check if a cloud config also has the embedded config used by the latency fallback */
+	const bool HasEmbeddedFallback() const;
+
+	/* Copy of this config selecting the embedded backend - Used by the latency fallback */
+	FAzSpeechBackendConfig GetEmbeddedFallback() const;
+
+	/* Call the functor with the config of the selected backend - Used to select the matching FromConfig overload of the SDK objects */
+	template<typename FunctorTy>
+	auto Visit(FunctorTy&& Functor) const
+	{
+		switch (Backend)
+		{
+			case EAzSpeechBackend::Embedded:
+				return Functor(EmbeddedConfig);
+
+			case EAzSpeechBackend::Hybrid:
+				return Functor(HybridConfig);
+
+			default:
+				return Functor(CloudConfig);
+		}
+	}
+};
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechConfigCache
+{
+public:
+	/* Returns the cached config for the given key or creates a new one using the factory - Only valid configs are cached
+	 * The key must contain every value used to configure the config, it is compared case sensitively on each hit and never logged */
+	static FAzSpeechBackendConfig FindOrAdd(const FString& InKey, const TFunctionRef<FAzSpeechBackendConfig(bool&)>& InFactory);
+
+	static void Reset();
+
+	static const int32 Num();
+
+	static constexpr int32 MaxEntries = 32;
+
+private:
+	static FCriticalSection Mutex;
+	struct FEntry
+	{
+		FString Key;
+		FAzSpeechBackendConfig Config;
+	};
+
+	/* Indexed by the hash of the key: Entries with the same hash replace each other */
+	static TMap<uint32, FEntry> Entries;
+};
@@ -0,0 +1,39 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechEndpoint.h"
+#include "AzSpeech/Structures/AzSpeechEndpointHealth.h"
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechEndpointManager
+{
+public:
+	/* Index of the healthy endpoint with the best score - Endpoints without samples are tried first and the one with the oldest failure is used if none is healthy. Endpoints with an open circuit are skipped */
+	static const int32 SelectEndpoint(const TArray<FAzSpeechEndpoint>& InPool, const FString& InExcludedEndpointID = FString());
+
+	static void ReportSuccess(const FAzSpeechEndpoint& InEndpoint, const int32 LatencyMs);
+	static void ReportFailure(const FAzSpeechEndpoint& InEndpoint);
+
+	static const FAzSpeechEndpointHealth GetHealth(const FAzSpeechEndpoint& InEndpoint);
+
+	static void Reset();
+
+	static constexpr float SmoothingFactor = 0.3f;
+	static constexpr float UnhealthyErrorRate = 0.5f;
+	/* Latency added to the score of an endpoint per unit of error rate */
+	static constexpr float ErrorRatePenaltyMs = 1000.f;
+	static constexpr double UnhealthyCooldownSeconds = 30.0;
+
+private:
+	static const bool IsHealthy(const FAzSpeechEndpointHealth& InHealth, const double CurrentTime);
+	static const float GetScore(const FAzSpeechEndpointHealth& InHealth);
+
+	static FCriticalSection Mutex;
+	static TMap<FString, FAzSpeechEndpointHealth> Entries;
+};
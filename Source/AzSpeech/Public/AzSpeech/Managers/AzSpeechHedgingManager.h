@@ -0,0 +1,47 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechEndpoint.h"
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechHedgingManager
+{
+public:
+	/* Store the first byte latency of a synthesis answered by the endpoint */
+	static void AddLatencySample(const FAzSpeechEndpoint& InEndpoint, const int32 LatencyMs);
+
+	/* Percentile of the stored first byte latencies used as hedge delay - INDEX_NONE while there aren't enough samples */
+	static const int32 GetHedgeDelayMs(const FAzSpeechEndpoint& InEndpoint);
+
+	/* Add the hedge budget earned by a new synthesis request */
+	static void AddRequest();
+
+	/* Consume the budget of a hedged request - Returns false if the max hedge ratio was reached */
+	static const bool TryConsumeHedge();
+
+	static void Reset();
+
+	static constexpr int32 MaxSamples = 64;
+	static constexpr int32 MinSamples = 16;
+	static constexpr float LatencyPercentile = 0.95f;
+
+	/* Max hedged requests that can be sent in sequence after a period without hedges */
+	static constexpr float MaxBudget = 3.f;
+
+private:
+	struct FLatencyWindow
+	{
+		TArray<int32> Samples;
+		int32 NextIndex = 0;
+	};
+
+	static FCriticalSection Mutex;
+	static TMap<FString, FLatencyWindow> Entries;
+	static float Budget;
+};
@@ -0,0 +1,108 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechLatencyMetrics.h"
+#include <atomic>
+
+/**
+ * HDR-style log-linear histogram: Values below SubBucketCount are exact and larger values keep 5 significant bits (~3% error), recording is lock-free
+ */
+class AZSPEECH_API FAzSpeechLatencyHistogram
+{
+public:
+	FAzSpeechLatencyHistogram();
+
+	void RecordValue(const int32 ValueMs);
+
+	/* Copy of the counters: Samples recorded while copying may be partially included */
+	struct FSnapshot
+	{
+		TArray<uint64> Buckets;
+		uint64 Count = 0u;
+		uint64 SumMs = 0u;
+		int32 MinMs = MAX_int32;
+		int32 MaxMs = 0;
+
+		void Merge(const FSnapshot& Other);
+
+		/* Highest value equivalent to the bucket containing the percentile, in the range [0, 1] */
+		const int32 GetValueAtPercentile(const float Percentile) const;
+
+		const FAzSpeechLatencyPercentiles ToPercentiles() const;
+	};
+
+	const FSnapshot GetSnapshot() const;
+
+	static constexpr int32 SubBucketBits = 6;
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+	static constexpr int32 SubBucketHalfCount = SubBucketCount / 2;
+
+	/* Values are clamped to ~70 minutes */
+	static constexpr int32 MaxValueMs = (1 << 22) - 1;
+	static constexpr int32 BucketCount = SubBucketCount + (22 - SubBucketBits) * SubBucketHalfCount;
+
+	static const int32 GetBucketIndex(const int32 ValueMs);
+	static const int32 GetBucketHighestValue(const int32 BucketIndex);
+
+private:
+	std::atomic<uint64> Buckets[BucketCount];
+	std::atomic<uint64> Count;
+	std::atomic<uint64> SumMs;
+	std::atomic<int32> MinMs;
+	std::atomic<int32> MaxMs;
+};
+
+/**
+ *
+ */
+class AZSPEECH_API FAzSpeechMetricsRegistry
+{
+public:
+	/* Voice name for synthesis metrics and language ID for recognition metrics; Endpoint ID is EmbeddedEndpointID when the task was answered by the embedded backend */
+	struct FKey
+	{
+		EAzSpeechLatencyMetric Metric = EAzSpeechLatencyMetric::Connection;
+		FName Voice;
+		FString EndpointID;
+
+		bool operator==(const FKey& Other) const
+		{
+			return Metric == Other.Metric && Voice == Other.Voice && EndpointID == Other.EndpointID;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(static_cast<uint8>(Key.Metric)), GetTypeHash(Key.Voice)), GetTypeHash(Key.EndpointID));
+		}
+	};
+
+	/* Samples recorded with an empty endpoint ID are stored with this ID */
+	static constexpr const TCHAR* EmbeddedEndpointID = TEXT("Embedded");
+
+	static void RecordSample(const EAzSpeechLatencyMetric Metric, const FName& Voice, const FString& EndpointID, const int32 ValueMs);
+
+	/* Merge the histograms matching the filters - Voice = None and empty Endpoint ID match all */
+	static const FAzSpeechLatencyHistogram::FSnapshot GetSnapshot(const EAzSpeechLatencyMetric Metric, const FName& Voice = NAME_None, const FString& EndpointID = FString());
+
+	static const FAzSpeechLatencyPercentiles GetPercentiles(const EAzSpeechLatencyMetric Metric, const FName& Voice = NAME_None, const FString& EndpointID = FString());
+
+	static const TArray<FKey> GetKeys();
+
+	/* Write the percentiles of every metric, voice and endpoint to the log and to a CSV file - Uses the logs directory if empty */
+	static void Dump(const FString& OutputDirectory = FString());
+
+	static void Reset();
+
+	static const FString GetMetricName(const EAzSpeechLatencyMetric Metric);
+
+private:
+	static const FAzSpeechLatencyHistogram::FSnapshot GetKeySnapshot(const FKey& Key);
+
+	/* Recording threads only take the read lock to find an existing histogram and keep a reference to it while recording */
+	static FRWLock Lock;
+	static TMap<FKey, TSharedPtr<FAzSpeechLatencyHistogram, ESPMode::ThreadSafe>> Entries;
+};
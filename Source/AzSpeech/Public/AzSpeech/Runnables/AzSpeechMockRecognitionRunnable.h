@@ -0,0 +1,25 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Runnables/Bases/AzSpeechMockRunnableBase.h"
+
+/**
+ *
+ */
+class FAzSpeechMockRecognitionRunnable : public FAzSpeechMockRunnableBase
+{
+public:
+	FAzSpeechMockRecognitionRunnable() = delete;
+	FAzSpeechMockRecognitionRunnable(UAzSpeechTaskBase* InOwningTask, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig);
+
+protected:
+	// FRunnable interface
+	virtual uint32 Run() override;
+	// End of FRunnable interface
+
+	class UAzSpeechRecognizerTaskBase* GetOwningRecognizerTask() const;
+};
@@ -0,0 +1,36 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Runnables/Bases/AzSpeechMockRunnableBase.h"
+
+/**
+ *
+ */
+class FAzSpeechMockSynthesisRunnable : public FAzSpeechMockRunnableBase
+{
+public:
+	FAzSpeechMockSynthesisRunnable() = delete;
+	FAzSpeechMockSynthesisRunnable(UAzSpeechTaskBase* InOwningTask, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig);
+
+protected:
+	// FRunnable interface
+	virtual uint32 Run() override;
+	// End of FRunnable interface
+
+	class UAzSpeechSynthesizerTaskBase* GetOwningSynthesizerTask() const;
+
+private:
+	/* Silent RIFF PCM audio in the synthesis output format of the task */
+	std::shared_ptr<std::vector<uint8_t>> GenerateAudioData() const;
+	const int32 GetSampleRate() const;
+
+	/* Send the visemes with audio offset lower than the input, returns the offset of the next viseme */
+	const int32 SendVisemes(const int32 InNextOffsetMs, const int32 InAudioOffsetMs);
+
+	/* Send a boundary for each word of the text, spread over the audio duration by character position */
+	void SendWordBoundaries();
+};
@@ -31,6 +31,8 @@ protected:
 
 private:
 	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognizer> SpeechRecognizer;
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognizer> FallbackRecognizer;
+	std::future<void> FallbackFuture;
 
 protected:
 	const bool IsSpeechRecognizerValid() const;
@@ -38,14 +40,23 @@ protected:
 	class UAzSpeechRecognizerTaskBase* GetOwningRecognizerTask() const;
 
 	virtual const bool ApplySDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig>& InConfig) const override;
+	virtual const bool ApplyEmbeddedSDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig>& InEmbeddedConfig) const override;
 
 	virtual bool InitializeAzureObject() override;
 
+	virtual const FString GetSpeechConfigKey() const override;
+
+	virtual bool StartFallbackAttempt() override;
+	virtual void StopAttempt(const EAzSpeechAttempt InAttempt) override;
+	virtual void OnAllAttemptsFailed() override;
+
 private:
-	bool ConnectRecognitionSignals();
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognizer> CreateSpeechRecognizer(const FAzSpeechBackendConfig& InBackendConfig, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig) const;
+
+	bool ConnectRecognitionSignals(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognizer>& InRecognizer, const EAzSpeechAttempt InAttempt);
 	bool InsertPhraseList() const;
 
-	bool ProcessRecognitionResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognitionResult>& LastResult);
+	bool ProcessRecognitionResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognitionResult>& LastResult, const EAzSpeechAttempt InAttempt);
 
 	const std::vector<std::string> GetCandidateLanguages() const;
 	const TArray<FString> GetPhraseListFromGroup(const FName& InGroup) const;
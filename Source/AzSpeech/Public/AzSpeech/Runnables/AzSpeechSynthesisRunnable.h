@@ -28,6 +28,8 @@ protected:
 
 private:
 	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer> SpeechSynthesizer;
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer> FallbackSynthesizer;
+	std::future<std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>> FallbackFuture;
 
 protected:
 	const bool IsSpeechSynthesizerValid() const;
@@ -35,16 +37,28 @@ protected:
 	class UAzSpeechSynthesizerTaskBase* GetOwningSynthesizerTask() const;
 
 	virtual const bool ApplySDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig>& InConfig) const override;
+	virtual const bool ApplyEmbeddedSDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig>& InEmbeddedConfig) const override;
 
 	virtual bool InitializeAzureObject() override;
 
+	virtual const FString GetSpeechConfigKey() const override;
+
+	virtual bool StartFallbackAttempt() override;
+	virtual void StopAttempt(const EAzSpeechAttempt InAttempt) override;
+	virtual void OnAllAttemptsFailed() override;
+
 private:
-	bool ConnectVisemeSignal();
-	bool ConnectSynthesisStartedSignal();
-	bool ConnectSynthesisUpdateSignals();
-	bool ProcessSynthesisResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>& LastResult);
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer> CreateSpeechSynthesizer(const FAzSpeechBackendConfig& InBackendConfig, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig) const;
+	std::future<std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>> StartSpeaking(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer) const;
+
+	bool ConnectVisemeSignal(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer, const EAzSpeechAttempt InAttempt);
+	bool ConnectBoundarySignals(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer, const EAzSpeechAttempt InAttempt);
+	bool ConnectSynthesisStartedSignal(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer);
+	bool ConnectSynthesisUpdateSignals(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesizer>& InSynthesizer, const EAzSpeechAttempt InAttempt);
+	bool ProcessSynthesisResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>& LastResult, const EAzSpeechAttempt InAttempt);
 
 	const Microsoft::CognitiveServices::Speech::SpeechSynthesisOutputFormat GetOutputFormat() const;
 
 	bool bFilterVisemeData = false;
-};
+	std::atomic<bool> bSynthesisStartedBroadcast { false };
+};
\ No newline at end of file
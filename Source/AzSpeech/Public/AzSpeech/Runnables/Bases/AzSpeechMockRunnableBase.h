@@ -0,0 +1,45 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Math/RandomStream.h>
+#include <atomic>
+#include "AzSpeech/Runnables/Bases/AzSpeechRunnableBase.h"
+#include "AzSpeech/Structures/AzSpeechMockBackendOptions.h"
+
+/**
+ * Base of the runnables used by the mock backend: Replays the Mock Backend settings without creating Azure SDK objects
+ */
+class FAzSpeechMockRunnableBase : public FAzSpeechRunnableBase
+{
+public:
+	FAzSpeechMockRunnableBase() = delete;
+	FAzSpeechMockRunnableBase(UAzSpeechTaskBase* InOwningTask, const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig);
+
+protected:
+	virtual bool InitializeAzureObject() override;
+
+	const FAzSpeechMockBackendOptions& GetMockOptions() const;
+
+	/* Sleep in slices of the thread update interval - Returns false if the task was stopped while waiting */
+	const bool WaitFor(const int32 InMilliseconds) const;
+
+	/* Latency with the random jitter of the mock options */
+	const int32 GetJitteredLatency(const int32 InLatencyMs);
+
+	/* Error the task must fail with - NoError if the task must succeed */
+	const Microsoft::CognitiveServices::Speech::CancellationErrorCode RollError();
+
+	const std::string GenerateResultID();
+
+	FRandomStream RandomStream;
+
+private:
+	FAzSpeechMockBackendOptions MockOptions;
+
+	/* Tasks started in the same order get the same random streams */
+	static std::atomic<int32> TaskSequence;
+};
@@ -0,0 +1,50 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+THIRD_PARTY_INCLUDES_START
+#include <speechapi_cxx_speech_synthesis_result.h>
+#include <speechapi_cxx_speech_recognition_result.h>
+THIRD_PARTY_INCLUDES_END
+
+/**
+ * Synthesis result sent by the runnables to the tasks - Decouples the tasks from the objects created by the Azure SDK
+ */
+struct AZSPEECH_API FAzSpeechSynthesisResultData
+{
+	Microsoft::CognitiveServices::Speech::ResultReason Reason = Microsoft::CognitiveServices::Speech::ResultReason::NoMatch;
+	std::string ResultID;
+
+	/* Shared with the SDK result to avoid copying the audio */
+	std::shared_ptr<std::vector<uint8_t>> AudioData;
+	int64 AudioDurationTicks = 0;
+
+	int32 ConnectionLatencyMs = 0;
+	int32 FinishLatencyMs = 0;
+	int32 FirstByteLatencyMs = 0;
+	int32 NetworkLatencyMs = 0;
+	int32 ServiceLatencyMs = 0;
+
+	static FAzSpeechSynthesisResultData FromResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>& InResult);
+};
+
+/**
+ * Recognition result sent by the runnables to the tasks - Decouples the tasks from the objects created by the Azure SDK
+ */
+struct AZSPEECH_API FAzSpeechRecognitionResultData
+{
+	Microsoft::CognitiveServices::Speech::ResultReason Reason = Microsoft::CognitiveServices::Speech::ResultReason::NoMatch;
+	std::string ResultID;
+
+	std::string Text;
+	uint64 DurationTicks = 0u;
+	uint64 OffsetTicks = 0u;
+
+	int32 RecognitionLatencyMs = 0;
+
+	static FAzSpeechRecognitionResultData FromResult(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognitionResult>& InResult);
+};
@@ -6,6 +6,8 @@
 
 #include <CoreMinimal.h>
 #include <HAL/Runnable.h>
+#include <atomic>
+#include "AzSpeech/Managers/AzSpeechConfigCache.h"
 
 THIRD_PARTY_INCLUDES_START
 #include <speechapi_cxx_embedded_speech_config.h>
@@ -31,6 +33,14 @@ public:
 	bool IsPendingStop() const;
 
 protected:
+	/* Primary: Uses the backend of the task options; Fallback: Uses the embedded backend when the cloud is slow to answer, or a second endpoint of the pool when hedging the request */
+	enum class EAzSpeechAttempt : uint8
+	{
+		None,
+		Primary,
+		Fallback
+	};
+
 	// FRunnable interface
 	virtual bool Init() override;
 	virtual uint32 Run() override;
@@ -47,17 +57,39 @@ protected:
 	virtual bool CanInitializeTask() const;
 
 	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig> CreateSpeechConfig() const;
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig> CreateSpeechConfig(const FAzSpeechEndpoint& InEndpoint) const;
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig> CreateEmbeddedSpeechConfig() const;
+	FAzSpeechBackendConfig CreateBackendConfig(bool& bOutIsConfigured) const;
+	FAzSpeechBackendConfig GetCachedBackendConfig() const;
+
+	/* Values used to configure the speech config, identifying it in the config cache - The only key of the cache: Options not listed here share the cached configs */
+	virtual const FString GetSpeechConfigKey() const;
+
+	/* Select the endpoint used by the cloud backend - From the endpoint pool if enabled */
+	bool SelectEndpoint();
+	const FAzSpeechEndpoint& GetEndpoint() const;
+
+	/* Endpoint used by the attempt - Null if the attempt doesn't use the cloud backend */
+	const FAzSpeechEndpoint* GetAttemptEndpoint(const EAzSpeechAttempt InAttempt) const;
+
+	/* Feed the health of the endpoint used by the attempt with the latency of a successful cloud result and record the latencies of the task */
+	void ReportEndpointSuccess(const EAzSpeechAttempt InAttempt, const int32 LatencyMs) const;
+
+	/* Release the half-open probe of the primary endpoint if the primary attempt is stopped before reporting its result */
+	void ReleaseEndpointProbe() const;
 
 	const std::chrono::seconds GetTaskTimeout() const;
 
 	virtual const bool ApplySDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig>& InSpeechConfig) const;
+	virtual const bool ApplyEmbeddedSDKSettings(const std::shared_ptr<Microsoft::CognitiveServices::Speech::EmbeddedSpeechConfig>& InEmbeddedConfig) const;
 
-	const bool EnableLogInConfiguration(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechConfig>& InSpeechConfig) const;
+	template<typename ConfigTy>
+	const bool EnableLogInConfiguration(const std::shared_ptr<ConfigTy>& InSpeechConfig) const;
 
 	const Microsoft::CognitiveServices::Speech::ProfanityOption GetProfanityFilter() const;
 
 	const FString CancellationReasonToString(const Microsoft::CognitiveServices::Speech::CancellationReason& CancellationReason) const;
-	void ProcessCancellationError(const Microsoft::CognitiveServices::Speech::CancellationErrorCode& ErrorCode, const std::string& ErrorDetails) const;
+	void ProcessCancellationError(const Microsoft::CognitiveServices::Speech::CancellationErrorCode& ErrorCode, const std::string& ErrorDetails, const EAzSpeechAttempt InAttempt = EAzSpeechAttempt::Primary) const;
 
 	const EThreadPriority GetCPUThreadPriority() const;
 	const float GetThreadUpdateInterval() const;
@@ -66,9 +98,53 @@ protected:
 
 	const FString GetThreadName() const;
 
+	/* Enable the latency fallback if the task options and the backend config allow it - Starts counting the latency budget */
+	void InitializeFallbackPolicy(const FAzSpeechBackendConfig& InBackendConfig);
+	const bool IsFallbackPolicyEnabled() const;
+	const FAzSpeechBackendConfig& GetFallbackConfig() const;
+
+	/* Enable request hedging if the task options allow it and there are enough latency samples of the selected endpoint - Uses the fallback attempt with a second endpoint of the pool */
+	void InitializeHedgingPolicy();
+	const bool IsHedgingEnabled() const;
+
+	/* Called by the run loop: Starts the fallback attempt after the latency budget and stops the attempt that lost */
+	void UpdateFallbackPolicy();
+
+	/* Called by the SDK events: Returns false if the event belongs to an attempt that already lost - bHasResult: False if the claim only reports a failure, the task is only flagged as using the fallback by results */
+	const bool ClaimAttempt(const EAzSpeechAttempt InAttempt, const bool bHasResult = true);
+
+	/* Called by the SDK events on failures: Returns true if the failure must be ignored because another attempt can still answer */
+	const bool DeferAttemptFailure(const EAzSpeechAttempt InAttempt);
+
+	virtual bool StartFallbackAttempt();
+	virtual void StopAttempt(const EAzSpeechAttempt InAttempt);
+	virtual void OnAllAttemptsFailed();
+
 private:
 	FName ThreadName;
 
+	FAzSpeechEndpoint Endpoint;
+
+	/* True while the primary attempt is the half-open probe of the endpoint and didn't report its result */
+	mutable std::atomic<bool> bIsProbingEndpoint { false };
+
+	FAzSpeechBackendConfig FallbackConfig;
+	EAzSpeechFallbackPolicy FallbackPolicy = EAzSpeechFallbackPolicy::Disabled;
+	double FallbackStartTime = 0.0;
+	int32 FallbackDelayMs = 0;
+	bool bFallbackStarted = false;
+	bool bLoserStopped = false;
+
+	std::atomic<EAzSpeechAttempt> WinnerAttempt { EAzSpeechAttempt::None };
+	std::atomic<uint8> FailedAttempts { 0u };
+	std::atomic<bool> bFallbackRequested { false };
+
+	bool bIsHedging = false;
+	FAzSpeechEndpoint HedgeEndpoint;
+
+	/* Consume the hedge budget and create the config of the second endpoint, only when the hedge is really sent */
+	bool PrepareHedgeAttempt();
+
 	void StoreThreadInformation();
 
 	bool bStopTask = false;
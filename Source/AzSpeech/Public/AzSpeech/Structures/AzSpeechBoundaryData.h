@@ -0,0 +1,77 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeechBoundaryData.generated.h"
+
+UENUM(BlueprintType, Category = "AzSpeech")
+enum class EAzSpeechBoundaryType : uint8
+{
+	Word,
+	Punctuation,
+	Sentence
+};
+
+/* Compact word boundary stored by the synthesizer tasks and the line files - The word text is a span of the synthesis text */
+struct FAzSpeechWordBoundary
+{
+	int64 AudioOffsetMilliseconds = 0;
+	int32 DurationMilliseconds = 0;
+	/* Span of the word in the synthesis text or SSML, in characters */
+	int32 TextOffset = 0;
+	int32 TextLength = 0;
+	/* Value of EAzSpeechBoundaryType - Stored as int32 to keep the layout free of padding */
+	int32 BoundaryType = 0;
+};
+
+USTRUCT(BlueprintType, Category = "AzSpeech")
+struct AZSPEECH_API FAzSpeechWordBoundaryData
+{
+	GENERATED_BODY()
+
+	FAzSpeechWordBoundaryData() = default;
+
+	FAzSpeechWordBoundaryData(const FAzSpeechWordBoundary& Boundary, const FString& SynthesisText) : AudioOffsetMilliseconds(Boundary.AudioOffsetMilliseconds), DurationMilliseconds(Boundary.DurationMilliseconds), TextOffset(Boundary.TextOffset), TextLength(Boundary.TextLength), BoundaryType(static_cast<EAzSpeechBoundaryType>(Boundary.BoundaryType)), Text(SynthesisText.Mid(Boundary.TextOffset, Boundary.TextLength))
+	{
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech")
+	int64 AudioOffsetMilliseconds = -1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech")
+	int32 DurationMilliseconds = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech")
+	int32 TextOffset = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech")
+	int32 TextLength = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech")
+	EAzSpeechBoundaryType BoundaryType = EAzSpeechBoundaryType::Word;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech")
+	FString Text = FString();
+};
+
+USTRUCT(BlueprintType, Category = "AzSpeech")
+struct AZSPEECH_API FAzSpeechBookmarkData
+{
+	GENERATED_BODY()
+
+	FAzSpeechBookmarkData() = default;
+
+	FAzSpeechBookmarkData(const int64 InAudioOffsetMilliseconds, const FString& InName) : AudioOffsetMilliseconds(InAudioOffsetMilliseconds), Name(InName)
+	{
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech")
+	int64 AudioOffsetMilliseconds = -1;
+
+	/* Mark specified in the SSML bookmark element */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech")
+	FString Name = FString();
+};
@@ -0,0 +1,41 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeechEndpoint.generated.h"
+
+USTRUCT(BlueprintType, Category = "AzSpeech")
+struct AZSPEECH_API FAzSpeechEndpoint
+{
+	GENERATED_BODY()
+
+	/* Key used to access this endpoint - Uses the Subscription Key of the task options if empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Subscription Key"))
+	FName SubscriptionKey = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Region ID", EditCondition = "!bUsePrivateEndpoint"))
+	FName RegionID = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Use Private Endpoint"))
+	bool bUsePrivateEndpoint = false;
+
+	/* Endpoint URL - Can also point to a local stand-in server, e.g. ws://localhost:8080 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Private Endpoint", EditCondition = "bUsePrivateEndpoint"))
+	FName PrivateEndpoint = NAME_None;
+
+	/* Check if the endpoint has a region or a private endpoint */
+	const bool IsValid() const;
+
+	/* Identifier used to track the health of this endpoint - Contains the location and a hash of the subscription key, never the key itself */
+	const FString GetEndpointID() const;
+
+	bool operator==(const FAzSpeechEndpoint& Rhs) const
+	{
+		return SubscriptionKey == Rhs.SubscriptionKey && RegionID == Rhs.RegionID && bUsePrivateEndpoint == Rhs.bUsePrivateEndpoint && PrivateEndpoint == Rhs.PrivateEndpoint;
+	}
+};
+
+AZSPEECH_API uint32 GetTypeHash(const FAzSpeechEndpoint& Endpoint);
@@ -0,0 +1,46 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeechEndpointHealth.generated.h"
+
+UENUM(BlueprintType, Category = "AzSpeech")
+enum class EAzSpeechCircuitState : uint8
+{
+	Closed,
+	Open,
+	HalfOpen
+};
+
+USTRUCT(BlueprintType, Category = "AzSpeech")
+struct AZSPEECH_API FAzSpeechEndpointHealth
+{
+	GENERATED_BODY()
+
+	/* Exponentially weighted moving average of the latency reported by the tasks */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	float LatencyMs = 0.f;
+
+	/* Exponentially weighted moving average of the failures, in the range [0, 1] */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	float ErrorRate = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int32 NumSuccesses = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int32 NumFailures = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	bool bIsHealthy = true;
+
+	/* Closed: Tasks can use the endpoint; Open: New tasks fail immediately after consecutive outage errors; HalfOpen: A single task is probing the endpoint */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	EAzSpeechCircuitState CircuitState = EAzSpeechCircuitState::Closed;
+
+	/* Platform time in seconds of the last failure */
+	double LastFailureTime = 0.0;
+};
@@ -0,0 +1,50 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeechLatencyMetrics.generated.h"
+
+UENUM(BlueprintType, Category = "AzSpeech")
+enum class EAzSpeechLatencyMetric : uint8
+{
+	Connection,
+	FirstByte,
+	Finish,
+	Network,
+	Service,
+	Recognition
+};
+
+USTRUCT(BlueprintType, Category = "AzSpeech")
+struct AZSPEECH_API FAzSpeechLatencyPercentiles
+{
+	GENERATED_BODY()
+
+	/* Number of samples recorded since the last reset */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int64 Count = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int32 MinMs = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int32 MaxMs = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	float MeanMs = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int32 P50Ms = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int32 P90Ms = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int32 P95Ms = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AzSpeech")
+	int32 P99Ms = 0;
+};
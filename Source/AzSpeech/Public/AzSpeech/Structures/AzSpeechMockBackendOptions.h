@@ -0,0 +1,75 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeechMockBackendOptions.generated.h"
+
+UENUM(BlueprintType, Category = "AzSpeech")
+enum class EAzSpeechMockError : uint8
+{
+	None,
+	ConnectionFailure,
+	ServiceUnavailable,
+	ServiceTimeout,
+	TooManyRequests,
+	AuthenticationFailure
+};
+
+USTRUCT(BlueprintType, Category = "AzSpeech")
+struct AZSPEECH_API FAzSpeechMockBackendOptions
+{
+	GENERATED_BODY()
+
+	FAzSpeechMockBackendOptions() = default;
+
+	/* Seed of the random streams used by the mock tasks - Tasks started in the same order will replay the same latencies and errors */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Random Seed"))
+	int32 RandomSeed = 0;
+
+	/* Time to wait before the task is started */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Connection Latency in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 ConnectionLatencyMs = 80;
+
+	/* Time to wait after the connection before the first audio chunk */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "First Byte Latency in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 FirstByteLatencyMs = 150;
+
+	/* Max random variation added to each latency */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Latency Jitter in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 LatencyJitterMs = 20;
+
+	/* Time between synthesis audio chunks and recognition partial results */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Chunk Interval in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 ChunkIntervalMs = 50;
+
+	/* Size of each synthesis audio chunk */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Chunk Size in Bytes", ClampMin = "1", UIMin = "1"))
+	int32 ChunkSizeBytes = 3200;
+
+	/* Duration of the silent audio generated by synthesis tasks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Audio Duration in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 AudioDurationMs = 2000;
+
+	/* Audio offset between viseme events - Zero to disable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Viseme Interval in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 VisemeIntervalMs = 60;
+
+	/* Text returned by recognition tasks, sent word by word as partial results */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Recognized Text"))
+	FString RecognizedText = TEXT("This is a mock recognition result");
+
+	/* Time to wait after the connection before the first recognition result */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Recognition Latency in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 RecognitionLatencyMs = 300;
+
+	/* Error returned by the failed tasks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Error Code"))
+	EAzSpeechMockError ErrorCode = EAzSpeechMockError::None;
+
+	/* Ratio of tasks that will fail with the error code */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Error Rate", ClampMin = "0", UIMin = "0", ClampMax = "1", UIMax = "1", EditCondition = "ErrorCode != EAzSpeechMockError::None"))
+	float ErrorRate = 0.f;
+};
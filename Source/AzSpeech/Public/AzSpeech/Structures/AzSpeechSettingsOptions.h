@@ -5,6 +5,7 @@
 #pragma once
 
 #include <CoreMinimal.h>
+#include "AzSpeech/Structures/AzSpeechEndpoint.h"
 #include "AzSpeechSettingsOptions.generated.h"
 
 UENUM(BlueprintType, Category = "AzSpeech")
@@ -42,6 +43,23 @@ enum class EAzSpeechRecognitionOutputFormat : uint8
 	Detailed
 };
 
+UENUM(BlueprintType, Category = "AzSpeech")
+enum class EAzSpeechBackend : uint8
+{
+	Cloud,
+	Embedded,
+	Hybrid,
+	Mock
+};
+
+UENUM(BlueprintType, Category = "AzSpeech")
+enum class EAzSpeechFallbackPolicy : uint8
+{
+	Disabled,
+	Race,
+	Switch
+};
+
 USTRUCT(BlueprintType, Category = "AzSpeech")
 struct AZSPEECH_API FAzSpeechSettingsOptions
 {
@@ -64,6 +82,46 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure", Meta = (DisplayName = "Private Endpoint", EditCondition = "bUsePrivateEndpoint"))
 	FName PrivateEndpoint;
 
+	/* If enabled, tasks will use the healthy endpoint of the pool with the lowest latency instead of the Region ID / Private Endpoint */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure", Meta = (DisplayName = "Use Endpoint Pool"))
+	bool bUseEndpointPool;
+
+	/* Regions and private endpoints used by the tasks, with automatic failover to the next healthy endpoint */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure", Meta = (DisplayName = "Endpoint Pool", EditCondition = "bUseEndpointPool"))
+	TArray<FAzSpeechEndpoint> EndpointPool;
+
+	/* Synthesis only - If enabled, a duplicate request is sent to another endpoint of the pool when the first audio takes longer than the p95 first byte latency of the selected endpoint */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Azure", Meta = (DisplayName = "Enable Request Hedging", EditCondition = "bUseEndpointPool"))
+	bool bEnableRequestHedging;
+
+	/* Cloud: Azure service; Embedded: Local models without network access; Hybrid: Azure service with the local models as fallback; Mock: In-process replay of the Mock Backend settings, without the Azure SDK */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Backend", Meta = (DisplayName = "Backend"))
+	EAzSpeechBackend Backend;
+
+	/* Folders containing the embedded models, absolute or relative to the project directory - Can be a root folder with the models in subfolders */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Backend", Meta = (DisplayName = "Embedded Model Paths", EditCondition = "Backend == EAzSpeechBackend::Embedded || Backend == EAzSpeechBackend::Hybrid || FallbackPolicy != EAzSpeechFallbackPolicy::Disabled"))
+	TArray<FString> EmbeddedModelPaths;
+
+	/* Name of the embedded speech recognition model used by recognizer tasks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Backend", Meta = (DisplayName = "Embedded Recognition Model", EditCondition = "Backend == EAzSpeechBackend::Embedded || Backend == EAzSpeechBackend::Hybrid || FallbackPolicy != EAzSpeechFallbackPolicy::Disabled"))
+	FName EmbeddedRecognitionModel;
+
+	/* Name of the embedded voice used by synthesizer tasks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Backend", Meta = (DisplayName = "Embedded Synthesis Voice", EditCondition = "Backend == EAzSpeechBackend::Embedded || Backend == EAzSpeechBackend::Hybrid || FallbackPolicy != EAzSpeechFallbackPolicy::Disabled"))
+	FName EmbeddedSynthesisVoice;
+
+	/* Decryption key of the embedded models */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Backend", Meta = (DisplayName = "Embedded Model Key", EditCondition = "Backend == EAzSpeechBackend::Embedded || Backend == EAzSpeechBackend::Hybrid || FallbackPolicy != EAzSpeechFallbackPolicy::Disabled"))
+	FName EmbeddedModelKey;
+
+	/* Cloud backend only - Disabled: No fallback; Race: Start the embedded backend if the cloud doesn't answer in time and use the first one to answer; Switch: Stop the cloud and use only the embedded backend if the cloud doesn't answer in time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Backend", Meta = (DisplayName = "Embedded Fallback Policy", EditCondition = "Backend == EAzSpeechBackend::Cloud"))
+	EAzSpeechFallbackPolicy FallbackPolicy;
+
+	/* Time to wait for the first cloud result before starting the embedded fallback */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Backend", Meta = (DisplayName = "Fallback Latency Budget (ms)", EditCondition = "Backend == EAzSpeechBackend::Cloud && FallbackPolicy != EAzSpeechFallbackPolicy::Disabled", ClampMin = "0", UIMin = "0"))
+	int32 FallbackLatencyBudgetMs;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tasks", Meta = (DisplayName = "Default Language ID"))
 	FName LanguageID;
 
@@ -81,6 +139,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tasks", Meta = (DisplayName = "Enable Viseme"))
 	bool bEnableViseme;
 
+	/* If enabled, synthesizers tasks will capture the audio offset and text span of each word */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tasks", Meta = (DisplayName = "Enable Word Boundary"))
+	bool bEnableWordBoundary;
+
 	/* Synthesis audio output format */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tasks", Meta = (DisplayName = "Synthesis Output Format"))
 	EAzSpeechSynthesisOutputFormat SpeechSynthesisOutputFormat;
@@ -89,6 +151,31 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tasks", Meta = (DisplayName = "Recognition Output Format"))
 	EAzSpeechRecognitionOutputFormat SpeechRecognitionOutputFormat;
 
+	const bool UsesCloudBackend() const;
+	const bool UsesEmbeddedBackend() const;
+	const bool UsesEmbeddedFallback() const;
+
+	/* Check if the tasks select an endpoint and report its health - The mock backend doesn't use endpoints */
+	const bool UsesEndpoints() const;
+
+	/* Check if synthesis requests can be hedged - The embedded fallback takes precedence */
+	const bool UsesRequestHedging() const;
+
+	/* Check if the tasks can only be answered by the cloud service - Without embedded backend or fallback */
+	const bool RequiresCloudBackend() const;
+
+	/* Endpoints the tasks can use: The endpoint pool if enabled or the default endpoint */
+	const TArray<FAzSpeechEndpoint> GetCandidateEndpoints() const;
+
+	/* Endpoint defined by the Region ID / Private Endpoint options */
+	const FAzSpeechEndpoint GetDefaultEndpoint() const;
+
+	/* Check if there's a valid endpoint with a subscription key to use */
+	const bool HasValidEndpoint() const;
+
+	/* Embedded model paths converted to absolute paths, without empty entries */
+	const TArray<FString> GetQualifiedEmbeddedModelPaths() const;
+
 private:
 	void SetDefaults();
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeechVoiceActivityOptions.generated.h"
+
+USTRUCT(BlueprintType, Category = "AzSpeech")
+struct AZSPEECH_API FAzSpeechVoiceActivityOptions
+{
+	GENERATED_BODY()
+
+	FAzSpeechVoiceActivityOptions() = default;
+
+	/* If enabled, Speech to Text tasks will only stream audio to the service while speech is detected locally - Requires the shared audio capture */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Enable Voice Activity Detection"))
+	bool bEnableVoiceActivityDetection = false;
+
+	/* Minimum frame energy in dBFS to consider the frame as speech */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Threshold in dBFS", ClampMin = "-90", UIMin = "-90", ClampMax = "0", UIMax = "0"))
+	float ThresholdDb = -45.f;
+
+	/* If enabled, the threshold will follow the estimated background noise level */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Use Adaptive Noise Floor"))
+	bool bUseAdaptiveNoiseFloor = true;
+
+	/* Margin in dB above the estimated noise floor to consider the frame as speech */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Noise Floor Margin in dB", ClampMin = "0", UIMin = "0", ClampMax = "40", UIMax = "40", EditCondition = "bUseAdaptiveNoiseFloor"))
+	float NoiseFloorMarginDb = 12.f;
+
+	/* Minimum duration of consecutive speech frames to start streaming */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Minimum Speech Duration in Miliseconds", ClampMin = "10", UIMin = "10", ClampMax = "1000", UIMax = "1000"))
+	int32 MinSpeechDurationMs = 60;
+
+	/* Time to keep streaming after the last speech frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Hangover in Miliseconds", ClampMin = "0", UIMin = "0", ClampMax = "5000", UIMax = "5000"))
+	int32 HangoverMs = 600;
+
+	/* Amount of audio before the speech start to send to the service */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Pre-Roll in Miliseconds", ClampMin = "0", UIMin = "0", ClampMax = "2000", UIMax = "2000"))
+	int32 PreRollMs = 300;
+
+	/* If enabled, silence will be sent to the service when the speech ends so the recognition is finalized without waiting for the service silence detection */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AzSpeech", Meta = (DisplayName = "Flush on Speech End"))
+	bool bFlushOnSpeechEnd = true;
+};
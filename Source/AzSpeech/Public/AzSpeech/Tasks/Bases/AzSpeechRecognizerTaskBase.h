@@ -6,12 +6,9 @@
 
 #include <CoreMinimal.h>
 #include "AzSpeech/Runnables/AzSpeechRecognitionRunnable.h"
+#include "AzSpeech/Runnables/Bases/AzSpeechResultData.h"
 #include "AzSpeech/Tasks/Bases/AzSpeechTaskBase.h"
 
-THIRD_PARTY_INCLUDES_START
-#include <speechapi_cxx_speech_recognition_result.h>
-THIRD_PARTY_INCLUDES_END
-
 #include "AzSpeechRecognizerTaskBase.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRecognitionUpdatedDelegate, const FString, UpdatedString);
@@ -26,6 +23,7 @@ class AZSPEECH_API UAzSpeechRecognizerTaskBase : public UAzSpeechTaskBase
 	GENERATED_BODY()
 
 	friend class FAzSpeechRecognitionRunnable;
+	friend class FAzSpeechMockRecognitionRunnable;
 	
 public:	
 	/* Task delegate that will be called when completed */
@@ -55,8 +53,13 @@ protected:
 	
 	void StartRecognitionWork(const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig);
 
+	/* Audio input of the embedded fallback recognizer - Called from the runnable thread, returns nullptr if the task doesn't support the fallback */
+	virtual std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> CreateFallbackAudioConfig();
+
 	virtual void BroadcastFinalResult() override;
-	virtual void OnRecognitionUpdated(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechRecognitionResult>& LastResult);
+	virtual void OnRecognitionUpdated(const FAzSpeechRecognitionResultData& LastResult);
+	virtual void OnCircuitOpen() override;
+	virtual void RecordLatencyMetrics(const FString& EndpointID) const override;
 
 private:
 	std::string RecognizedText;
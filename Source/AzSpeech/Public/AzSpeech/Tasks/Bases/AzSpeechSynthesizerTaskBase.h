@@ -8,10 +8,10 @@
 #include "AzSpeech/Tasks/Bases/AzSpeechTaskBase.h"
 #include "AzSpeech/Structures/AzSpeechVisemeData.h"
 #include "AzSpeech/Structures/AzSpeechAnimationData.h"
-
-THIRD_PARTY_INCLUDES_START
-#include <speechapi_cxx_speech_synthesis_result.h>
-THIRD_PARTY_INCLUDES_END
+#include "AzSpeech/Structures/AzSpeechBoundaryData.h"
+#include "AzSpeech/Runnables/Bases/AzSpeechResultData.h"
+#include "AzSpeech/Audio/AzSpeechAudioBuffer.h"
+#include "AzSpeech/Animation/AzSpeechBlendShapeMatrix.h"
 
 #include "AzSpeechSynthesizerTaskBase.generated.h"
 
@@ -31,6 +31,7 @@ class AZSPEECH_API UAzSpeechSynthesizerTaskBase : public UAzSpeechTaskBase
 	GENERATED_BODY()
 
 	friend class FAzSpeechSynthesisRunnable;
+	friend class FAzSpeechMockSynthesisRunnable;
 
 public:	
 	/* Task delegate that will be called when dpdated */
@@ -58,12 +59,51 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AzSpeech")
 	const TArray<uint8> GetAudioData() const;
 
+	/* Shared reference to the synthesized audio - Doesn't copy the data as GetAudioData does */
+	const FAzSpeechAudioBuffer GetAudioBuffer() const;
+
 	UFUNCTION(BlueprintPure, Category = "AzSpeech")
 	const FAzSpeechAnimationData GetLastExtractedAnimationData() const;
 
 	UFUNCTION(BlueprintPure, Category = "AzSpeech")
 	const TArray<FAzSpeechAnimationData> GetExtractedAnimationDataArray() const;
 
+	/* Number of blend shape frames received, at 60 frames per second */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const int32 GetBlendShapeFrameCount() const;
+
+	/* Number of blend shapes in each frame */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const int32 GetBlendShapeChannelCount() const;
+
+	/* Blend shapes interpolated at the time in seconds from the start of the audio - Empty if the frame was not received yet */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const TArray<float> GetBlendShapesAtTime(const float TimeInSeconds) const;
+
+	/* Same as GetBlendShapesAtTime, writing to an existing buffer with GetBlendShapeChannelCount() elements to avoid allocations */
+	const bool SampleBlendShapes(const float TimeInSeconds, const TArrayView<float> OutValues) const;
+
+	/* Append the visemes and blend shapes received since the last update of the timeline */
+	void UpdateVisemeTimeline(class FAzSpeechVisemeTimeline& Timeline) const;
+
+	/* Word, punctuation and sentence boundaries received, sorted by audio offset */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const TArray<FAzSpeechWordBoundaryData> GetWordBoundaries() const;
+
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const int32 GetWordBoundaryCount() const;
+
+	/* Last boundary of the type starting before the time in seconds from the start of the audio - Returns false if none was received yet */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const bool FindWordBoundaryAtTime(const float TimeInSeconds, const EAzSpeechBoundaryType BoundaryType, FAzSpeechWordBoundaryData& WordBoundary) const;
+
+	/* Copy the compact boundaries received from the index, without extracting the words - Returns the number of copied boundaries */
+	const int32 CopyWordBoundaries(TArray<FAzSpeechWordBoundary>& OutBoundaries, const int32 StartIndex = 0) const;
+
+	/* Bookmarks reached by the synthesis of the SSML, sorted by audio offset */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const TArray<FAzSpeechBookmarkData> GetBookmarks() const;
+
 	UFUNCTION(BlueprintPure, Category = "AzSpeech")
 	const bool IsLastResultValid() const;
 
@@ -94,13 +134,39 @@ protected:
 	void StartSynthesisWork(const std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig>& InAudioConfig);
 	
 	virtual void OnVisemeReceived(const FAzSpeechVisemeData& VisemeData);
-	virtual void OnSynthesisUpdate(const std::shared_ptr<Microsoft::CognitiveServices::Speech::SpeechSynthesisResult>& LastResult);
+	virtual void OnWordBoundaryReceived(const FAzSpeechWordBoundary& WordBoundary);
+	virtual void OnBookmarkReached(const FAzSpeechBookmarkData& BookmarkData);
+	virtual void OnSynthesisUpdate(const FAzSpeechSynthesisResultData& LastResult);
+	virtual void OnCircuitOpen() override;
+	virtual void RecordLatencyMetrics(const FString& EndpointID) const override;
+
+	virtual void BeginDestroy() override;
 	
 private:
-	std::vector<uint8_t> AudioData;
+	FAzSpeechAudioBuffer AudioData;
 	TArray<FAzSpeechVisemeData> VisemeDataArray;
+
+	/* Number of visemes received, read without the lock to skip the timeline updates when nothing is new */
+	std::atomic<int32> NumVisemesReceived { 0 };
+
+	/* Parsed in the SDK thread as the visemes are received: Each viseme with animation appends a segment to the matrix */
+	FAzSpeechBlendShapeMatrix BlendShapeMatrix;
+
+	/* Segment of each viseme in the matrix, INDEX_NONE if it has no animation */
+	TArray<int32> VisemeSegments;
+
+	/* Compact boundaries: The words are only extracted from the synthesis text when queried */
+	TArray<FAzSpeechWordBoundary> WordBoundaries;
+	TArray<FAzSpeechBookmarkData> Bookmarks;
 	bool bLastResultIsValid = false;
 
+	/* Update the memory stats with the current size of the audio and viseme data - Releases all the tracked memory if bRelease is true */
+	void UpdateMemoryStats(const bool bRelease = false);
+
+	int64 TrackedAudioBytes = 0;
+	int64 TrackedVisemeBytes = 0;
+	int64 VisemeAnimationBytes = 0;
+
 	int32 ConnectionLatency;
 	int32 FinishLatency;
 	int32 FirstByteLatency;
@@ -7,8 +7,11 @@
 #include <CoreMinimal.h>
 #include <Kismet/BlueprintAsyncActionBase.h>
 #include <Kismet/BlueprintFunctionLibrary.h>
+#include <atomic>
 #include "AzSpeech/AzSpeechSettings.h"
 #include "AzSpeechInternalFuncs.h"
+#include "AzSpeechEventLog.h"
+#include "AzSpeechMemory.h"
 #include "LogAzSpeech.h"
 
 THIRD_PARTY_INCLUDES_START
@@ -31,6 +34,8 @@ class AZSPEECH_API UAzSpeechTaskBase : public UBlueprintAsyncActionBase
 	friend class UAzSpeechTaskStatus;
 
 public:
+	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
 	virtual void Activate() override;
 
 	UFUNCTION(BlueprintCallable, Category = "AzSpeech", meta = (DisplayName = "Stop AzSpeech Task"))
@@ -45,8 +50,21 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AzSpeech")
 	const FAzSpeechSettingsOptions GetTaskOptions() const;
 
+	/* Check if the result came from the embedded backend because the cloud was too slow to answer */
+	UFUNCTION(BlueprintPure, Category = "AzSpeech")
+	const bool IsUsingFallbackBackend() const;
+
 	virtual void SetReadyToDestroy() override;
 
+	/* Record an event in the binary ring buffer of the task - Does nothing if the failure event log is disabled in the settings */
+	void RecordEvent(const EAzSpeechLogEvent Event, const int32 Value0 = 0, const int64 Value1 = 0) const;
+
+	/* Write the events recorded before a failure to the log */
+	void FlushEventLog(const FString& Reason) const;
+
+	/* ID of the last result received from the SDK - Used to correlate the trace events of the task with the service logs */
+	const std::string GetLastResultID() const;
+
 protected:
 	TSharedPtr<class FAzSpeechRunnableBase> RunnableTask;
 	FName TaskName = NAME_None;
@@ -58,8 +76,16 @@ protected:
 	virtual bool StartAzureTaskWork();
 	virtual void BroadcastFinalResult();
 
+	/* Called when the task fails without creating the Azure SDK objects because the circuit of all its endpoints is open */
+	virtual void OnCircuitOpen();
+
+	/* Add the latencies of the successful result to the metrics registry - Endpoint ID is empty if answered by the embedded backend */
+	virtual void RecordLatencyMetrics(const FString& EndpointID) const;
+
 	mutable FCriticalSection Mutex;
 
+	void SetLastResultID(const std::string& InResultID);
+
 #if WITH_EDITOR
 	virtual void PrePIEEnded(bool bIsSimulating);
 
@@ -68,9 +94,17 @@ protected:
 
 	static FAzSpeechSettingsOptions GetValidatedOptions(const FAzSpeechSettingsOptions& Options);
 
+	/* Check if the debugging info of an event must be mounted, querying the settings only once - Always false if the debugging logs are compiled out and prints are disabled */
+	static const bool IsDebuggingInfoEnabled(bool& bOutPrintToScreen);
+
 private:
+	TUniquePtr<FAzSpeechEventLog> EventLog;
+
 	bool bIsTaskActive = false;
 	bool bIsReadyToDestroy = false;
+	std::string LastResultID;
+	/* Set by the SDK callbacks when the fallback attempt wins: Atomic so claiming an attempt never waits for the task lock */
+	std::atomic<bool> bIsUsingFallbackBackend { false };
 
 	static FName GetValidatedLanguageID(const FName& Language);
 	static FName GetValidatedVoiceName(const FName& Voice);
@@ -30,4 +30,8 @@ protected:
 
 	FString FilePath;
 	FString FileName;
+
+private:
+	/* Check if the file must be written from the final result instead of the SDK audio output */
+	const bool WritesFileFromResult() const;
 };
@@ -0,0 +1,55 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include "AzSpeech/Tasks/SpeechToTextAsync.h"
+
+THIRD_PARTY_INCLUDES_START
+#include <speechapi_cxx_keyword_recognizer.h>
+THIRD_PARTY_INCLUDES_END
+
+#include "KeywordSpeechToTextAsync.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FKeywordRecognizedDelegate, const FString, Keyword);
+
+/**
+ *
+ */
+UCLASS(NotPlaceable, Category = "AzSpeech")
+class AZSPEECH_API UKeywordSpeechToTextAsync : public USpeechToTextAsync
+{
+	GENERATED_BODY()
+
+public:
+	/* Task delegate that will be called when the keyword is recognized locally, before the cloud recognition starts */
+	UPROPERTY(BlueprintAssignable, Category = "AzSpeech")
+	FKeywordRecognizedDelegate KeywordRecognized;
+
+	/* Creates a Keyword Speech-To-Text task that will wait for a keyword locally and then convert the following speech to string */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech | Default", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DisplayName = "Keyword Speech to Text with Default Options"))
+	static UKeywordSpeechToTextAsync* KeywordSpeechToText_DefaultOptions(UObject* WorldContextObject, const FString& KeywordModelPath, const FString& LanguageID = "Default", const FString& AudioInputDeviceID = "Default", const FName PhraseListGroup = NAME_None);
+
+	/* Creates a Keyword Speech-To-Text task that will wait for a keyword locally and then convert the following speech to string */
+	UFUNCTION(BlueprintCallable, Category = "AzSpeech | Custom", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DisplayName = "Keyword Speech to Text with Custom Options"))
+	static UKeywordSpeechToTextAsync* KeywordSpeechToText_CustomOptions(UObject* WorldContextObject, const FString& KeywordModelPath, const FAzSpeechSettingsOptions& Options, const FString& AudioInputDeviceID = "Default", const FName PhraseListGroup = NAME_None);
+
+	virtual void SetReadyToDestroy() override;
+
+protected:
+	virtual bool StartAudioInputWork() override;
+	virtual bool UseSharedAudioCapture() const override;
+
+	void OnKeywordRecognized(const std::shared_ptr<Microsoft::CognitiveServices::Speech::KeywordRecognitionResult>& KeywordResult);
+	void StopKeywordRecognition();
+
+private:
+	FString KeywordModelPath;
+
+	FAzSpeechAudioCaptureListenerPtr KeywordCaptureListener;
+	uint64 KeywordStartSample = 0u;
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::KeywordRecognizer> KeywordRecognizer;
+	std::future<std::shared_ptr<Microsoft::CognitiveServices::Speech::KeywordRecognitionResult>> KeywordRecognitionFuture;
+};
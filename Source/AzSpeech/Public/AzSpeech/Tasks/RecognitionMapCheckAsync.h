@@ -44,9 +44,10 @@ protected:
 	FString InputString;
 	bool bStopAtFirstTrigger;
 
+	const int32 CheckRecognitionResult() const;
+
 private:
 	void BroadcastResult(const int32 Result);
-	const int32 CheckRecognitionResult() const;
 	const bool CheckStringContains(const FString& KeyType, const FString& Key) const;
 	
 	const FName GetStringDelimiters() const;
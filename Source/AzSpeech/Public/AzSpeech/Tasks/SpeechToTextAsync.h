@@ -6,6 +6,7 @@
 
 #include <CoreMinimal.h>
 #include "AzSpeech/Tasks/Bases/AzSpeechRecognizerTaskBase.h"
+#include "AzSpeech/Audio/AzSpeechSharedAudioCapture.h"
 #include "SpeechToTextAsync.generated.h"
 
 /**
@@ -25,14 +26,42 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AzSpeech | Custom", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DisplayName = "Speech to Text with Custom Options"))
 	static USpeechToTextAsync* SpeechToText_CustomOptions(UObject* WorldContextObject, const FAzSpeechSettingsOptions& Options, const FString& AudioInputDeviceID = "Default", const FName PhraseListGroup = NAME_None);
 
+	/* Task delegate that will be called when the local voice activity detection finds the start of a speech */
+	UPROPERTY(BlueprintAssignable, Category = "AzSpeech")
+	FAzSpeechTaskGenericDelegate SpeechStarted;
+
+	/* Task delegate that will be called when the local voice activity detection finds the end of a speech */
+	UPROPERTY(BlueprintAssignable, Category = "AzSpeech")
+	FAzSpeechTaskGenericDelegate SpeechEnded;
+
 	virtual void Activate() override;
 	
 	UFUNCTION(BlueprintPure, Category = "AzSpeech")
 	bool IsUsingDefaultAudioInputDevice() const;
 
+	virtual void SetReadyToDestroy() override;
+
 protected:
 	virtual bool StartAzureTaskWork() override;
-	
-private:
+	virtual bool StartAudioInputWork();
+	virtual bool UseSharedAudioCapture() const;
+
+	/* PreRollSamples: Amount of already captured samples to send before the live data - Requires the shared audio capture */
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> CreateAudioConfig(const int32 PreRollSamples = 0);
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> CreateSharedCaptureAudioConfig(const int32 PreRollSamples = 0);
+
+	/* StartSample: Absolute captured sample to start the stream from, limited by the shared capture history */
+	std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> CreateSharedCaptureAudioConfigFromSample(const uint64 StartSample);
+
+	bool CreateSharedCaptureListener();
+	FAzSpeechAudioCaptureListenerPtr CreateVoiceActivityListener();
+	void ReleaseSharedCapture();
+
+	virtual std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> CreateFallbackAudioConfig() override;
+
 	FString AudioInputDeviceID;
+
+	TSharedPtr<FAzSpeechSharedAudioCapture, ESPMode::ThreadSafe> SharedAudioCapture;
+	FAzSpeechAudioCaptureListenerPtr AudioCaptureListener;
+	FAzSpeechAudioCaptureListenerPtr FallbackCaptureListener;
 };
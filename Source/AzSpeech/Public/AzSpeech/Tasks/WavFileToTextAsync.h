@@ -29,6 +29,7 @@ public:
 
 protected:
 	virtual bool StartAzureTaskWork() override;
+	virtual std::shared_ptr<Microsoft::CognitiveServices::Speech::Audio::AudioConfig> CreateFallbackAudioConfig() override;
 	
 private:
 	FString FilePath;
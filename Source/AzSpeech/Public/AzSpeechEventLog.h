@@ -0,0 +1,54 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <atomic>
+
+enum class EAzSpeechLogEvent : uint8
+{
+	Activate,
+	SDKStarted,
+	Partial,
+	AudioChunk,
+	Viseme,
+	WordBoundary,
+	Bookmark,
+	Canceled,
+	FinalResult,
+	Stop
+};
+
+/**
+ * Binary ring buffer of the last events of a task: Recording only copies a fixed size record, the events are decoded and logged when the task fails
+ */
+class AZSPEECH_API FAzSpeechEventLog
+{
+public:
+	/* Partial: Text length and offset in ticks; AudioChunk: Audio size and duration in ticks; Viseme: Viseme ID and audio offset in ms; WordBoundary: Text offset and audio offset in ms; Bookmark: Bookmark index and audio offset in ms; Canceled: Error code and attempt */
+	void Record(const EAzSpeechLogEvent Event, const int32 Value0 = 0, const int64 Value1 = 0);
+
+	/* Write the recorded events to the log, from the oldest to the newest - Only the first call writes them */
+	void Flush(const FString& TaskName, const uint32 TaskID, const FString& Reason);
+
+	static constexpr uint32 Capacity = 128u;
+
+private:
+	struct FRecord
+	{
+		uint64 Cycles = 0u;
+		int64 Value1 = 0;
+		int32 Value0 = 0;
+		uint32 ThreadID = 0u;
+		EAzSpeechLogEvent Event = EAzSpeechLogEvent::Activate;
+	};
+
+	static const TCHAR* GetEventName(const EAzSpeechLogEvent Event);
+
+	/* Records written while flushing may be torn: Acceptable for diagnostics, as flushing happens after the task failed */
+	FRecord Records[Capacity];
+	std::atomic<uint32> NextIndex { 0u };
+	std::atomic<bool> bFlushed { false };
+};
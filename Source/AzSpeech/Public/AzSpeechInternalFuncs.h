@@ -6,14 +6,66 @@
 
 #include <CoreMinimal.h>
 #include <Runtime/Launch/Resources/Version.h>
+#include <Async/Async.h>
+#include <atomic>
+#include <string>
 #include "LogAzSpeech.h"
+#include "AzSpeechTrace.h"
 
 struct FAzSpeechRecognitionMap;
 
+/* Opt-in accounting of the game thread callbacks used by the benchmark - Add AZSPEECH_WITH_CALLBACK_ACCOUNTING=1 to the GlobalDefinitions of the benchmark target to enable it */
+#ifndef AZSPEECH_WITH_CALLBACK_ACCOUNTING
+#define AZSPEECH_WITH_CALLBACK_ACCOUNTING 0
+#endif
+
 namespace AzSpeech
 {
 	namespace Internal
 	{
+#if AZSPEECH_WITH_CALLBACK_ACCOUNTING
+		/* Game thread time spent in the callbacks scheduled by AzSpeech, in cycles */
+		AZSPEECH_API void AddGameThreadCallbackCycles(const uint64 InCycles);
+		AZSPEECH_API const uint64 GetGameThreadCallbackCycles();
+#endif
+
+		/* Schedule the function in the game thread, accounting the time spent in it if enabled */
+		template<typename FunctionTy>
+		void AsyncGameThreadTask(FunctionTy&& Function)
+		{
+			AsyncTask(ENamedThreads::GameThread,
+				[Function = Forward<FunctionTy>(Function)]() mutable
+				{
+					AZSPEECH_TRACE_CPUPROFILER_SCOPE(AzSpeech_GameThreadCallback);
+
+#if AZSPEECH_WITH_CALLBACK_ACCOUNTING
+					const uint64 StartCycles = FPlatformTime::Cycles64();
+					Function();
+					AddGameThreadCallbackCycles(FPlatformTime::Cycles64() - StartCycles);
+#else
+					Function();
+#endif
+				}
+			);
+		}
+
+		/* Schedule the broadcast of the final result of a task, tracing it in the task timeline */
+		template<typename FunctionTy>
+		void AsyncGameThreadTask([[maybe_unused]] const uint32 InTaskID, [[maybe_unused]] const std::string& InResultID, FunctionTy&& Function)
+		{
+#if AZSPEECH_TRACE_ENABLED
+			AsyncGameThreadTask(
+				[InTaskID, ResultID = InResultID, Function = Forward<FunctionTy>(Function)]() mutable
+				{
+					AZSPEECH_TRACE_TASK_EVENT(Broadcast, InTaskID, ResultID.c_str());
+					Function();
+				}
+			);
+#else
+			AsyncGameThreadTask(Forward<FunctionTy>(Function));
+#endif
+		}
+
 		template<typename Ty>
 		constexpr const bool HasEmptyParam(const Ty& Arg1)
 		{
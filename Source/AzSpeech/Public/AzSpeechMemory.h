@@ -0,0 +1,36 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Runtime/Launch/Resources/Version.h>
+#include <Stats/Stats.h>
+#include <HAL/LowLevelMemTracker.h>
+
+/**
+ * AzSpeech memory: Use stat AzSpeech for the tracked sizes and -llm with the AzSpeech tags for the allocations made in the AzSpeech scopes
+ */
+
+DECLARE_STATS_GROUP(TEXT("AzSpeech"), STATGROUP_AzSpeech, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Task Objects"), STAT_AzSpeech_TaskObjects, STATGROUP_AzSpeech, AZSPEECH_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Audio Buffers"), STAT_AzSpeech_AudioMemory, STATGROUP_AzSpeech, AZSPEECH_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Viseme Data"), STAT_AzSpeech_VisemeMemory, STATGROUP_AzSpeech, AZSPEECH_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Latency Histograms"), STAT_AzSpeech_MetricsMemory, STATGROUP_AzSpeech, AZSPEECH_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cached Speech Configs"), STAT_AzSpeech_CachedConfigs, STATGROUP_AzSpeech, AZSPEECH_API);
+
+#if ENGINE_MAJOR_VERSION >= 5
+LLM_DECLARE_TAG_API(AzSpeech, AZSPEECH_API);
+LLM_DECLARE_TAG_API(AzSpeech_Tasks, AZSPEECH_API);
+LLM_DECLARE_TAG_API(AzSpeech_Audio, AZSPEECH_API);
+LLM_DECLARE_TAG_API(AzSpeech_Visemes, AZSPEECH_API);
+LLM_DECLARE_TAG_API(AzSpeech_Boundaries, AZSPEECH_API);
+LLM_DECLARE_TAG_API(AzSpeech_Caches, AZSPEECH_API);
+
+/* Allocations made through FMalloc in the scope are tracked by the AzSpeech/<Name> tag - The Azure SDK allocates with its own runtime and is not tracked */
+#define AZSPEECH_LLM_SCOPE(Name) LLM_SCOPE_BYTAG(AzSpeech_##Name)
+#else
+#define AZSPEECH_LLM_SCOPE(Name)
+#endif
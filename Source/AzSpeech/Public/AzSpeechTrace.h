@@ -0,0 +1,44 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Trace/Trace.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+
+/**
+ * AzSpeech trace channel: Enable with -trace=default,AzSpeech or Trace.Enable AzSpeech to see the task lifecycle in Unreal Insights
+ */
+
+#define AZSPEECH_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+enum class EAzSpeechTraceEvent : uint8
+{
+	Activate,
+	ConfigCreated,
+	SDKStarted,
+	FirstPartial,
+	FirstAudioByte,
+	Viseme,
+	FinalResult,
+	Broadcast,
+	Teardown
+};
+
+#if AZSPEECH_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(AzSpeechChannel, AZSPEECH_API);
+
+namespace AzSpeech::Internal
+{
+	/* Timeline event of a task: Also added as bookmark, except the visemes */
+	AZSPEECH_API void TraceTaskEvent(const EAzSpeechTraceEvent InEvent, const uint32 InTaskID, const ANSICHAR* InResultID = "");
+}
+
+#define AZSPEECH_TRACE_CPUPROFILER_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, AzSpeechChannel)
+#define AZSPEECH_TRACE_TASK_EVENT(Event, TaskID, ...) AzSpeech::Internal::TraceTaskEvent(EAzSpeechTraceEvent::Event, TaskID, ##__VA_ARGS__)
+#else
+#define AZSPEECH_TRACE_CPUPROFILER_SCOPE(Name)
+#define AZSPEECH_TRACE_TASK_EVENT(Event, TaskID, ...)
+#endif
@@ -10,6 +10,17 @@
  *
  */
 
+/* Set to 0 in the target rules to compile out the internal and debugging logs - The settings can only toggle them at runtime when compiled in */
+#ifndef AZSPEECH_INTERNAL_LOGS
+#define AZSPEECH_INTERNAL_LOGS !UE_BUILD_SHIPPING
+#endif
+
+#if AZSPEECH_INTERNAL_LOGS
+#define AZSPEECH_INTERNAL_LOGS_COMPILE_VERBOSITY All
+#else
+#define AZSPEECH_INTERNAL_LOGS_COMPILE_VERBOSITY NoLogging
+#endif
+
 DECLARE_LOG_CATEGORY_EXTERN(LogAzSpeech, Display, All);
-DECLARE_LOG_CATEGORY_EXTERN(LogAzSpeech_Internal, NoLogging, All);
-DECLARE_LOG_CATEGORY_EXTERN(LogAzSpeech_Debugging, NoLogging, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogAzSpeech_Internal, NoLogging, AZSPEECH_INTERNAL_LOGS_COMPILE_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogAzSpeech_Debugging, NoLogging, AZSPEECH_INTERNAL_LOGS_COMPILE_VERBOSITY);
@@ -28,7 +28,9 @@ public class AzSpeechEditor : ModuleRules
             "UnrealEd",
             "ToolMenus",
             "EditorStyle",
-            "WorkspaceMenuStructure"
+            "WorkspaceMenuStructure",
+            "AnimGraph",
+            "BlueprintGraph"
         });
     }
 }
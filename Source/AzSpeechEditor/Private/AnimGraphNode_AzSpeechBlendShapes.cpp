@@ -0,0 +1,28 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AnimGraphNode_AzSpeechBlendShapes.h"
+
+#ifdef UE_INLINE_GENERATED_CPP_BY_NAME
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AnimGraphNode_AzSpeechBlendShapes)
+#endif
+
+#define LOCTEXT_NAMESPACE "AnimGraphNode_AzSpeechBlendShapes"
+
+FText UAnimGraphNode_AzSpeechBlendShapes::GetNodeTitle([[maybe_unused]] ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("NodeTitle", "AzSpeech Blend Shapes");
+}
+
+FText UAnimGraphNode_AzSpeechBlendShapes::GetTooltipText() const
+{
+	return LOCTEXT("NodeTooltip", "Writes the blend shapes of an AzSpeech viseme timeline to animation curves, following the playback position of its audio component");
+}
+
+FString UAnimGraphNode_AzSpeechBlendShapes::GetNodeCategory() const
+{
+	return TEXT("AzSpeech");
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,27 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <AnimGraphNode_Base.h>
+#include "AzSpeech/Animation/AnimNode_AzSpeechBlendShapes.h"
+#include "AnimGraphNode_AzSpeechBlendShapes.generated.h"
+
+/**
+ * Anim graph node of FAnimNode_AzSpeechBlendShapes
+ */
+UCLASS(MinimalAPI, Category = "AzSpeech")
+class UAnimGraphNode_AzSpeechBlendShapes : public UAnimGraphNode_Base
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FAnimNode_AzSpeechBlendShapes Node;
+
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+	virtual FString GetNodeCategory() const override;
+};
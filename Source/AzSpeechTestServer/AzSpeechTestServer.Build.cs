@@ -0,0 +1,33 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+using System.IO;
+using UnrealBuildTool;
+
+public class AzSpeechTestServer : ModuleRules
+{
+	public AzSpeechTestServer(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+		CppStandard = CppStandardVersion.Cpp17;
+
+		PublicDependencyModuleNames.AddRange(new[]
+		{
+			"Core"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new[]
+		{
+			"CoreUObject",
+			"Engine",
+			"DeveloperSettings",
+			"Sockets",
+			"Networking",
+			"Json"
+		});
+
+		// Header only helpers shared with the runtime module, e.g. AzSpeech/Audio/AzSpeechWaveHeader.h
+		PrivateIncludePathModuleNames.Add("AzSpeech");
+	}
+}
@@ -0,0 +1,90 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeechTestServer.h"
+#include "AzSpeechTestServerListener.h"
+#include "AzSpeechTestServerSettings.h"
+#include "LogAzSpeechTestServer.h"
+#include <HAL/IConsoleManager.h>
+#include <Modules/ModuleManager.h>
+
+void FAzSpeechTestServerModule::StartupModule()
+{
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("AzSpeech.TestServer.Start"),
+		TEXT("Start the AzSpeech test server. Usage: AzSpeech.TestServer.Start [Port]"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FAzSpeechTestServerModule::OnStartCommand),
+		ECVF_Default
+	));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("AzSpeech.TestServer.Stop"),
+		TEXT("Stop the AzSpeech test server"),
+		FConsoleCommandDelegate::CreateRaw(this, &FAzSpeechTestServerModule::StopServer),
+		ECVF_Default
+	));
+
+	if (const UAzSpeechTestServerSettings* const Settings = UAzSpeechTestServerSettings::Get(); Settings && Settings->bAutoStart)
+	{
+		StartServer(Settings->Port);
+	}
+}
+
+void FAzSpeechTestServerModule::ShutdownModule()
+{
+	for (IConsoleObject* const Iterator : ConsoleCommands)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(Iterator);
+	}
+
+	ConsoleCommands.Empty();
+
+	StopServer();
+}
+
+FAzSpeechTestServerModule& FAzSpeechTestServerModule::Get()
+{
+	return FModuleManager::LoadModuleChecked<FAzSpeechTestServerModule>("AzSpeechTestServer");
+}
+
+bool FAzSpeechTestServerModule::StartServer(const int32 InPort)
+{
+	StopServer();
+
+	Listener = MakeUnique<FAzSpeechTestServerListener>(InPort);
+	if (!Listener->StartListener())
+	{
+		Listener.Reset();
+		return false;
+	}
+
+	UE_LOG(LogAzSpeechTestServer, Display, TEXT("%s: Use 'ws://127.0.0.1:%d/cognitiveservices/websocket/v1' (synthesis) or 'ws://127.0.0.1:%d/speech/recognition/conversation/cognitiveservices/v1' (recognition) as private endpoint"), *FString(__func__), InPort, InPort);
+
+	return true;
+}
+
+void FAzSpeechTestServerModule::StopServer()
+{
+	// Destroying the listener waits for the listener and connection threads to complete
+	Listener.Reset();
+}
+
+bool FAzSpeechTestServerModule::IsServerRunning() const
+{
+	return Listener.IsValid();
+}
+
+void FAzSpeechTestServerModule::OnStartCommand(const TArray<FString>& Args)
+{
+	const int32 Port = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : UAzSpeechTestServerSettings::Get()->Port;
+	if (Port <= 0 || Port > 65535)
+	{
+		UE_LOG(LogAzSpeechTestServer, Error, TEXT("%s: Invalid port %d"), *FString(__func__), Port);
+		return;
+	}
+
+	StartServer(Port);
+}
+
+IMPLEMENT_MODULE(FAzSpeechTestServerModule, AzSpeechTestServer)
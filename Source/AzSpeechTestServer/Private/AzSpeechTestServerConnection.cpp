@@ -0,0 +1,798 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeechTestServerConnection.h"
+#include "LogAzSpeechTestServer.h"
+#include "AzSpeech/Audio/AzSpeechWaveHeader.h"
+#include <HAL/RunnableThread.h>
+#include <Sockets.h>
+#include <SocketSubsystem.h>
+#include <Misc/Base64.h>
+#include <Misc/SecureHash.h>
+#include <Dom/JsonObject.h>
+#include <Serialization/JsonReader.h>
+#include <Serialization/JsonSerializer.h>
+
+namespace AzSpeech::TestServer
+{
+	constexpr uint8 OpcodeContinuation = 0x0;
+	constexpr uint8 OpcodeText = 0x1;
+	constexpr uint8 OpcodeBinary = 0x2;
+	constexpr uint8 OpcodeClose = 0x8;
+	constexpr uint8 OpcodePing = 0x9;
+	constexpr uint8 OpcodePong = 0xA;
+
+	constexpr int32 MaxHandshakeSize = 16 * 1024;
+	constexpr int32 MaxPayloadSize = 16 * 1024 * 1024;
+	constexpr int32 VisemeCount = 22;
+	constexpr int64 TicksPerMs = 10000;
+
+	const FString WebSocketGUID = TEXT("258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+
+	TArray<uint8> ToUTF8(const FString& InString)
+	{
+		const FTCHARToUTF8 Converter(*InString);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	}
+
+	FString FromUTF8(const uint8* InData, const int32 InSize)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(InData), InSize);
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	/* Speech protocol headers: "Name:Value" lines */
+	TMap<FString, FString> ParseHeaders(const FString& InHeaders)
+	{
+		TMap<FString, FString> Output;
+
+		TArray<FString> Lines;
+		InHeaders.ParseIntoArrayLines(Lines);
+
+		for (const FString& Line : Lines)
+		{
+			FString Key;
+			FString Value;
+			if (Line.Split(TEXT(":"), &Key, &Value))
+			{
+				Output.Add(Key.TrimStartAndEnd().ToLower(), Value.TrimStartAndEnd());
+			}
+		}
+
+		return Output;
+	}
+
+	/* Search a field in any level of the JSON object - The SDK nests the synthesis options differently between versions */
+	TSharedPtr<FJsonValue> FindJsonField(const TSharedPtr<FJsonObject>& InObject, const FString& InField)
+	{
+		if (!InObject.IsValid())
+		{
+			return nullptr;
+		}
+
+		if (const TSharedPtr<FJsonValue> Value = InObject->TryGetField(InField))
+		{
+			return Value;
+		}
+
+		for (const auto& Iterator : InObject->Values)
+		{
+			if (Iterator.Value.IsValid() && Iterator.Value->Type == EJson::Object)
+			{
+				if (const TSharedPtr<FJsonValue> Value = FindJsonField(Iterator.Value->AsObject(), InField))
+				{
+					return Value;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	int32 GetSampleRate(const FString& InOutputFormat)
+	{
+		TArray<FString> Tokens;
+		InOutputFormat.ToLower().ParseIntoArray(Tokens, TEXT("-"));
+
+		for (const FString& Token : Tokens)
+		{
+			if (Token.EndsWith(TEXT("khz")))
+			{
+				return FCString::Atoi(*Token) * 1000;
+			}
+
+			if (Token.EndsWith(TEXT("hz")))
+			{
+				return FCString::Atoi(*Token);
+			}
+		}
+
+		return 16000;
+	}
+
+	TArray<FString> GetSSMLWords(const FString& InSSML)
+	{
+		FString Text;
+		Text.Reserve(InSSML.Len());
+
+		bool bInsideTag = false;
+		for (const TCHAR& Character : InSSML)
+		{
+			if (Character == TEXT('<'))
+			{
+				bInsideTag = true;
+				Text.AppendChar(TEXT(' '));
+			}
+			else if (Character == TEXT('>'))
+			{
+				bInsideTag = false;
+			}
+			else if (!bInsideTag)
+			{
+				Text.AppendChar(Character);
+			}
+		}
+
+		TArray<FString> Output;
+		Text.ParseIntoArrayWS(Output);
+
+		return Output;
+	}
+}
+
+FAzSpeechTestServerConnection::FAzSpeechTestServerConnection(FSocket* InSocket, const int32 InSequence) : Socket(InSocket), Sequence(InSequence)
+{
+	const UAzSpeechTestServerSettings* const Settings = UAzSpeechTestServerSettings::Get();
+
+	Script.ConnectionLatencyMs = Settings->ConnectionLatencyMs;
+	Script.FirstByteLatencyMs = Settings->FirstByteLatencyMs;
+	Script.LatencyJitterMs = Settings->LatencyJitterMs;
+	Script.ChunkIntervalMs = Settings->ChunkIntervalMs;
+	Script.ChunkSizeBytes = FMath::Max(1, Settings->ChunkSizeBytes);
+	Script.BandwidthCapBytesPerSecond = Settings->BandwidthCapBytesPerSecond;
+	Script.AudioDurationPerWordMs = FMath::Max(1, Settings->AudioDurationPerWordMs);
+	Script.VisemeIntervalMs = FMath::Max(1, Settings->VisemeIntervalMs);
+	Script.RecognizedText = Settings->RecognizedText;
+	Script.Fault = Settings->Fault;
+	Script.FaultRate = Settings->FaultRate;
+
+	RandomStream.Initialize(static_cast<int32>(HashCombine(GetTypeHash(Settings->RandomSeed), GetTypeHash(Sequence))));
+}
+
+FAzSpeechTestServerConnection::~FAzSpeechTestServerConnection()
+{
+	StopConnection();
+
+	if (Thread.IsValid())
+	{
+		Thread->WaitForCompletion();
+		Thread.Reset();
+	}
+
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+}
+
+void FAzSpeechTestServerConnection::StartConnection()
+{
+	Thread.Reset(FRunnableThread::Create(this, *FString::Printf(TEXT("AzSpeechTestServer_Connection_%d"), Sequence)));
+}
+
+void FAzSpeechTestServerConnection::StopConnection()
+{
+	bStopConnection = true;
+}
+
+bool FAzSpeechTestServerConnection::IsFinished() const
+{
+	return bFinished;
+}
+
+uint32 FAzSpeechTestServerConnection::Run()
+{
+	if (!PerformHandshake())
+	{
+		return 0u;
+	}
+
+	while (!bStopConnection)
+	{
+		if (!FlushDueMessages())
+		{
+			break;
+		}
+
+		if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(5.0)))
+		{
+			continue;
+		}
+
+		uint8 Opcode = 0u;
+		TArray<uint8> Payload;
+		if (!ReadFrame(Opcode, Payload))
+		{
+			break;
+		}
+
+		if (Opcode == AzSpeech::TestServer::OpcodeClose)
+		{
+			SendFrame(AzSpeech::TestServer::OpcodeClose, Payload);
+			break;
+		}
+
+		if (Opcode == AzSpeech::TestServer::OpcodePing)
+		{
+			SendFrame(AzSpeech::TestServer::OpcodePong, Payload);
+			continue;
+		}
+
+		ProcessMessage(Opcode, Payload);
+	}
+
+	return 1u;
+}
+
+void FAzSpeechTestServerConnection::Exit()
+{
+	UE_LOG(LogAzSpeechTestServer, Display, TEXT("%s: Connection %d closed"), *FString(__func__), Sequence);
+
+	bFinished = true;
+}
+
+bool FAzSpeechTestServerConnection::PerformHandshake()
+{
+	TArray<uint8> Request;
+	while (!bStopConnection && Request.Num() < AzSpeech::TestServer::MaxHandshakeSize)
+	{
+		uint8 Byte = 0u;
+		if (!ReadExact(&Byte, 1))
+		{
+			return false;
+		}
+
+		Request.Add(Byte);
+
+		if (Request.Num() >= 4 && FMemory::Memcmp(Request.GetData() + Request.Num() - 4, "\r\n\r\n", 4) == 0)
+		{
+			break;
+		}
+	}
+
+	const FString RequestStr = AzSpeech::TestServer::FromUTF8(Request.GetData(), Request.Num());
+
+	FString RequestLine;
+	FString Headers;
+	RequestStr.Split(TEXT("\r\n"), &RequestLine, &Headers);
+
+	const FString Key = AzSpeech::TestServer::ParseHeaders(Headers).FindRef(TEXT("sec-websocket-key"));
+	if (Key.IsEmpty())
+	{
+		UE_LOG(LogAzSpeechTestServer, Warning, TEXT("%s: Connection %d isn't a websocket request: %s"), *FString(__func__), Sequence, *RequestLine);
+		return false;
+	}
+
+	UE_LOG(LogAzSpeechTestServer, Display, TEXT("%s: Connection %d requested: %s"), *FString(__func__), Sequence, *RequestLine);
+
+	if (!WaitFor(GetJitteredLatency(Script.ConnectionLatencyMs)))
+	{
+		return false;
+	}
+
+	// The SDK reports rejected handshakes as connection failures, using the HTTP status in the error details
+	FString Response;
+	if (RollFault(EAzSpeechTestServerFault::RejectConnection))
+	{
+		Response = TEXT("HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+	}
+	else if (RollFault(EAzSpeechTestServerFault::Throttle))
+	{
+		Response = TEXT("HTTP/1.1 429 Too Many Requests\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+	}
+
+	if (!Response.IsEmpty())
+	{
+		UE_LOG(LogAzSpeechTestServer, Display, TEXT("%s: Injecting fault in connection %d: %s"), *FString(__func__), Sequence, *Response.Left(Response.Find(TEXT("\r\n"))));
+
+		const TArray<uint8> ResponseData = AzSpeech::TestServer::ToUTF8(Response);
+		SendRaw(ResponseData.GetData(), ResponseData.Num());
+		return false;
+	}
+
+	const TArray<uint8> AcceptSource = AzSpeech::TestServer::ToUTF8(Key + AzSpeech::TestServer::WebSocketGUID);
+
+	uint8 AcceptHash[20];
+	FSHA1::HashBuffer(AcceptSource.GetData(), AcceptSource.Num(), AcceptHash);
+
+	Response = FString::Printf(TEXT("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n"), *FBase64::Encode(AcceptHash, 20));
+
+	const TArray<uint8> ResponseData = AzSpeech::TestServer::ToUTF8(Response);
+	return SendRaw(ResponseData.GetData(), ResponseData.Num());
+}
+
+bool FAzSpeechTestServerConnection::WaitFor(const int32 InMilliseconds) const
+{
+	const double EndTime = FPlatformTime::Seconds() + FMath::Max(0, InMilliseconds) / 1000.0;
+
+	while (!bStopConnection)
+	{
+		const double RemainingTime = EndTime - FPlatformTime::Seconds();
+		if (RemainingTime <= 0.0)
+		{
+			return true;
+		}
+
+		FPlatformProcess::Sleep(FMath::Min(0.005f, static_cast<float>(RemainingTime)));
+	}
+
+	return false;
+}
+
+bool FAzSpeechTestServerConnection::ReadExact(uint8* OutData, const int32 InSize)
+{
+	int32 TotalRead = 0;
+	while (TotalRead < InSize)
+	{
+		if (bStopConnection)
+		{
+			return false;
+		}
+
+		if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(100.0)))
+		{
+			continue;
+		}
+
+		int32 BytesRead = 0;
+		if (!Socket->Recv(OutData + TotalRead, InSize - TotalRead, BytesRead) || BytesRead <= 0)
+		{
+			return false;
+		}
+
+		TotalRead += BytesRead;
+	}
+
+	return true;
+}
+
+bool FAzSpeechTestServerConnection::ReadFrame(uint8& OutOpcode, TArray<uint8>& OutPayload)
+{
+	OutOpcode = AzSpeech::TestServer::OpcodeContinuation;
+	OutPayload.Reset();
+
+	while (true)
+	{
+		uint8 Header[2];
+		if (!ReadExact(Header, 2))
+		{
+			return false;
+		}
+
+		const bool bFinal = (Header[0] & 0x80) != 0;
+		const uint8 Opcode = Header[0] & 0x0F;
+		const bool bMasked = (Header[1] & 0x80) != 0;
+
+		uint64 PayloadSize = Header[1] & 0x7F;
+		if (PayloadSize == 126u || PayloadSize == 127u)
+		{
+			const int32 ExtendedSize = PayloadSize == 126u ? 2 : 8;
+
+			uint8 Extended[8];
+			if (!ReadExact(Extended, ExtendedSize))
+			{
+				return false;
+			}
+
+			PayloadSize = 0u;
+			for (int32 Index = 0; Index < ExtendedSize; ++Index)
+			{
+				PayloadSize = (PayloadSize << 8) | Extended[Index];
+			}
+		}
+
+		// Control frames can be sent between the fragments of a message and are never fragmented: They're read apart from the fragments
+		const bool bIsControlFrame = Opcode >= AzSpeech::TestServer::OpcodeClose;
+		TArray<uint8>& FramePayload = bIsControlFrame ? OutPayload : FragmentPayload;
+
+		if (PayloadSize + FramePayload.Num() > static_cast<uint64>(AzSpeech::TestServer::MaxPayloadSize))
+		{
+			UE_LOG(LogAzSpeechTestServer, Error, TEXT("%s: Connection %d sent a message bigger than %d bytes"), *FString(__func__), Sequence, AzSpeech::TestServer::MaxPayloadSize);
+			return false;
+		}
+
+		uint8 Mask[4] = { 0u, 0u, 0u, 0u };
+		if (bMasked && !ReadExact(Mask, 4))
+		{
+			return false;
+		}
+
+		const int32 Offset = FramePayload.Num();
+		FramePayload.AddUninitialized(static_cast<int32>(PayloadSize));
+		if (PayloadSize > 0u && !ReadExact(FramePayload.GetData() + Offset, static_cast<int32>(PayloadSize)))
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; bMasked && Index < static_cast<int32>(PayloadSize); ++Index)
+		{
+			FramePayload[Offset + Index] ^= Mask[Index % 4];
+		}
+
+		if (bIsControlFrame)
+		{
+			OutOpcode = Opcode;
+			return true;
+		}
+
+		if (Opcode != AzSpeech::TestServer::OpcodeContinuation)
+		{
+			FragmentOpcode = Opcode;
+		}
+
+		if (bFinal)
+		{
+			OutOpcode = FragmentOpcode;
+			OutPayload = MoveTemp(FragmentPayload);
+
+			FragmentOpcode = AzSpeech::TestServer::OpcodeContinuation;
+			FragmentPayload.Reset();
+
+			return true;
+		}
+	}
+}
+
+bool FAzSpeechTestServerConnection::SendFrame(const uint8 InOpcode, const TArray<uint8>& InPayload)
+{
+	TArray<uint8> Frame;
+	Frame.Reserve(InPayload.Num() + 10);
+	Frame.Add(0x80 | InOpcode);
+
+	const uint64 PayloadSize = static_cast<uint64>(InPayload.Num());
+	if (PayloadSize < 126u)
+	{
+		Frame.Add(static_cast<uint8>(PayloadSize));
+	}
+	else if (PayloadSize <= 0xFFFFu)
+	{
+		Frame.Add(126u);
+		Frame.Add(static_cast<uint8>((PayloadSize >> 8) & 0xFF));
+		Frame.Add(static_cast<uint8>(PayloadSize & 0xFF));
+	}
+	else
+	{
+		Frame.Add(127u);
+		for (int32 Index = 7; Index >= 0; --Index)
+		{
+			Frame.Add(static_cast<uint8>((PayloadSize >> (8 * Index)) & 0xFF));
+		}
+	}
+
+	Frame.Append(InPayload);
+
+	return SendRaw(Frame.GetData(), Frame.Num());
+}
+
+bool FAzSpeechTestServerConnection::SendRaw(const uint8* InData, const int32 InSize)
+{
+	// Without bandwidth cap, the whole buffer is sent at once
+	const int32 SliceSize = Script.BandwidthCapBytesPerSecond > 0 ? FMath::Max(1, Script.BandwidthCapBytesPerSecond / 50) : InSize;
+
+	int32 TotalSent = 0;
+	while (TotalSent < InSize)
+	{
+		if (bStopConnection)
+		{
+			return false;
+		}
+
+		if (Script.BandwidthCapBytesPerSecond > 0)
+		{
+			const double Now = FPlatformTime::Seconds();
+			if (NextSendTime > Now)
+			{
+				FPlatformProcess::Sleep(static_cast<float>(NextSendTime - Now));
+			}
+		}
+
+		int32 BytesSent = 0;
+		if (!Socket->Send(InData + TotalSent, FMath::Min(SliceSize, InSize - TotalSent), BytesSent) || BytesSent <= 0)
+		{
+			return false;
+		}
+
+		TotalSent += BytesSent;
+
+		if (Script.BandwidthCapBytesPerSecond > 0)
+		{
+			NextSendTime = FMath::Max(NextSendTime, FPlatformTime::Seconds()) + static_cast<double>(BytesSent) / Script.BandwidthCapBytesPerSecond;
+		}
+	}
+
+	return true;
+}
+
+void FAzSpeechTestServerConnection::ProcessMessage(const uint8 InOpcode, const TArray<uint8>& InPayload)
+{
+	// Text messages: headers, empty line and body; Binary messages: 2 bytes big endian header size, headers and body
+	FString Headers;
+	FString Body;
+	int32 BodyOffset = 0;
+
+	if (InOpcode == AzSpeech::TestServer::OpcodeText)
+	{
+		const FString Message = AzSpeech::TestServer::FromUTF8(InPayload.GetData(), InPayload.Num());
+		if (!Message.Split(TEXT("\r\n\r\n"), &Headers, &Body))
+		{
+			Headers = Message;
+		}
+	}
+	else if (InOpcode == AzSpeech::TestServer::OpcodeBinary && InPayload.Num() >= 2)
+	{
+		const int32 HeaderSize = FMath::Min((InPayload[0] << 8) | InPayload[1], InPayload.Num() - 2);
+		Headers = AzSpeech::TestServer::FromUTF8(InPayload.GetData() + 2, HeaderSize);
+		BodyOffset = 2 + HeaderSize;
+	}
+	else
+	{
+		return;
+	}
+
+	const TMap<FString, FString> HeaderMap = AzSpeech::TestServer::ParseHeaders(Headers);
+	const FString Path = HeaderMap.FindRef(TEXT("path")).ToLower();
+	const FString RequestID = HeaderMap.FindRef(TEXT("x-requestid"));
+
+	UE_LOG(LogAzSpeechTestServer, Verbose, TEXT("%s: Connection %d received %s (%d bytes)"), *FString(__func__), Sequence, *Path, InPayload.Num());
+
+	if (Path == TEXT("synthesis.context"))
+	{
+		ProcessSynthesisContext(Body);
+	}
+	else if (Path == TEXT("ssml"))
+	{
+		StartSynthesisTurn(RequestID, Body);
+	}
+	else if (Path == TEXT("audio") && RequestID != TurnRequestID && InPayload.Num() > BodyOffset)
+	{
+		// The first audio of a new request starts the recognition turn: the audio content is ignored
+		StartRecognitionTurn(RequestID);
+	}
+}
+
+void FAzSpeechTestServerConnection::ProcessSynthesisContext(const FString& InBody)
+{
+	TSharedPtr<FJsonObject> Context;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(InBody), Context) || !Context.IsValid())
+	{
+		return;
+	}
+
+	if (const TSharedPtr<FJsonValue> Value = AzSpeech::TestServer::FindJsonField(Context, TEXT("outputFormat")))
+	{
+		OutputFormat = Value->AsString();
+	}
+
+	if (const TSharedPtr<FJsonValue> Value = AzSpeech::TestServer::FindJsonField(Context, TEXT("visemeEnabled")))
+	{
+		bVisemeEnabled = Value->AsBool();
+	}
+
+	if (const TSharedPtr<FJsonValue> Value = AzSpeech::TestServer::FindJsonField(Context, TEXT("wordBoundaryEnabled")))
+	{
+		bWordBoundaryEnabled = Value->AsBool();
+	}
+}
+
+void FAzSpeechTestServerConnection::StartSynthesisTurn(const FString& InRequestID, const FString& InSSML)
+{
+	TurnRequestID = InRequestID;
+
+	const TArray<FString> Words = AzSpeech::TestServer::GetSSMLWords(InSSML);
+	const int32 DurationMs = FMath::Max(1, Words.Num()) * Script.AudioDurationPerWordMs;
+	const int32 SampleRate = AzSpeech::TestServer::GetSampleRate(OutputFormat);
+	const int32 DataSize = SampleRate * 2 * DurationMs / 1000;
+
+	// Riff formats are usually requested as raw audio by the SDK: the header is only sent if the riff format is requested
+	TArray<uint8> AudioData;
+	if (OutputFormat.StartsWith(TEXT("riff"), ESearchCase::IgnoreCase))
+	{
+		AzSpeech::Wave::AppendHeader(AudioData, SampleRate, DataSize);
+	}
+
+	const int32 HeaderSize = AudioData.Num();
+	AudioData.AddZeroed(DataSize);
+
+	const bool bCloseMidStream = RollFault(EAzSpeechTestServerFault::CloseMidStream);
+	const bool bStall = !bCloseMidStream && RollFault(EAzSpeechTestServerFault::Stall);
+	const int32 ChunkCount = FMath::DivideAndRoundUp(AudioData.Num(), Script.ChunkSizeBytes);
+	const int32 FaultChunk = bCloseMidStream || bStall ? ChunkCount / 2 : INDEX_NONE;
+
+	UE_LOG(LogAzSpeechTestServer, Display, TEXT("%s: Connection %d synthesizing %d words (%dms, %d chunks)%s"), *FString(__func__), Sequence, Words.Num(), DurationMs, ChunkCount, bCloseMidStream ? TEXT(" - Closing mid stream") : bStall ? TEXT(" - Stalling") : TEXT(""));
+
+	double DueTime = FPlatformTime::Seconds();
+	QueueText(DueTime, TEXT("turn.start"), FString::Printf(TEXT("{\"context\":{\"serviceTag\":\"%s\"}}"), *FGuid::NewGuid().ToString(EGuidFormats::Digits)));
+
+	DueTime += GetJitteredLatency(Script.FirstByteLatencyMs) / 1000.0;
+
+	const int32 BytesPerMs = FMath::Max(1, SampleRate * 2 / 1000);
+	int32 NextVisemeMs = 0;
+	int32 NextWord = 0;
+
+	for (int32 Chunk = 0; Chunk < ChunkCount; ++Chunk)
+	{
+		if (Chunk == FaultChunk)
+		{
+			if (bCloseMidStream)
+			{
+				QueueClose(DueTime, 1011u, TEXT("Internal server error"));
+			}
+
+			return;
+		}
+
+		if (Chunk > 0)
+		{
+			DueTime += GetJitteredLatency(Script.ChunkIntervalMs) / 1000.0;
+		}
+
+		const int32 ChunkOffset = Chunk * Script.ChunkSizeBytes;
+		const int32 ChunkSize = FMath::Min(Script.ChunkSizeBytes, AudioData.Num() - ChunkOffset);
+		const int32 ChunkEndMs = Chunk == ChunkCount - 1 ? DurationMs + 1 : FMath::Max(0, ChunkOffset + ChunkSize - HeaderSize) / BytesPerMs;
+
+		// The metadata of the audio is sent before the audio chunk, like the service does
+		for (; bWordBoundaryEnabled && NextWord < Words.Num() && NextWord * Script.AudioDurationPerWordMs < ChunkEndMs; ++NextWord)
+		{
+			const FString& Word = Words[NextWord];
+			QueueText(DueTime, TEXT("audio.metadata"), FString::Printf(TEXT("{\"Metadata\":[{\"Type\":\"WordBoundary\",\"Data\":{\"Offset\":%lld,\"Duration\":%lld,\"text\":{\"Text\":\"%s\",\"Length\":%d,\"BoundaryType\":\"WordBoundary\"}}}]}"), NextWord * Script.AudioDurationPerWordMs * AzSpeech::TestServer::TicksPerMs, Script.AudioDurationPerWordMs * AzSpeech::TestServer::TicksPerMs, *Word.ReplaceCharWithEscapedChar(), Word.Len()));
+		}
+
+		for (; bVisemeEnabled && NextVisemeMs < ChunkEndMs && NextVisemeMs <= DurationMs; NextVisemeMs += Script.VisemeIntervalMs)
+		{
+			QueueText(DueTime, TEXT("audio.metadata"), FString::Printf(TEXT("{\"Metadata\":[{\"Type\":\"Viseme\",\"Data\":{\"Offset\":%lld,\"VisemeId\":%d}}]}"), NextVisemeMs * AzSpeech::TestServer::TicksPerMs, RandomStream.RandHelper(AzSpeech::TestServer::VisemeCount)));
+		}
+
+		QueueAudio(DueTime, AudioData.GetData() + ChunkOffset, ChunkSize);
+	}
+
+	QueueText(DueTime, TEXT("turn.end"), TEXT("{}"));
+}
+
+void FAzSpeechTestServerConnection::StartRecognitionTurn(const FString& InRequestID)
+{
+	TurnRequestID = InRequestID;
+
+	TArray<FString> Words;
+	Script.RecognizedText.ParseIntoArrayWS(Words);
+
+	const bool bCloseMidStream = RollFault(EAzSpeechTestServerFault::CloseMidStream);
+	const bool bStall = !bCloseMidStream && RollFault(EAzSpeechTestServerFault::Stall);
+	const int32 FaultWord = bCloseMidStream || bStall ? Words.Num() / 2 : INDEX_NONE;
+
+	UE_LOG(LogAzSpeechTestServer, Display, TEXT("%s: Connection %d recognizing %d words%s"), *FString(__func__), Sequence, Words.Num(), bCloseMidStream ? TEXT(" - Closing mid stream") : bStall ? TEXT(" - Stalling") : TEXT(""));
+
+	double DueTime = FPlatformTime::Seconds();
+	QueueText(DueTime, TEXT("turn.start"), FString::Printf(TEXT("{\"context\":{\"serviceTag\":\"%s\"}}"), *FGuid::NewGuid().ToString(EGuidFormats::Digits)));
+	QueueText(DueTime, TEXT("speech.startDetected"), TEXT("{\"Offset\":0}"));
+
+	DueTime += GetJitteredLatency(Script.FirstByteLatencyMs) / 1000.0;
+
+	const int64 WordTicks = static_cast<int64>(FMath::Max(1, Script.ChunkIntervalMs)) * AzSpeech::TestServer::TicksPerMs;
+
+	FString PartialText;
+	for (int32 Index = 0; Index < Words.Num(); ++Index)
+	{
+		if (Index == FaultWord)
+		{
+			if (bCloseMidStream)
+			{
+				QueueClose(DueTime, 1011u, TEXT("Internal server error"));
+			}
+
+			return;
+		}
+
+		if (Index > 0)
+		{
+			DueTime += GetJitteredLatency(Script.ChunkIntervalMs) / 1000.0;
+		}
+
+		PartialText += Index > 0 ? TEXT(" ") + Words[Index] : Words[Index];
+		QueueText(DueTime, TEXT("speech.hypothesis"), FString::Printf(TEXT("{\"Text\":\"%s\",\"Offset\":0,\"Duration\":%lld}"), *PartialText.ReplaceCharWithEscapedChar(), (Index + 1) * WordTicks));
+	}
+
+	const FString FinalText = Script.RecognizedText.ReplaceCharWithEscapedChar();
+	const int64 DurationTicks = FMath::Max(1, Words.Num()) * WordTicks;
+
+	// Simple and detailed output formats read different fields of the phrase
+	QueueText(DueTime, TEXT("speech.phrase"), FString::Printf(TEXT("{\"RecognitionStatus\":\"Success\",\"DisplayText\":\"%s\",\"Offset\":0,\"Duration\":%lld,\"NBest\":[{\"Confidence\":0.95,\"Lexical\":\"%s\",\"ITN\":\"%s\",\"MaskedITN\":\"%s\",\"Display\":\"%s\"}]}"), *FinalText, DurationTicks, *FinalText, *FinalText, *FinalText, *FinalText));
+	QueueText(DueTime, TEXT("speech.endDetected"), FString::Printf(TEXT("{\"Offset\":%lld}"), DurationTicks));
+	QueueText(DueTime, TEXT("turn.end"), TEXT("{}"));
+}
+
+void FAzSpeechTestServerConnection::QueueText(const double InDueTime, const FString& InPath, const FString& InBody)
+{
+	const FString Message = FString::Printf(TEXT("X-RequestId:%s\r\nContent-Type:application/json; charset=utf-8\r\nPath:%s\r\n\r\n%s"), *TurnRequestID, *InPath, *InBody);
+
+	FOutgoingMessage& NewMessage = QueueMessage(InDueTime, AzSpeech::TestServer::OpcodeText);
+	NewMessage.Payload = AzSpeech::TestServer::ToUTF8(Message);
+}
+
+void FAzSpeechTestServerConnection::QueueAudio(const double InDueTime, const uint8* InData, const int32 InSize)
+{
+	const TArray<uint8> Headers = AzSpeech::TestServer::ToUTF8(FString::Printf(TEXT("X-RequestId:%s\r\nContent-Type:audio/x-wav\r\nPath:audio\r\n"), *TurnRequestID));
+
+	FOutgoingMessage& NewMessage = QueueMessage(InDueTime, AzSpeech::TestServer::OpcodeBinary);
+	NewMessage.Payload.Reserve(2 + Headers.Num() + InSize);
+	NewMessage.Payload.Add(static_cast<uint8>((Headers.Num() >> 8) & 0xFF));
+	NewMessage.Payload.Add(static_cast<uint8>(Headers.Num() & 0xFF));
+	NewMessage.Payload.Append(Headers);
+	NewMessage.Payload.Append(InData, InSize);
+}
+
+void FAzSpeechTestServerConnection::QueueClose(const double InDueTime, const uint16 InCode, const FString& InReason)
+{
+	FOutgoingMessage& NewMessage = QueueMessage(InDueTime, AzSpeech::TestServer::OpcodeClose);
+	NewMessage.Payload.Add(static_cast<uint8>((InCode >> 8) & 0xFF));
+	NewMessage.Payload.Add(static_cast<uint8>(InCode & 0xFF));
+	NewMessage.Payload.Append(AzSpeech::TestServer::ToUTF8(InReason));
+}
+
+FAzSpeechTestServerConnection::FOutgoingMessage& FAzSpeechTestServerConnection::QueueMessage(const double InDueTime, const uint8 InOpcode)
+{
+	// Keep the queue sorted by due time: Messages with the same due time keep the order they were queued
+	int32 InsertIndex = OutgoingMessages.Num();
+	while (InsertIndex > 0 && OutgoingMessages[InsertIndex - 1].DueTime > InDueTime)
+	{
+		--InsertIndex;
+	}
+
+	OutgoingMessages.Insert(FOutgoingMessage(), InsertIndex);
+
+	FOutgoingMessage& NewMessage = OutgoingMessages[InsertIndex];
+	NewMessage.DueTime = InDueTime;
+	NewMessage.Opcode = InOpcode;
+
+	return NewMessage;
+}
+
+bool FAzSpeechTestServerConnection::FlushDueMessages()
+{
+	// Messages are sorted by due time when queued
+	int32 SentCount = 0;
+	for (; SentCount < OutgoingMessages.Num() && OutgoingMessages[SentCount].DueTime <= FPlatformTime::Seconds(); ++SentCount)
+	{
+		const FOutgoingMessage& Message = OutgoingMessages[SentCount];
+		if (!SendFrame(Message.Opcode, Message.Payload) || Message.Opcode == AzSpeech::TestServer::OpcodeClose)
+		{
+			return false;
+		}
+	}
+
+	OutgoingMessages.RemoveAt(0, SentCount);
+
+	return true;
+}
+
+const int32 FAzSpeechTestServerConnection::GetJitteredLatency(const int32 InLatencyMs)
+{
+	if (Script.LatencyJitterMs <= 0)
+	{
+		return FMath::Max(0, InLatencyMs);
+	}
+
+	return FMath::Max(0, InLatencyMs + RandomStream.RandRange(-Script.LatencyJitterMs, Script.LatencyJitterMs));
+}
+
+const bool FAzSpeechTestServerConnection::RollFault(const EAzSpeechTestServerFault InFault)
+{
+	if (Script.Fault != InFault)
+	{
+		return false;
+	}
+
+	return RandomStream.GetFraction() < Script.FaultRate;
+}
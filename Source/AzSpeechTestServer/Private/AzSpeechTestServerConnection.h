@@ -0,0 +1,108 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <HAL/Runnable.h>
+#include <Math/RandomStream.h>
+#include <atomic>
+#include "AzSpeechTestServerSettings.h"
+
+class FSocket;
+class FRunnableThread;
+
+/**
+ * Websocket connection of a single SDK client: Answers the synthesis and recognition turns following the script of the test server settings
+ */
+class FAzSpeechTestServerConnection : public FRunnable
+{
+public:
+	FAzSpeechTestServerConnection() = delete;
+	FAzSpeechTestServerConnection(FSocket* InSocket, const int32 InSequence);
+	virtual ~FAzSpeechTestServerConnection() override;
+
+	void StartConnection();
+	void StopConnection();
+
+	bool IsFinished() const;
+
+protected:
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Exit() override;
+	// End of FRunnable interface
+
+private:
+	/* Copy of the settings used by the connection thread */
+	struct FScript
+	{
+		int32 ConnectionLatencyMs = 0;
+		int32 FirstByteLatencyMs = 0;
+		int32 LatencyJitterMs = 0;
+		int32 ChunkIntervalMs = 0;
+		int32 ChunkSizeBytes = 1;
+		int32 BandwidthCapBytesPerSecond = 0;
+		int32 AudioDurationPerWordMs = 1;
+		int32 VisemeIntervalMs = 1;
+		FString RecognizedText;
+		EAzSpeechTestServerFault Fault = EAzSpeechTestServerFault::None;
+		float FaultRate = 0.f;
+	};
+
+	struct FOutgoingMessage
+	{
+		double DueTime = 0.0;
+		uint8 Opcode = 0u;
+		TArray<uint8> Payload;
+	};
+
+	bool PerformHandshake();
+	bool WaitFor(const int32 InMilliseconds) const;
+
+	bool ReadExact(uint8* OutData, const int32 InSize);
+	bool ReadFrame(uint8& OutOpcode, TArray<uint8>& OutPayload);
+	bool SendFrame(const uint8 InOpcode, const TArray<uint8>& InPayload);
+	bool SendRaw(const uint8* InData, const int32 InSize);
+
+	void ProcessMessage(const uint8 InOpcode, const TArray<uint8>& InPayload);
+	void ProcessSynthesisContext(const FString& InBody);
+	void StartSynthesisTurn(const FString& InRequestID, const FString& InSSML);
+	void StartRecognitionTurn(const FString& InRequestID);
+
+	/* Insert a new message in the queue, sorted by due time */
+	FOutgoingMessage& QueueMessage(const double InDueTime, const uint8 InOpcode);
+
+	void QueueText(const double InDueTime, const FString& InPath, const FString& InBody);
+	void QueueAudio(const double InDueTime, const uint8* InData, const int32 InSize);
+	void QueueClose(const double InDueTime, const uint16 InCode, const FString& InReason);
+
+	/* Send the queued messages that are due - Returns false if the connection was closed */
+	bool FlushDueMessages();
+
+	const int32 GetJitteredLatency(const int32 InLatencyMs);
+	const bool RollFault(const EAzSpeechTestServerFault InFault);
+
+	FSocket* Socket;
+	TUniquePtr<FRunnableThread> Thread;
+	const int32 Sequence;
+
+	FScript Script;
+	FRandomStream RandomStream;
+
+	FString TurnRequestID;
+	FString OutputFormat;
+	bool bVisemeEnabled = false;
+	bool bWordBoundaryEnabled = false;
+
+	/* Data message being received: Kept apart from the control frames sent between its fragments */
+	TArray<uint8> FragmentPayload;
+	uint8 FragmentOpcode = 0u;
+
+	TArray<FOutgoingMessage> OutgoingMessages;
+	double NextSendTime = 0.0;
+
+	std::atomic<bool> bStopConnection { false };
+	std::atomic<bool> bFinished { false };
+};
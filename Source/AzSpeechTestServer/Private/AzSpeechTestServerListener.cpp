@@ -0,0 +1,117 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeechTestServerListener.h"
+#include "AzSpeechTestServerConnection.h"
+#include "LogAzSpeechTestServer.h"
+#include <HAL/RunnableThread.h>
+#include <Common/TcpSocketBuilder.h>
+#include <Interfaces/IPv4/IPv4Endpoint.h>
+#include <Sockets.h>
+#include <SocketSubsystem.h>
+
+FAzSpeechTestServerListener::FAzSpeechTestServerListener(const int32 InPort) : Port(InPort)
+{
+}
+
+FAzSpeechTestServerListener::~FAzSpeechTestServerListener()
+{
+	StopListener();
+
+	if (Thread.IsValid())
+	{
+		Thread->WaitForCompletion();
+		Thread.Reset();
+	}
+
+	if (ListenSocket)
+	{
+		ListenSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+	}
+}
+
+bool FAzSpeechTestServerListener::StartListener()
+{
+	// Only local clients: the test server must never be reachable from the network
+	ListenSocket = FTcpSocketBuilder(TEXT("AzSpeechTestServer_Listener"))
+		.AsNonBlocking()
+		.AsReusable()
+		.BoundToEndpoint(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port))
+		.Listening(16);
+
+	if (!ListenSocket)
+	{
+		UE_LOG(LogAzSpeechTestServer, Error, TEXT("%s: Failed to listen on port %d"), *FString(__func__), Port);
+		return false;
+	}
+
+	Thread.Reset(FRunnableThread::Create(this, *FString::Printf(TEXT("AzSpeechTestServer_Listener_%d"), Port)));
+
+	UE_LOG(LogAzSpeechTestServer, Display, TEXT("%s: Listening on ws://127.0.0.1:%d"), *FString(__func__), Port);
+
+	return Thread.IsValid();
+}
+
+void FAzSpeechTestServerListener::StopListener()
+{
+	bStopListener = true;
+}
+
+const int32 FAzSpeechTestServerListener::GetPort() const
+{
+	return Port;
+}
+
+uint32 FAzSpeechTestServerListener::Run()
+{
+	while (!bStopListener)
+	{
+		CleanupFinishedConnections();
+
+		bool bHasPendingConnection = false;
+		if (!ListenSocket->WaitForPendingConnection(bHasPendingConnection, FTimespan::FromMilliseconds(100.0)) || !bHasPendingConnection)
+		{
+			continue;
+		}
+
+		FSocket* const ClientSocket = ListenSocket->Accept(TEXT("AzSpeechTestServer_Client"));
+		if (!ClientSocket)
+		{
+			continue;
+		}
+
+		ClientSocket->SetNonBlocking(false);
+		ClientSocket->SetNoDelay(true);
+
+		TUniquePtr<FAzSpeechTestServerConnection>& NewConnection = Connections.Emplace_GetRef(MakeUnique<FAzSpeechTestServerConnection>(ClientSocket, ++ConnectionSequence));
+		NewConnection->StartConnection();
+	}
+
+	return 0u;
+}
+
+void FAzSpeechTestServerListener::Exit()
+{
+	for (const TUniquePtr<FAzSpeechTestServerConnection>& Iterator : Connections)
+	{
+		Iterator->StopConnection();
+	}
+
+	// Destroying the connections waits for the threads to complete
+	Connections.Empty();
+
+	UE_LOG(LogAzSpeechTestServer, Display, TEXT("%s: Stopped listening on port %d"), *FString(__func__), Port);
+}
+
+void FAzSpeechTestServerListener::CleanupFinishedConnections()
+{
+	Connections.RemoveAll(
+		[](const TUniquePtr<FAzSpeechTestServerConnection>& Iterator)
+		{
+			return Iterator->IsFinished();
+		}
+	);
+}
@@ -0,0 +1,47 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <HAL/Runnable.h>
+#include <atomic>
+
+class FSocket;
+class FRunnableThread;
+class FAzSpeechTestServerConnection;
+
+/**
+ * Accepts the local connections of the test server and starts a connection thread for each client
+ */
+class FAzSpeechTestServerListener : public FRunnable
+{
+public:
+	FAzSpeechTestServerListener() = delete;
+	explicit FAzSpeechTestServerListener(const int32 InPort);
+	virtual ~FAzSpeechTestServerListener() override;
+
+	bool StartListener();
+	void StopListener();
+
+	const int32 GetPort() const;
+
+protected:
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Exit() override;
+	// End of FRunnable interface
+
+private:
+	void CleanupFinishedConnections();
+
+	const int32 Port;
+	FSocket* ListenSocket = nullptr;
+	TUniquePtr<FRunnableThread> Thread;
+
+	TArray<TUniquePtr<FAzSpeechTestServerConnection>> Connections;
+	int32 ConnectionSequence = 0;
+
+	std::atomic<bool> bStopListener { false };
+};
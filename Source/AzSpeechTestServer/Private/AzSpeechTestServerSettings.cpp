@@ -0,0 +1,20 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#include "AzSpeechTestServerSettings.h"
+
+#ifdef UE_INLINE_GENERATED_CPP_BY_NAME
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AzSpeechTestServerSettings)
+#endif
+
+UAzSpeechTestServerSettings::UAzSpeechTestServerSettings(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer), bAutoStart(false), Port(5000), RandomSeed(0), ConnectionLatencyMs(40), FirstByteLatencyMs(150), LatencyJitterMs(20), ChunkIntervalMs(50), ChunkSizeBytes(3200), BandwidthCapBytesPerSecond(0), AudioDurationPerWordMs(350), VisemeIntervalMs(60), RecognizedText(TEXT("This is a test server recognition result")), Fault(EAzSpeechTestServerFault::None), FaultRate(0.f)
+{
+	CategoryName = TEXT("Plugins");
+}
+
+const UAzSpeechTestServerSettings* UAzSpeechTestServerSettings::Get()
+{
+	static const UAzSpeechTestServerSettings* const Instance = GetDefault<UAzSpeechTestServerSettings>();
+	return Instance;
+}
@@ -0,0 +1,13 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <Logging/LogMacros.h>
+
+/**
+ *
+ */
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAzSpeechTestServer, Display, All);
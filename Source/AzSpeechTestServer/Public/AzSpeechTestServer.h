@@ -0,0 +1,34 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Modules/ModuleInterface.h>
+
+class FAzSpeechTestServerListener;
+class IConsoleObject;
+
+/**
+ * Local stand-in of the Azure speech websocket service: Tasks using it as private endpoint run the real SDK code paths without cloud access
+ */
+class AZSPEECHTESTSERVER_API FAzSpeechTestServerModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	static FAzSpeechTestServerModule& Get();
+
+	bool StartServer(const int32 InPort);
+	void StopServer();
+
+	bool IsServerRunning() const;
+
+private:
+	void OnStartCommand(const TArray<FString>& Args);
+
+	TUniquePtr<FAzSpeechTestServerListener> Listener;
+	TArray<IConsoleObject*> ConsoleCommands;
+};
@@ -0,0 +1,94 @@
+// Author: Lucas Vilas-Boas
+// Year: 2023
+// Repo: https://github.com/lucoiso/UEAzSpeech
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Engine/DeveloperSettings.h>
+#include "AzSpeechTestServerSettings.generated.h"
+
+UENUM(BlueprintType, Category = "AzSpeech")
+enum class EAzSpeechTestServerFault : uint8
+{
+	/* Answer every turn */
+	None,
+	/* Reject the websocket handshake with HTTP 503 */
+	RejectConnection,
+	/* Reject the websocket handshake with HTTP 429 */
+	Throttle,
+	/* Close the websocket with an error frame in the middle of the turn */
+	CloseMidStream,
+	/* Stop sending messages in the middle of the turn, keeping the connection open */
+	Stall
+};
+
+/**
+ *
+ */
+UCLASS(Config = EditorPerProjectUserSettings, meta = (DisplayName = "AzSpeech Test Server"))
+class AZSPEECHTESTSERVER_API UAzSpeechTestServerSettings final : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	explicit UAzSpeechTestServerSettings(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	static const UAzSpeechTestServerSettings* Get();
+
+	/* If enabled, the server is started with the module - Otherwise use the AzSpeech.TestServer.Start console command */
+	UPROPERTY(Config, EditAnywhere, Category = "Server", Meta = (DisplayName = "Start Automatically"))
+	bool bAutoStart;
+
+	/* Local port: use ws://127.0.0.1:<Port> as the private endpoint of the tasks */
+	UPROPERTY(Config, EditAnywhere, Category = "Server", Meta = (DisplayName = "Port", ClampMin = "1", UIMin = "1", ClampMax = "65535", UIMax = "65535"))
+	int32 Port;
+
+	/* Seed of the random streams - Connections accepted in the same order replay the same latencies and faults */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Random Seed"))
+	int32 RandomSeed;
+
+	/* Time to wait before answering the websocket handshake */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Connection Latency in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 ConnectionLatencyMs;
+
+	/* Time between the synthesis request and the first audio chunk, or between the first audio received and the first recognition result */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "First Byte Latency in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 FirstByteLatencyMs;
+
+	/* Max random variation added to each latency */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Latency Jitter in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 LatencyJitterMs;
+
+	/* Time between synthesis audio chunks and recognition partial results */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Chunk Interval in Miliseconds", ClampMin = "0", UIMin = "0"))
+	int32 ChunkIntervalMs;
+
+	/* Size of each synthesis audio chunk */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Chunk Size in Bytes", ClampMin = "1", UIMin = "1"))
+	int32 ChunkSizeBytes;
+
+	/* Max bytes per second sent to each connection - Zero for no limit */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Bandwidth Cap in Bytes per Second", ClampMin = "0", UIMin = "0"))
+	int32 BandwidthCapBytesPerSecond;
+
+	/* Duration of the synthesized audio for each word of the request */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Audio Duration per Word in Miliseconds", ClampMin = "1", UIMin = "1"))
+	int32 AudioDurationPerWordMs;
+
+	/* Audio offset between viseme events - Only sent if requested by the synthesizer */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Viseme Interval in Miliseconds", ClampMin = "1", UIMin = "1"))
+	int32 VisemeIntervalMs;
+
+	/* Text returned by recognition turns, sent word by word as hypotheses */
+	UPROPERTY(Config, EditAnywhere, Category = "Script", Meta = (DisplayName = "Recognized Text"))
+	FString RecognizedText;
+
+	/* Fault injected in the turns */
+	UPROPERTY(Config, EditAnywhere, Category = "Faults", Meta = (DisplayName = "Fault"))
+	EAzSpeechTestServerFault Fault;
+
+	/* Ratio of the turns with the fault injected */
+	UPROPERTY(Config, EditAnywhere, Category = "Faults", Meta = (DisplayName = "Fault Rate", ClampMin = "0", UIMin = "0", ClampMax = "1", UIMax = "1", EditCondition = "Fault != EAzSpeechTestServerFault::None"))
+	float FaultRate;
+};